@@ -143,7 +143,7 @@ template<typename K, typename V, typename KPolicy, typename VPolicy> struct SerU
                     V v;
                     m_k_policy(ar, k);
                     m_v_policy(ar, v);
-                    m_map.insert_or_assign(std::move(k), std::move(v));
+                    m_map.add(std::move(k), std::move(v));
                 }
             }
         }
@@ -154,8 +154,8 @@ template<typename K, typename V, typename KPolicy, typename VPolicy> struct SerU
             for (auto& item : m_map)
             {
                 RAII item_raii((ArchiveStructure(ar)));
-                m_k_policy(ar, item.first);
-                m_v_policy(ar, item.second);
+                m_k_policy(ar, item.key);
+                m_v_policy(ar, item.value);
             }
         }
     }
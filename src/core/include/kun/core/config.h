@@ -51,6 +51,20 @@
     #define KUN_INLINE inline
 #endif
 
+// no unique address, empty member (e.g. stateless allocator) take no storage like empty base
+#if KUN_COMPILER == KUN_COMPILER_MSVC
+    #define KUN_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+    #define KUN_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+// simd
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define KUN_SIMD_SSE2 1
+#else
+    #define KUN_SIMD_SSE2 0
+#endif
+
 // dllexport
 #if KUN_COMPILER == KUN_COMPILER_GCC || KUN_COMPILER == KUN_COMPILER_CLANG
     #define KUN_DLLEXPORT __attribute__((dllexport))
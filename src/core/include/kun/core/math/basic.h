@@ -87,7 +87,7 @@ KUN_INLINE u64 bitTailZero(u64 v)
 #if KUN_COMPILER == KUN_COMPILER_MSVC
         unsigned long bit_index;
         _BitScanForward64(&bit_index, v);
-        return v;
+        return bit_index;
 #elif KUN_COMPILER == KUN_COMPILER_GCC
         int bit_index;
         bit_index = __builtin_ctzll(v);
@@ -125,7 +125,7 @@ KUN_INLINE u32 bitLeadingZero(u32 v)
         return 31 - bit_index;
 #elif KUN_COMPILER == KUN_COMPILER_GCC
         int bit_index;
-        bit_index = (u32)__builtin_clzl(v);
+        bit_index = (u32)__builtin_clz(v);
         return bit_index;
 #else
         // clang-format off
@@ -231,5 +231,5 @@ KUN_INLINE u64 ceilLog2(u64 v)
 
 // ceil to power of 2
 KUN_INLINE u32 ceilPowerOf2(u32 v) { return 1 << ceilLog2(v); }
-KUN_INLINE u64 ceilPowerOf2(u64 v) { return 1 << ceilLog2(v); }
+KUN_INLINE u64 ceilPowerOf2(u64 v) { return (u64)1 << ceilLog2(v); }
 }// namespace kun
\ No newline at end of file
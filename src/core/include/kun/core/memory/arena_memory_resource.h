@@ -0,0 +1,96 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/core_api.h"
+#include "kun/core/std/types.hpp"
+#include "memory_resource.h"
+
+// arena memory resource
+// bump pointer allocation in chained chunks, free() is a no-op, memory is reclaimed at once by rewind() or reset()
+// chunks are kept for reuse after rewind/reset until release(), so steady per-tick usage never touch upstream
+// each block carry a size header for realloc, and the last block is resized in place
+// NOTE: not thread safe, use one arena per thread
+namespace kun
+{
+class KUN_CORE_API ArenaMemoryResource final : public IMemoryResource
+{
+    struct Chunk
+    {
+        Chunk* next;
+        Size   capacity;
+    };
+
+public:
+    static constexpr Size default_chunk_size = 64 * 1024;
+
+    // position of arena, rewind to it release every block allocated after mark
+    struct Marker
+    {
+        Chunk* chunk;
+        u8*    cursor;
+    };
+
+    // ctor & dtor
+    ArenaMemoryResource(Size chunk_size = default_chunk_size, IMemoryResource* upstream = defaultMemoryResource());
+    ~ArenaMemoryResource() override;
+
+    // no copy & move, containers hold pointer to the resource
+    ArenaMemoryResource(const ArenaMemoryResource&) = delete;
+    ArenaMemoryResource(ArenaMemoryResource&&) = delete;
+    ArenaMemoryResource& operator=(const ArenaMemoryResource&) = delete;
+    ArenaMemoryResource& operator=(ArenaMemoryResource&&) = delete;
+
+    // getter
+    Size             chunkSize() const;
+    Size             chunkCount() const;
+    Size             reservedSize() const;
+    Size             usedSize() const;
+    IMemoryResource* upstream() const;
+
+    // impl IMemoryResource
+    void* alloc(Size size, Size alignment) override;
+    void* realloc(void* p, Size size, Size alignment) override;
+    void  free(void* p) override;
+    bool  tryExpand(void* p, Size size) override;
+
+    // scope
+    Marker mark() const;
+    void   rewind(const Marker& marker);
+    void   reset();
+    void   release();
+
+private:
+    // helper
+    void* _allocSlow(Size size, Size alignment);
+    u8*   _chunkBegin(Chunk* chunk) const;
+
+private:
+    Chunk*           m_head;
+    Chunk*           m_current;
+    u8*              m_cursor;
+    u8*              m_end;
+    u8*              m_last;
+    Size             m_chunk_size;
+    Size             m_chunk_count;
+    Size             m_reserved_size;
+    IMemoryResource* m_upstream;
+};
+
+// rewind arena when leave scope
+class ArenaScope
+{
+public:
+    KUN_INLINE ArenaScope(ArenaMemoryResource& arena)
+        : m_arena(arena)
+        , m_marker(arena.mark())
+    {
+    }
+    KUN_INLINE ~ArenaScope() { m_arena.rewind(m_marker); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    ArenaMemoryResource&        m_arena;
+    ArenaMemoryResource::Marker m_marker;
+};
+}// namespace kun
@@ -26,7 +26,7 @@ template<typename T> struct memory_policy_traits<T, T>
     static constexpr bool call_assign = !std::is_trivially_assignable_v<std::add_lvalue_reference_t<T>, std::add_lvalue_reference_t<T>>;
     static constexpr bool call_move_assign = !std::is_trivially_move_assignable_v<T>;
     static constexpr bool call_compare = !std::is_trivial_v<T>;
-    static constexpr bool use_realloc = std::is_trivial_v<T> && std::is_trivially_destructible_v<T>;
+    static constexpr bool use_realloc = is_trivially_relocatable_v<T>;
 };
 template<typename T> struct memory_policy_traits<T*, T*>
 {
@@ -156,9 +156,9 @@ template<typename Dst, typename Src> KUN_INLINE void moveItems(Dst* dst, Src* sr
 
             while (count)
             {
-                new (dst_end) Dst(std::move(*src_end));
                 --dst_end;
                 --src_end;
+                new (dst_end) Dst(std::move(*src_end));
                 --count;
             }
         }
@@ -189,9 +189,9 @@ template<typename Dst, typename Src> KUN_INLINE void moveAssignItems(Dst* dst, S
 
             while (count)
             {
-                *dst_end = std::move(*src_end);
                 --dst_end;
                 --src_end;
+                *dst_end = std::move(*src_end);
                 --count;
             }
         }
@@ -202,6 +202,43 @@ template<typename Dst, typename Src> KUN_INLINE void moveAssignItems(Dst* dst, S
     }
 }
 
+// relocate, move items to dst and destruct items at src, dst and src can overlap
+template<typename T> KUN_INLINE void relocateItems(T* dst, T* src, Size count)
+{
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        memory::memmove(dst, src, sizeof(T) * count);
+    }
+    else
+    {
+        if (dst < src)
+        {
+            while (count)
+            {
+                new (dst) T(std::move(*src));
+                src->~T();
+                ++dst;
+                ++src;
+                --count;
+            }
+        }
+        else if (dst > src)
+        {
+            auto dst_end = dst + count;
+            auto src_end = src + count;
+
+            while (count)
+            {
+                --dst_end;
+                --src_end;
+                new (dst_end) T(std::move(*src_end));
+                src_end->~T();
+                --count;
+            }
+        }
+    }
+}
+
 // compare
 template<typename A, typename B> KUN_INLINE bool compareItems(const A* a, const B* b, Size count)
 {
@@ -209,7 +246,7 @@ template<typename A, typename B> KUN_INLINE bool compareItems(const A* a, const
     {
         while (count)
         {
-            if (!(*a == *a))
+            if (!(*a == *b))
             {
                 return false;
             }
@@ -3,6 +3,9 @@
 #include "kun/core/core_api.h"
 #include "kun/core/std/types.hpp"
 #include "kun/core/std/kstl/basic.hpp"
+#if KUN_COMPILER == KUN_COMPILER_MSVC && KUN_SIMD_SSE2
+    #include <xmmintrin.h>
+#endif
 
 // malloc
 namespace kun::memory
@@ -19,6 +22,12 @@ KUN_CORE_API void* malloc(Size n, Size alignment = DEFAULT_ALIGNMENT);
 KUN_CORE_API void* realloc(void* p, Size n, Size alignment = DEFAULT_ALIGNMENT);
 KUN_CORE_API void* malloc(Size n, Size alignment, Size offset);
 KUN_CORE_API void* realloc(void* p, Size n, Size alignment, Size offset);
+
+// resize block in place without moving it, return nullptr if block can't hold n bytes
+KUN_CORE_API void* expand(void* p, Size n);
+
+// size of the allocator bin that serve n bytes, request less than it just waste the tail
+KUN_CORE_API Size goodSize(Size n);
 }// namespace kun::memory
 
 // memory ops
@@ -31,6 +40,16 @@ KUN_CORE_API i32 memcmp(const void* buf1, const void* buf2, size_t size);
 KUN_CORE_API void* memset(void* dst, u8 ch, Size size);
 KUN_CORE_API void* memzero(void* dst, Size size);
 KUN_CORE_API void bigMemswap(void* buf1, void* buf2, Size size);
+
+// hint cpu to load the cache line of p, never fault on invalid address
+KUN_INLINE void prefetch(const void* p)
+{
+#if KUN_COMPILER == KUN_COMPILER_GCC || KUN_COMPILER == KUN_COMPILER_CLANG
+    __builtin_prefetch(p);
+#elif KUN_SIMD_SSE2
+    _mm_prefetch((const char*)p, _MM_HINT_T0);
+#endif
+}
 KUN_INLINE void memswap(void* buf1, void* buf2, Size size)
 {
     switch (size)
@@ -17,15 +17,42 @@ public:
     virtual void* realloc(void* p, Size size, Size alignment) = 0;
     virtual void free(void* p) = 0;
 
+    // resize block in place, the block is never moved, return false if it can't be done
+    // containers try it before relocating items that can't be realloc, resources that can't expand just keep this
+    virtual bool tryExpand(void*, Size) { return false; }
+
     // help
     template<typename T> KUN_INLINE T* alloc(Size count = 1) { return (T*)alloc(count * sizeof(T), alignof(T)); }
     template<typename T> KUN_INLINE T* realloc(T* p, Size count = 1) { return (T*)realloc(p, count * sizeof(T), alignof(T)); }
-    template<typename T> KUN_INLINE void free(T* p) { free(p); }
+    template<typename T> KUN_INLINE void free(T* p) { free((void*)p); }
 };
 }// namespace kun
 
 // default allocator
+// global resource is backed by memory::malloc, default resource is current resource of this thread, fallback to global
+// containers capture default resource when constructed, so switch current resource only affect containers created after that
 namespace kun
 {
+KUN_CORE_API IMemoryResource* globalMemoryResource();
 KUN_CORE_API IMemoryResource* defaultMemoryResource();
-}
\ No newline at end of file
+
+// set current resource of this thread, nullptr restore global resource, return previous current resource
+KUN_CORE_API IMemoryResource* setCurrentMemoryResource(IMemoryResource* resource);
+
+// switch current resource of this thread in scope
+class MemoryResourceScope
+{
+public:
+    KUN_INLINE MemoryResourceScope(IMemoryResource* resource)
+        : m_prev(setCurrentMemoryResource(resource))
+    {
+    }
+    KUN_INLINE ~MemoryResourceScope() { setCurrentMemoryResource(m_prev); }
+
+    MemoryResourceScope(const MemoryResourceScope&) = delete;
+    MemoryResourceScope& operator=(const MemoryResourceScope&) = delete;
+
+private:
+    IMemoryResource* m_prev;
+};
+}// namespace kun
\ No newline at end of file
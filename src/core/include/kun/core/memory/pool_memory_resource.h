@@ -0,0 +1,166 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/core_api.h"
+#include "kun/core/std/types.hpp"
+#include "kun/core/std/kstl/container/allocator.hpp"
+#include "kun/core/std/kstl/container/array.hpp"
+#include "kun/core/std/kstl/container/uset.hpp"
+#include "memory_resource.h"
+
+// pool statistics
+namespace kun
+{
+struct PoolStats
+{
+    Size block_size = 0;
+    Size slab_count = 0;
+    Size block_count = 0;    // blocks that can be served by current slabs
+    Size used_count = 0;     // blocks in use
+    Size peak_used_count = 0;// max used_count since last release()
+
+    KUN_INLINE f32 occupancy() const { return block_count ? (f32)used_count / (f32)block_count : 0.f; }
+};
+}// namespace kun
+
+// pool memory resource
+// serve fixed size blocks from slabs, freed blocks are linked into an intrusive free list, so alloc/free is O(1)
+// slabs are aligned to slab size and begin with a header that record the owner pool, see ownerOf()
+// blocks of a new slab are handed out by bumping a cursor, so an unused slab is never touched
+// NOTE: not thread safe, slabs are only returned to upstream by release()
+namespace kun
+{
+class KUN_CORE_API PoolMemoryResource final : public IMemoryResource
+{
+    struct Slab
+    {
+        Slab*               next;
+        PoolMemoryResource* owner;
+    };
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+public:
+    static constexpr Size default_slab_size = 64 * 1024;
+    static constexpr Size max_block_alignment = 64;
+
+    // ctor & dtor, slab_size must be power of 2
+    PoolMemoryResource(Size block_size, Size slab_size = default_slab_size, IMemoryResource* upstream = defaultMemoryResource());
+    ~PoolMemoryResource() override;
+
+    // no copy & move, containers hold pointer to the resource
+    PoolMemoryResource(const PoolMemoryResource&) = delete;
+    PoolMemoryResource(PoolMemoryResource&&) = delete;
+    PoolMemoryResource& operator=(const PoolMemoryResource&) = delete;
+    PoolMemoryResource& operator=(PoolMemoryResource&&) = delete;
+
+    // getter
+    Size             blockSize() const;
+    Size             blockAlignment() const;
+    Size             blocksPerSlab() const;
+    Size             slabSize() const;
+    IMemoryResource* upstream() const;
+    PoolStats        stats() const;
+
+    // owner of block, p must be allocated by a pool with the same slab size
+    static PoolMemoryResource* ownerOf(const void* p, Size slab_size);
+
+    // impl IMemoryResource, size and alignment must fit the block
+    void* alloc(Size size, Size alignment) override;
+    void* realloc(void* p, Size size, Size alignment) override;
+    void  free(void* p) override;
+    bool  tryExpand(void* p, Size size) override;
+
+    // memory op
+    void reserve(Size block_count);
+    void release();
+
+private:
+    // helper
+    void _newSlab();
+
+private:
+    FreeBlock*       m_free_list;
+    u8*              m_cursor;
+    u8*              m_end;
+    Slab*            m_slabs;
+    Size             m_block_size;
+    Size             m_block_align;
+    Size             m_first_block_offset;
+    Size             m_slab_size;
+    Size             m_slab_count;
+    Size             m_used_count;
+    Size             m_peak_used_count;
+    IMemoryResource* m_upstream;
+};
+}// namespace kun
+
+// multi pool memory resource
+// route request to the smallest size class pool that fit it, larger request go to upstream directly
+// free() find the pool by slab address, so every block can be freed without size
+// NOTE: not thread safe
+namespace kun
+{
+class KUN_CORE_API MultiPoolMemoryResource final : public IMemoryResource
+{
+    // upstream of pools, record slab address for routing free()
+    struct SlabUpstream : public IMemoryResource
+    {
+        void* alloc(Size size, Size alignment) override;
+        void* realloc(void* p, Size size, Size alignment) override;
+        void  free(void* p) override;
+
+        IMemoryResource* upstream = nullptr;
+        USet<Size>*      slabs = nullptr;
+    };
+
+public:
+    static constexpr Size default_max_block_size = 2048;
+
+    // ctor & dtor, size classes are 16, 32, 48, 64, 96, 128, 192 ... up to max_block_size
+    MultiPoolMemoryResource(Size max_block_size = default_max_block_size, Size slab_size = PoolMemoryResource::default_slab_size,
+                            IMemoryResource* upstream = defaultMemoryResource());
+    ~MultiPoolMemoryResource() override;
+
+    // no copy & move, containers hold pointer to the resource
+    MultiPoolMemoryResource(const MultiPoolMemoryResource&) = delete;
+    MultiPoolMemoryResource(MultiPoolMemoryResource&&) = delete;
+    MultiPoolMemoryResource& operator=(const MultiPoolMemoryResource&) = delete;
+    MultiPoolMemoryResource& operator=(MultiPoolMemoryResource&&) = delete;
+
+    // getter
+    Size                      poolCount() const;
+    PoolMemoryResource&       pool(Size idx);
+    const PoolMemoryResource& pool(Size idx) const;
+    Size                      maxBlockSize() const;
+    Size                      upstreamCount() const;// blocks served by upstream directly
+    IMemoryResource*          upstream() const;
+
+    // find pool for request, npos if it should go to upstream
+    Size poolIndexOf(Size size, Size alignment) const;
+
+    // impl IMemoryResource
+    void* alloc(Size size, Size alignment) override;
+    void* realloc(void* p, Size size, Size alignment) override;
+    void  free(void* p) override;
+    bool  tryExpand(void* p, Size size) override;
+
+    // memory op
+    void release();
+
+private:
+    // helper
+    PoolMemoryResource* _newPool(Size block_size);
+    PoolMemoryResource* _ownerOf(const void* p) const;
+
+private:
+    Array<PoolMemoryResource*> m_pools;
+    USet<Size>                 m_slabs;
+    SlabUpstream               m_slab_upstream;
+    Size                       m_max_block_size;
+    Size                       m_slab_size;
+    Size                       m_upstream_count;
+    IMemoryResource*           m_upstream;
+};
+}// namespace kun
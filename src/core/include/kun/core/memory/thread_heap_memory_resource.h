@@ -0,0 +1,47 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/core_api.h"
+#include "kun/core/std/types.hpp"
+#include "memory_resource.h"
+
+struct mi_heap_s;
+
+// thread heap memory resource
+// own a mimalloc heap, blocks can be freed one by one or released at once by reset() at the end of a job
+// a heap belongs to the thread that create it, only that thread can alloc/realloc/reset, free() can be called from any thread
+// use with MemoryResourceScope to make it default resource of the worker thread
+namespace kun
+{
+class KUN_CORE_API ThreadHeapMemoryResource final : public IMemoryResource
+{
+public:
+    // ctor & dtor, dtor release every block like reset()
+    ThreadHeapMemoryResource();
+    ~ThreadHeapMemoryResource() override;
+
+    // no copy & move, containers hold pointer to the resource
+    ThreadHeapMemoryResource(const ThreadHeapMemoryResource&) = delete;
+    ThreadHeapMemoryResource(ThreadHeapMemoryResource&&) = delete;
+    ThreadHeapMemoryResource& operator=(const ThreadHeapMemoryResource&) = delete;
+    ThreadHeapMemoryResource& operator=(ThreadHeapMemoryResource&&) = delete;
+
+    // getter
+    mi_heap_s* heap() const;
+    bool       isOwnerThread() const;
+    bool       contain(const void* p) const;
+
+    // impl IMemoryResource
+    void* alloc(Size size, Size alignment) override;
+    void* realloc(void* p, Size size, Size alignment) override;
+    void  free(void* p) override;
+    bool  tryExpand(void* p, Size size) override;
+
+    // memory op
+    void reset(); // release every block at once without free them one by one, the resource can be used again
+    void collect();// return unused pages to os
+
+private:
+    mi_heap_s* m_heap;
+    Size       m_owner_thread;
+};
+}// namespace kun
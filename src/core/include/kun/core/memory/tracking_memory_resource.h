@@ -0,0 +1,67 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/core_api.h"
+#include "kun/core/std/types.hpp"
+#include "kun/core/std/kstl/name.h"
+#include "kun/core/std/kstl/container/allocator.hpp"
+#include "kun/core/std/kstl/container/array.hpp"
+#include "memory_resource.h"
+
+// tracking statistics of a tag
+namespace kun
+{
+struct TrackingStats
+{
+    Name tag;
+    Size alloc_count = 0;// alloc calls, realloc is not counted
+    Size free_count = 0;
+    Size live_count = 0;
+    Size live_bytes = 0;
+    Size total_bytes = 0;// bytes ever requested, include realloc growth
+    Size peak_bytes = 0; // sampled high water of live_bytes, see TrackingMemoryResource
+};
+}// namespace kun
+
+// tracking memory resource
+// decorate upstream and record count/bytes of blocks under a tag, resources with the same tag share statistics
+// counters live in per-thread slots that are only written by owner thread, so alloc/free never contend, snapshot() sum all slots
+// peak is sampled when a thread's live bytes of the tag grow by peak_sample_granularity, so it may miss the real peak by that much per thread
+// each block carry a header before it to record the size for free()
+namespace kun
+{
+class KUN_CORE_API TrackingMemoryResource final : public IMemoryResource
+{
+public:
+    static constexpr Size max_tag_count = 128;
+    static constexpr Size peak_sample_granularity = 4096;
+
+    // ctor & dtor
+    TrackingMemoryResource(Name tag, IMemoryResource* upstream = defaultMemoryResource());
+    ~TrackingMemoryResource() override;
+
+    // no copy & move, containers hold pointer to the resource
+    TrackingMemoryResource(const TrackingMemoryResource&) = delete;
+    TrackingMemoryResource(TrackingMemoryResource&&) = delete;
+    TrackingMemoryResource& operator=(const TrackingMemoryResource&) = delete;
+    TrackingMemoryResource& operator=(TrackingMemoryResource&&) = delete;
+
+    // getter
+    Name             tag() const;
+    IMemoryResource* upstream() const;
+    TrackingStats    stats() const;
+
+    // statistics of all tags, aggregated from every thread
+    static TrackingStats stats(Name tag);
+    static void          snapshot(Array<TrackingStats>& out);
+
+    // impl IMemoryResource
+    void* alloc(Size size, Size alignment) override;
+    void* realloc(void* p, Size size, Size alignment) override;
+    void  free(void* p) override;
+    bool  tryExpand(void* p, Size size) override;
+
+private:
+    Size             m_tag_idx;
+    IMemoryResource* m_upstream;
+};
+}// namespace kun
@@ -11,6 +11,10 @@
 #include "memory/copy_move_policy.hpp"
 #include "memory/memory.h"
 #include "memory/new_delete.h"
+#include "memory/arena_memory_resource.h"
+#include "memory/pool_memory_resource.h"
+#include "memory/thread_heap_memory_resource.h"
+#include "memory/tracking_memory_resource.h"
 
 // std
 #include "std/types.hpp"
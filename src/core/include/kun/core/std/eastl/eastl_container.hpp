@@ -1,6 +1,7 @@
 #pragma once
 #include "kun/core/config.h"
 #include "kun/core/std/kstl/hash.hpp"
+#include "kun/core/std/traits.hpp"
 
 #include "eastl_config.hpp"
 #include <EASTL/vector.h>
@@ -15,7 +16,7 @@ namespace kun
 // containers
 // template<typename T> using Array = eastl::vector<T>;
 // template<typename T> using USet = eastl::unordered_set<T, Hash<T>>;
-template<typename K, typename V> using UMap = eastl::unordered_map<K, V, Hash<K>>;
+// template<typename K, typename V> using UMap = eastl::unordered_map<K, V, Hash<K>>;
 
 // string
 using String = eastl::string;
@@ -23,6 +24,11 @@ using StringView = eastl::string_view;
 KUN_IMPL_HASH_ADAPTER(String, eastl::hash)
 KUN_IMPL_HASH_ADAPTER(StringView, eastl::hash)
 
+// eastl string locate its sso buffer by layout flag instead of self pointer, so it can be relocated by memcpy
+template<> struct is_trivially_relocatable<String> : std::true_type
+{
+};
+
 // function
 template<typename T> using Func = eastl::function<T>;
 
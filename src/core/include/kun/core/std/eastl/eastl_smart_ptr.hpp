@@ -1,6 +1,7 @@
 #pragma once
 #include "kun/core/config.h"
 #include "kun/core/std/kstl/hash.hpp"
+#include "kun/core/std/traits.hpp"
 #include "kun/core/memory/memory.h"
 #include "kun/core/memory/new_delete.h"
 
@@ -27,6 +28,18 @@ public:
 template<typename T> using SPtr = eastl::shared_ptr<T>;
 template<typename T> using WPtr = eastl::weak_ptr<T>;
 template<typename T> using UPtr = eastl::unique_ptr<T, KunDeleter<T>>;
+
+// smart ptr only point to heap, relocate them by memcpy
+template<typename T> struct is_trivially_relocatable<SPtr<T>> : std::true_type
+{
+};
+template<typename T> struct is_trivially_relocatable<WPtr<T>> : std::true_type
+{
+};
+template<typename T> struct is_trivially_relocatable<UPtr<T>> : std::true_type
+{
+};
+
 template<typename T> struct Hash<SPtr<T>>
 {
     KUN_INLINE Size operator()(const SPtr<T>& val) const { return eastl::hash<SPtr<T>>()(val); }
@@ -38,6 +38,39 @@ template<typename T, typename TF, typename TP = Less<>> KUN_INLINE T upperBound(
     }
     return begin;
 }
+// branchless version of lowerBound/upperBound, the loop run exactly log2(n) times and the select compile to cmov
+// so random queries never mispredict, prefer them for large sorted arrays and cheap predicates
+template<typename T, typename TF, typename TP = Less<>> KUN_INLINE T lowerBoundBranchless(T begin, T end, const TF& v, TP p = TP())
+{
+    Size size = (end - begin);
+    if (size == 0)
+    {
+        return begin;
+    }
+    while (size > 1)
+    {
+        const Size half = size / 2;
+        begin = p(begin[half], v) ? begin + half : begin;
+        size -= half;
+    }
+    return begin + (p(*begin, v) ? 1 : 0);
+}
+template<typename T, typename TF, typename TP = Less<>> KUN_INLINE T upperBoundBranchless(T begin, T end, const TF& v, TP p = TP())
+{
+    Size size = (end - begin);
+    if (size == 0)
+    {
+        return begin;
+    }
+    while (size > 1)
+    {
+        const Size half = size / 2;
+        begin = p(v, begin[half]) ? begin : begin + half;
+        size -= half;
+    }
+    return begin + (p(v, *begin) ? 0 : 1);
+}
+
 template<typename T, typename TF, typename TP = Less<>> KUN_INLINE T binarySearch(T begin, T end, const TF& v, TP p = TP())
 {
     auto check_item = lowerBound(begin, end, v, p);
@@ -121,7 +121,7 @@ template<typename TS> KUN_INLINE TS findBit(const u32* data, TS num, bool v)
         if (lowest_bit_idx < num)
             return lowest_bit_idx;
     }
-    return npos;
+    return (TS)npos;
 }
 template<typename TS> KUN_INLINE TS findLastBit(const u32* data, TS num, bool v)
 {
@@ -155,7 +155,7 @@ template<typename TS> KUN_INLINE TS findLastBit(const u32* data, TS num, bool v)
         }
     }
 
-    return npos;
+    return (TS)npos;
 }
 
 // find and set
@@ -181,7 +181,7 @@ template<typename TS> KUN_INLINE TS findAndSetFirstZeroBit(u32* data, TS num, TS
         }
     }
 
-    return npos;
+    return (TS)npos;
 }
 template<typename TS> KUN_INLINE TS FindAndSetLastZeroBit(u32* data, TS num)
 {
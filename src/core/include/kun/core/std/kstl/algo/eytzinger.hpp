@@ -0,0 +1,74 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/std/types.hpp"
+#include "kun/core/math/basic.h"
+#include "kun/core/memory/memory.h"
+#include "functor.hpp"
+#include <algorithm>
+
+// eytzinger layout, store sorted items in BFS order of the implicit search tree (1 based, children of k is 2k and 2k+1)
+// search walk down from root with branchless select, and the descendants several levels below a node are adjacent
+// in memory, so they are prefetched before needed, this hide most cache miss of binary search on large arrays
+namespace kun::algo
+{
+// stride of the descendants that fill one cache line, k * stride is the first of them, always power of 2
+template<typename T> inline constexpr Size eytzinger_prefetch_stride = sizeof(T) * 16 <= 64 ? 16
+                                                                     : sizeof(T) * 8 <= 64  ? 8
+                                                                     : sizeof(T) * 4 <= 64  ? 4
+                                                                                            : 2;
+
+// build layout from sorted items, out must have n + 1 constructed slots and out[0] is left untouched
+// ranks[k] is the index of out[k] in sorted items, and ranks[0] is set to n so that searching miss map to end
+template<typename T, typename TS> KUN_INLINE void eytzingerBuild(const T* sorted, TS n, T* out, TS* ranks = nullptr)
+{
+    // in-order traversal of the implicit tree
+    TS k = 1;
+    for (TS i = 0; i < n; ++i)
+    {
+        // go down to the leftmost, then go back to the first ancestor that come from left
+        while (k <= n) { k <<= 1; }
+        k >>= bitTailZero(~(u64)k) + 1;
+
+        out[k] = sorted[i];
+        if (ranks)
+        {
+            ranks[k] = i;
+        }
+
+        // go right
+        k = 2 * k + 1;
+    }
+    if (ranks)
+    {
+        ranks[0] = n;
+    }
+}
+
+// find first value that >= target, return the eytzinger index, 0 means not found
+template<typename T, typename TS, typename TF, typename TP = Less<>> KUN_INLINE TS eytzingerLowerBound(const T* data, TS n, const TF& v, TP p = TP())
+{
+    TS k = 1;
+    while (k <= n)
+    {
+        memory::prefetch(data + std::min(k * (TS)eytzinger_prefetch_stride<T>, n));
+        k = 2 * k + (p(data[k], v) ? 1 : 0);
+    }
+
+    // the answer is the last node we turn left, strip the trailing right turns and that left turn
+    k >>= bitTailZero(~(u64)k) + 1;
+    return k;
+}
+
+// find first value that > target, return the eytzinger index, 0 means not found
+template<typename T, typename TS, typename TF, typename TP = Less<>> KUN_INLINE TS eytzingerUpperBound(const T* data, TS n, const TF& v, TP p = TP())
+{
+    TS k = 1;
+    while (k <= n)
+    {
+        memory::prefetch(data + std::min(k * (TS)eytzinger_prefetch_stride<T>, n));
+        k = 2 * k + (p(v, data[k]) ? 0 : 1);
+    }
+    k >>= bitTailZero(~(u64)k) + 1;
+    return k;
+}
+}// namespace kun::algo
@@ -0,0 +1,75 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/std/types.hpp"
+#include "kun/core/functional/assert.hpp"
+#include "bit_array.hpp"
+#include <algorithm>
+#include <thread>
+
+// split [0, n) into contiguous chunks and run them on worker threads
+// the calling thread always run the first chunk, so a single chunk never spawn thread
+namespace kun::algo
+{
+inline constexpr u32 max_parallel_chunk = 64;
+
+// chunk count that every chunk has at least min_chunk_size items, limited by hardware threads
+template<typename TS> KUN_INLINE TS parallelChunkCount(TS n, TS min_chunk_size)
+{
+    TS hardware_count = (TS)std::thread::hardware_concurrency();
+    TS count = min_chunk_size ? n / min_chunk_size : n;
+    count = std::min(count, hardware_count ? hardware_count : TS(1));
+    count = std::min(count, (TS)max_parallel_chunk);
+    return count ? count : TS(1);
+}
+
+// begin index of chunk, chunk size differ at most 1
+template<typename TS> KUN_INLINE TS parallelChunkBegin(TS n, TS chunk_count, TS chunk_index)
+{
+    TS chunk_size = n / chunk_count;
+    TS remain = n % chunk_count;
+    return chunk_index * chunk_size + std::min(chunk_index, remain);
+}
+
+// func(chunk_index, begin, end)
+template<typename TS, typename TF> KUN_INLINE void parallelForChunk(TS n, TS chunk_count, TF&& func)
+{
+    KUN_Assert(chunk_count > 0 && chunk_count <= (TS)max_parallel_chunk);
+
+    std::thread threads[max_parallel_chunk];
+    for (TS i = 1; i < chunk_count; ++i)
+    {
+        TS begin = parallelChunkBegin(n, chunk_count, i);
+        TS end = parallelChunkBegin(n, chunk_count, TS(i + 1));
+        threads[i] = std::thread([&func, i, begin, end]() { func(i, begin, end); });
+    }
+    func(TS(0), TS(0), parallelChunkBegin(n, chunk_count, TS(1)));
+    for (TS i = 1; i < chunk_count; ++i) { threads[i].join(); }
+}
+
+// func(begin, end)
+template<typename TS, typename TF> KUN_INLINE void parallelFor(TS n, TS min_chunk_size, TF&& func)
+{
+    auto chunk_func = [&](TS, TS begin, TS end) { func(begin, end); };
+    parallelForChunk(n, parallelChunkCount(n, min_chunk_size), chunk_func);
+}
+
+// func(begin, end), split [0, n) bits into chunks aligned to 32 bits word, so chunks never share a word
+// used by containers that track slots with a bit array, every chunk can scan and modify its own words freely
+template<typename TS, typename TF> KUN_INLINE void parallelForBits(TS n, TS min_chunk_size, TF&& func)
+{
+    TS word_count = calcNumWords(n);
+    TS min_word_count = std::max(TS(min_chunk_size >> NumBitsPerDWORDLogTwo), TS(1));
+    auto chunk_func = [&](TS, TS word_begin, TS word_end) {
+        TS begin = word_begin << NumBitsPerDWORDLogTwo;
+        TS end = word_end == word_count ? n : TS(word_end << NumBitsPerDWORDLogTwo);
+        func(begin, end);
+    };
+    parallelForChunk(word_count, parallelChunkCount(word_count, min_word_count), chunk_func);
+}
+
+// forward to container.parallelForEach(func, grain), see SparseArray, USet and BitArray
+template<typename TContainer, typename TF, typename TS> KUN_INLINE void parallelForEach(TContainer& container, TF&& func, TS grain)
+{
+    container.parallelForEach(std::forward<TF>(func), grain);
+}
+}// namespace kun::algo
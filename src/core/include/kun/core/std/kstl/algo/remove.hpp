@@ -32,7 +32,7 @@ template<typename T, typename TP> KUN_INLINE T removeIf(T begin, T end, TP&& p =
             else
             {
                 // move item
-                if (write != begin)
+                if (write != run_start)
                 {
                     ::kun::memory::moveItems(write, run_start, run_len);
                 }
@@ -2,14 +2,26 @@
 #include "kun/core/config.h"
 #include "kun/core/std/types.hpp"
 #include "kun/core/std/traits.hpp"
+#include <cstring>
 
 namespace kun
 {
 template<typename T> KUN_INLINE void swap(T& a, T& b)
 {
-    T tmp = a;
-    a = b;
-    b = tmp;
+    if constexpr (is_trivially_relocatable_v<T> && !std::is_trivially_copyable_v<T>)
+    {
+        // swap bytes of relocatable items, sort & rotate never touch their copy/dtor
+        alignas(T) u8 tmp[sizeof(T)];
+        std::memcpy(tmp, (void*)&a, sizeof(T));
+        std::memcpy((void*)&a, (void*)&b, sizeof(T));
+        std::memcpy((void*)&b, tmp, sizeof(T));
+    }
+    else
+    {
+        T tmp = a;
+        a = b;
+        b = tmp;
+    }
 }
 
 // is swapable
@@ -2,20 +2,144 @@
 #include "kun/core/config.h"
 #include "kun/core/functional/assert.hpp"
 #include "kun/core/std/types.hpp"
+#include "kun/core/math/basic.h"
 #include "kun/core/memory/memory_resource.h"
+#include "fwd.hpp"
+
+// grow policy
+// decide capacity of containers, size and capacity are in item count, item_size is used by policies that round to allocator bins
+// Policy provide: template<typename TS> static TS grow(TS size, TS capacity, Size item_size), size > capacity
+//                 template<typename TS> static TS shrink(TS size, TS capacity, Size item_size), size < capacity, return capacity to keep memory
+namespace kun
+{
+struct GrowPolicyBase
+{
+    static constexpr Size first_grow = 4;
+
+    // count calculated in Size, clamp it to TS
+    template<typename TS> KUN_INLINE static TS clamp(Size count)
+    {
+        return count > (Size)std::numeric_limits<TS>::max() ? std::numeric_limits<TS>::max() : (TS)count;
+    }
+
+    // round capacity to fill rounded bytes, the rounded size must not be less than capacity * item_size
+    template<typename TS> KUN_INLINE static TS fillBytes(TS capacity, Size item_size, Size rounded_bytes)
+    {
+        return std::max(capacity, clamp<TS>(rounded_bytes / item_size));
+    }
+
+    // shrink to size only when it release enough memory
+    template<typename TS> KUN_INLINE static TS shrinkLazy(TS size, TS capacity)
+    {
+        return ((3 * (Size)size < 2 * (Size)capacity) && (capacity - size > 64 || !size)) ? size : capacity;
+    }
+};
+
+// size + 3/8 size + 16
+struct GrowPolicyDefault : public GrowPolicyBase
+{
+    template<typename TS> KUN_INLINE static TS grow(TS size, TS capacity, Size)
+    {
+        constexpr Size constant_grow = 16;
+        if (!capacity && size <= first_grow)
+        {
+            return (TS)first_grow;
+        }
+        Size result = (Size)size + 3 * (Size)size / 8 + constant_grow;
+        return result < (Size)size ? std::numeric_limits<TS>::max() : clamp<TS>(result);
+    }
+    template<typename TS> KUN_INLINE static TS shrink(TS size, TS capacity, Size) { return shrinkLazy(size, capacity); }
+};
+
+// exactly fit, for containers that are filled once
+struct GrowPolicyExact : public GrowPolicyBase
+{
+    template<typename TS> KUN_INLINE static TS grow(TS size, TS, Size) { return size; }
+    template<typename TS> KUN_INLINE static TS shrink(TS size, TS, Size) { return size; }
+};
+
+// capacity * Num / Den, at least fit size
+template<Size Num, Size Den> struct GrowPolicyFactor : public GrowPolicyBase
+{
+    static_assert(Num > Den && Den > 0, "grow factor must be greater than 1");
+
+    template<typename TS> KUN_INLINE static TS grow(TS size, TS capacity, Size)
+    {
+        Size result = std::max((Size)capacity * Num / Den, first_grow);
+        return clamp<TS>(std::max(result, (Size)size));
+    }
+    template<typename TS> KUN_INLINE static TS shrink(TS size, TS capacity, Size) { return shrinkLazy(size, capacity); }
+};
+using GrowPolicyOneHalf = GrowPolicyFactor<3, 2>;
+using GrowPolicyDouble = GrowPolicyFactor<2, 1>;
+
+// power of 2 capacity
+struct GrowPolicyPow2 : public GrowPolicyBase
+{
+    template<typename TS> KUN_INLINE static TS grow(TS size, TS, Size)
+    {
+        Size result = std::max((Size)size, first_grow);
+        return result > (Size)std::numeric_limits<TS>::max() / 2 ? clamp<TS>(result) : (TS)ceilPowerOf2((u64)result);
+    }
+    template<typename TS> KUN_INLINE static TS shrink(TS size, TS capacity, Size item_size)
+    {
+        TS result = shrinkLazy(size, capacity);
+        return result == capacity || !result ? result : std::min(capacity, grow(size, (TS)0, item_size));
+    }
+};
+
+// round bytes of capacity up to page size once it reach a page, small containers keep Base capacity
+template<typename Base = GrowPolicyDefault, Size PageSize = 4096> struct GrowPolicyPage : public GrowPolicyBase
+{
+    static_assert((PageSize & (PageSize - 1)) == 0, "page size must be power of 2");
+
+    template<typename TS> KUN_INLINE static TS round(TS capacity, Size item_size)
+    {
+        Size bytes = (Size)capacity * item_size;
+        return bytes < PageSize ? capacity : fillBytes(capacity, item_size, (bytes + PageSize - 1) & ~(PageSize - 1));
+    }
+    template<typename TS> KUN_INLINE static TS grow(TS size, TS capacity, Size item_size) { return round(Base::grow(size, capacity, item_size), item_size); }
+    template<typename TS> KUN_INLINE static TS shrink(TS size, TS capacity, Size item_size)
+    {
+        return std::min(capacity, round(Base::shrink(size, capacity, item_size), item_size));
+    }
+};
+
+// round bytes of capacity up to the mimalloc bin that serve it, the tail would be wasted by allocator anyway
+template<typename Base = GrowPolicyDefault> struct GrowPolicyMiGoodSize : public GrowPolicyBase
+{
+    template<typename TS> KUN_INLINE static TS round(TS capacity, Size item_size)
+    {
+        return capacity ? fillBytes(capacity, item_size, memory::goodSize((Size)capacity * item_size)) : capacity;
+    }
+    template<typename TS> KUN_INLINE static TS grow(TS size, TS capacity, Size item_size) { return round(Base::grow(size, capacity, item_size), item_size); }
+    template<typename TS> KUN_INLINE static TS shrink(TS size, TS capacity, Size item_size)
+    {
+        return std::min(capacity, round(Base::shrink(size, capacity, item_size), item_size));
+    }
+};
+}// namespace kun
 
 // alloc template
 namespace kun
 {
-template<typename TDerived, typename TS> class AllocTemplate
+template<typename TDerived, typename TS, typename GrowPolicy> class AllocTemplate
 {
 public:
     using SizeType = TS;
 
+    // allocator that own memory inside itself (see InlineAllocator), container can't steal such memory on move
+    static constexpr bool has_inline_storage = false;
+    KUN_INLINE bool       isInlineMemory(const void*) const { return false; }
+
     // impl it
-    // KUN_INLINE void  freeRaw(void* p, SizeType align);
-    // KUN_INLINE void* allocRaw(SizeType size, SizeType align);
-    // KUN_INLINE void* reallocRaw(void* p, SizeType size, SizeType align);
+    // sizes of raw memory are in bytes and always Size, SizeType only limit the item count of containers
+    // KUN_INLINE void  freeRaw(void* p, Size align);
+    // KUN_INLINE void* allocRaw(Size size, Size align);
+    // KUN_INLINE void* reallocRaw(void* p, Size size, Size align);
+
+    // optional, resize block in place, see IMemoryResource::tryExpand()
+    KUN_INLINE bool expandRaw(void*, Size) { return false; }
 
     // helper
     template<typename T> KUN_INLINE void free(T* p) { static_cast<TDerived*>(this)->freeRaw(p, alignof(T)); }
@@ -24,45 +148,22 @@ public:
     {
         return (T*)static_cast<TDerived*>(this)->reallocRaw(p, size * sizeof(T), alignof(T));
     }
+    template<typename T> KUN_INLINE bool tryExpand(T* p, SizeType size) { return static_cast<TDerived*>(this)->expandRaw(p, size * sizeof(T)); }
 
-    // size > capacity, calc grow
-    KUN_INLINE SizeType getGrow(SizeType size, SizeType capacity)
+    // size > capacity, calc grow, item_size is size of the item in bytes
+    KUN_INLINE SizeType getGrow(SizeType size, SizeType capacity, Size item_size)
     {
-        constexpr SizeType first_grow = 4;
-        constexpr SizeType constant_grow = 16;
-
         KUN_Assert(size > capacity && size > 0);
-
-        // init data
-        SizeType result = first_grow;
-
-        // calc grow
-        if (capacity || size > first_grow)
-        {
-            result = size + 3 * size / 8 + constant_grow;
-        }
-
-        // handle num over flow
-        if (size > result)
-            result = std::numeric_limits<SizeType>::max();
-
+        SizeType result = GrowPolicy::grow(size, capacity, item_size);
+        KUN_Assert(result >= size);
         return result;
     }
     // size < capacity, calc shrink
-    KUN_INLINE SizeType getShrink(SizeType size, SizeType capacity)
+    KUN_INLINE SizeType getShrink(SizeType size, SizeType capacity, Size item_size)
     {
         KUN_Assert(size < capacity);
-
-        SizeType result;
-        if ((3 * size < 2 * capacity) && (capacity - size > 64 || !size))
-        {
-            result = size;
-        }
-        else
-        {
-            result = capacity;
-        }
-
+        SizeType result = GrowPolicy::shrink(size, capacity, item_size);
+        KUN_Assert(result >= size && result <= capacity);
         return result;
     }
 
@@ -77,51 +178,282 @@ public:
         {
             return realloc(p, new_capacity);
         }
+        else
+        {
+            // grow in place, items stay where they are
+            if (new_capacity > capacity && p && tryExpand(p, new_capacity))
+            {
+                return p;
+            }
 
-        // alloc new memory
-        T* new_memory = alloc<T>(new_capacity);
+            // alloc new memory
+            T* new_memory = alloc<T>(new_capacity);
 
-        // move memory
-        if (size)
-        {
-            // move items
-            memory::moveItems(new_memory, p, std::min(size, new_capacity));
+            // move memory
+            if (size)
+            {
+                SizeType move_n = std::min(size, new_capacity);
 
-            // destruct old items
-            memory::destructItem(p, size);
+                // relocate items
+                memory::relocateItems(new_memory, p, move_n);
+
+                // destruct items out of new capacity
+                memory::destructItem(p + move_n, size - move_n);
+            }
 
             // release old memory
-            free(p);
-        }
+            if (p)
+            {
+                free(p);
+            }
 
-        return new_memory;
+            return new_memory;
+        }
     }
 };
 }// namespace kun
 
 // pmr allocator
+// TS is the size type of containers, PmrAllocator32 halve the index overhead of containers that hold less than 4G items
 namespace kun
 {
-class PmrAllocator : public AllocTemplate<PmrAllocator, Size>
+template<typename TS> class BasicPmrAllocator : public AllocTemplate<BasicPmrAllocator<TS>, TS>
 {
 public:
+    using SizeType = TS;
+
     // ctor...
-    KUN_INLINE PmrAllocator(IMemoryResource* res = defaultMemoryResource())
+    KUN_INLINE BasicPmrAllocator(IMemoryResource* res = defaultMemoryResource())
         : m_res(res)
     {
         KUN_Assert(m_res != nullptr);
     }
-    KUN_INLINE               PmrAllocator(const PmrAllocator&) = default;
-    KUN_INLINE               PmrAllocator(PmrAllocator&&) = default;
-    KUN_INLINE PmrAllocator& operator=(const PmrAllocator&) = default;
-    KUN_INLINE PmrAllocator& operator=(PmrAllocator&&) = default;
+    KUN_INLINE                    BasicPmrAllocator(const BasicPmrAllocator&) = default;
+    KUN_INLINE                    BasicPmrAllocator(BasicPmrAllocator&&) = default;
+    KUN_INLINE BasicPmrAllocator& operator=(const BasicPmrAllocator&) = default;
+    KUN_INLINE BasicPmrAllocator& operator=(BasicPmrAllocator&&) = default;
+
+    // getter
+    KUN_INLINE IMemoryResource* resource() const { return m_res; }
 
     // impl
-    KUN_INLINE void  freeRaw(void* p, SizeType align) { m_res->free(p); }
-    KUN_INLINE void* allocRaw(SizeType size, SizeType align) { return m_res->alloc(size, align); }
-    KUN_INLINE void* reallocRaw(void* p, SizeType size, SizeType align) { return m_res->realloc(p, size, align); }
+    KUN_INLINE void  freeRaw(void* p, Size align) { m_res->free(p); }
+    KUN_INLINE void* allocRaw(Size size, Size align) { return m_res->alloc(size, align); }
+    KUN_INLINE void* reallocRaw(void* p, Size size, Size align) { return m_res->realloc(p, size, align); }
+    KUN_INLINE bool  expandRaw(void* p, Size size) { return m_res->tryExpand(p, size); }
 
 private:
     IMemoryResource* m_res;
 };
-}// namespace kun
\ No newline at end of file
+}// namespace kun
+
+// static allocator
+// stateless allocator bound to a static resource at compile time, so alloc/free are direct calls and the allocator take no storage in containers
+// Resource provide: static void* alloc(Size size, Size align), static void* realloc(void* p, Size size, Size align), static void free(void* p)
+// and optional static bool expand(void* p, Size size) for in place resize
+namespace kun
+{
+template<typename Resource, typename = void> struct static_resource_has_expand : std::false_type
+{
+};
+template<typename Resource>
+struct static_resource_has_expand<Resource, std::void_t<decltype(Resource::expand(std::declval<void*>(), std::declval<Size>()))>> : std::true_type
+{
+};
+
+template<typename Resource, typename TS, typename GrowPolicy>
+class StaticAllocator : public AllocTemplate<StaticAllocator<Resource, TS, GrowPolicy>, TS, GrowPolicy>
+{
+public:
+    using SizeType = TS;
+
+    // impl
+    KUN_INLINE void  freeRaw(void* p, Size align) { Resource::free(p); }
+    KUN_INLINE void* allocRaw(Size size, Size align) { return Resource::alloc(size, align); }
+    KUN_INLINE void* reallocRaw(void* p, Size size, Size align) { return Resource::realloc(p, size, align); }
+    KUN_INLINE bool  expandRaw(void* p, Size size)
+    {
+        if constexpr (static_resource_has_expand<Resource>::value)
+        {
+            return Resource::expand(p, size);
+        }
+        else
+        {
+            return false;
+        }
+    }
+};
+
+// mimalloc through memory::malloc, same memory as global resource without virtual call
+struct MiStaticResource
+{
+    KUN_INLINE static void* alloc(Size size, Size align) { return memory::malloc(size, align); }
+    KUN_INLINE static void* realloc(void* p, Size size, Size align) { return memory::realloc(p, size, align); }
+    KUN_INLINE static void  free(void* p) { memory::free(p); }
+    KUN_INLINE static bool  expand(void* p, Size size) { return memory::expand(p, size) != nullptr; }
+};
+}// namespace kun
+
+// inline allocator
+// keep storage of the first N items of T inside the allocator, so container own it without heap allocation
+// larger request fallback to Fallback, and the growth from inline storage jump to fallback grow directly
+// only one block can live in inline storage, and copy/move the allocator never copy inline storage
+// Array move items instead of steal pointer when data is inline, other containers do not support it
+namespace kun
+{
+template<typename T, Size N, typename Fallback> class InlineAllocator : public AllocTemplate<InlineAllocator<T, N, Fallback>, typename Fallback::SizeType>
+{
+    static_assert(N > 0, "InlineAllocator need at least one inline item");
+
+public:
+    using SizeType = typename Fallback::SizeType;
+
+    static constexpr bool     has_inline_storage = true;
+    static constexpr SizeType inline_capacity = (SizeType)N;
+
+    // ctor...
+    KUN_INLINE InlineAllocator(Fallback fallback = Fallback())
+        : m_fallback(std::move(fallback))
+        , m_inline_used(false)
+    {
+    }
+    KUN_INLINE InlineAllocator(const InlineAllocator& other)
+        : m_fallback(other.m_fallback)
+        , m_inline_used(false)
+    {
+    }
+    KUN_INLINE InlineAllocator(InlineAllocator&& other)
+        : m_fallback(std::move(other.m_fallback))
+        , m_inline_used(false)
+    {
+    }
+    KUN_INLINE InlineAllocator& operator=(const InlineAllocator& rhs)
+    {
+        m_fallback = rhs.m_fallback;
+        return *this;
+    }
+    KUN_INLINE InlineAllocator& operator=(InlineAllocator&& rhs)
+    {
+        m_fallback = std::move(rhs.m_fallback);
+        return *this;
+    }
+
+    // getter
+    KUN_INLINE bool            isInlineMemory(const void* p) const { return p == m_storage; }
+    KUN_INLINE bool            isInlineUsed() const { return m_inline_used; }
+    KUN_INLINE Fallback&       fallback() { return m_fallback; }
+    KUN_INLINE const Fallback& fallback() const { return m_fallback; }
+
+    // impl
+    KUN_INLINE void freeRaw(void* p, Size align)
+    {
+        if (p == m_storage)
+        {
+            m_inline_used = false;
+        }
+        else if (p)
+        {
+            m_fallback.freeRaw(p, align);
+        }
+    }
+    KUN_INLINE void* allocRaw(Size size, Size align)
+    {
+        if (_canUseInline(size, align))
+        {
+            m_inline_used = true;
+            return m_storage;
+        }
+        return m_fallback.allocRaw(size, align);
+    }
+    KUN_INLINE void* reallocRaw(void* p, Size size, Size align)
+    {
+        if (!p)
+        {
+            return allocRaw(size, align);
+        }
+        else if (p == m_storage)
+        {
+            // still fit, or move out to fallback
+            if (size <= sizeof(m_storage))
+            {
+                return p;
+            }
+            void* new_p = m_fallback.allocRaw(size, align);
+            memory::memcpy(new_p, m_storage, sizeof(m_storage));
+            m_inline_used = false;
+            return new_p;
+        }
+        else if (_canUseInline(size, align))
+        {
+            // shrink back into inline storage
+            memory::memcpy(m_storage, p, size);
+            m_fallback.freeRaw(p, align);
+            m_inline_used = true;
+            return m_storage;
+        }
+        return m_fallback.reallocRaw(p, size, align);
+    }
+    KUN_INLINE bool expandRaw(void* p, Size size)
+    {
+        if (p == m_storage)
+        {
+            return size <= sizeof(m_storage);
+        }
+        return m_fallback.expandRaw(p, size);
+    }
+
+    // grow & shrink, inline capacity is always taken at once
+    KUN_INLINE SizeType getGrow(SizeType size, SizeType capacity, Size item_size)
+    {
+        return size <= inline_capacity ? inline_capacity : m_fallback.getGrow(size, capacity, item_size);
+    }
+    KUN_INLINE SizeType getShrink(SizeType size, SizeType capacity, Size item_size)
+    {
+        if (capacity <= inline_capacity)
+        {
+            return capacity;
+        }
+        return size <= inline_capacity ? inline_capacity : m_fallback.getShrink(size, capacity, item_size);
+    }
+
+private:
+    KUN_INLINE bool _canUseInline(Size size, Size align) const
+    {
+        return !m_inline_used && size <= sizeof(m_storage) && align <= alignof(T);
+    }
+
+private:
+    alignas(T) u8 m_storage[sizeof(T) * N];
+    Fallback m_fallback;
+    bool     m_inline_used;
+};
+}// namespace kun
+
+// grow policy allocator
+// replace grow policy of Base, memory still come from Base, e.g. GrowPolicyAllocator<GrowPolicyDouble> for hot arrays
+namespace kun
+{
+template<typename GrowPolicy, typename Base> class GrowPolicyAllocator : public Base
+{
+public:
+    using SizeType = typename Base::SizeType;
+
+    // ctor...
+    KUN_INLINE GrowPolicyAllocator(Base base = Base())
+        : Base(std::move(base))
+    {
+    }
+
+    // grow & shrink
+    KUN_INLINE SizeType getGrow(SizeType size, SizeType capacity, Size item_size)
+    {
+        KUN_Assert(size > capacity && size > 0);
+        return GrowPolicy::grow(size, capacity, item_size);
+    }
+    KUN_INLINE SizeType getShrink(SizeType size, SizeType capacity, Size item_size)
+    {
+        KUN_Assert(size < capacity);
+        return GrowPolicy::shrink(size, capacity, item_size);
+    }
+};
+}// namespace kun
@@ -14,6 +14,7 @@ template<typename T, typename Alloc> class Array
 {
 public:
     using SizeType = typename Alloc::SizeType;
+    static constexpr SizeType npos = (SizeType)::kun::npos;// invalid index, kun::npos is only equal to it when SizeType is Size
 
     // ctor & dtor
     Array(Alloc alloc = Alloc());
@@ -168,12 +169,18 @@ private:
     // helper
     void _resizeMemory(SizeType new_capacity);
     void _grow(SizeType n);
+    void _moveFrom(Array& other);
 
 private:
-    T*       m_data;
-    SizeType m_size;
-    SizeType m_capacity;
-    Alloc    m_alloc;
+    T*                          m_data;
+    SizeType                    m_size;
+    SizeType                    m_capacity;
+    KUN_NO_UNIQUE_ADDRESS Alloc m_alloc;
+};
+
+// only point to heap memory, relocatable as its allocator (InlineAllocator is not, it keep items inside itself)
+template<typename T, typename Alloc> struct is_trivially_relocatable<Array<T, Alloc>> : is_trivially_relocatable<Alloc>
+{
 };
 }// namespace kun
 
@@ -200,6 +207,29 @@ template<typename T, typename Alloc> KUN_INLINE void Array<T, Alloc>::_resizeMem
         m_capacity = 0;
     }
 }
+template<typename T, typename Alloc> KUN_INLINE void Array<T, Alloc>::_moveFrom(Array& other)
+{
+    if (other.m_alloc.isInlineMemory(other.m_data))
+    {
+        // inline memory belong to other's allocator, move items into our own memory
+        m_data = m_alloc.template alloc<T>(other.m_capacity);
+        m_size = other.m_size;
+        m_capacity = other.m_capacity;
+        memory::relocateItems(m_data, other.m_data, other.m_size);
+        other.m_alloc.free(other.m_data);
+    }
+    else
+    {
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_capacity = other.m_capacity;
+    }
+
+    // invalidate other
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_capacity = 0;
+}
 template<typename T, typename Alloc> KUN_INLINE void Array<T, Alloc>::_grow(SizeType n)
 {
     auto new_size = m_size + n;
@@ -207,7 +237,7 @@ template<typename T, typename Alloc> KUN_INLINE void Array<T, Alloc>::_grow(Size
     // grow memory
     if (new_size > m_capacity)
     {
-        auto new_capacity = m_alloc.getGrow(new_size, m_capacity);
+        auto new_capacity = m_alloc.getGrow(new_size, m_capacity, sizeof(T));
         m_data = m_alloc.resizeContainer(m_data, m_size, m_capacity, new_capacity);
         m_capacity = new_capacity;
     }
@@ -278,14 +308,12 @@ KUN_INLINE Array<T, Alloc>::Array(const Array& other, Alloc alloc)
 }
 template<typename T, typename Alloc>
 KUN_INLINE Array<T, Alloc>::Array(Array&& other) noexcept
-    : m_data(other.m_data)
-    , m_size(other.m_size)
-    , m_capacity(other.m_capacity)
+    : m_data(nullptr)
+    , m_size(0)
+    , m_capacity(0)
     , m_alloc(std::move(other.m_alloc))
 {
-    other.m_data = nullptr;
-    other.m_size = 0;
-    other.m_capacity = 0;
+    _moveFrom(other);
 }
 
 // assign & move assign
@@ -309,16 +337,9 @@ template<typename T, typename Alloc> KUN_INLINE Array<T, Alloc>& Array<T, Alloc>
         // release
         release();
 
-        // copy data
-        m_data = rhs.m_data;
-        m_size = rhs.m_size;
-        m_capacity = rhs.m_capacity;
+        // move data
         m_alloc = std::move(rhs.m_alloc);
-
-        // invalidate rhs
-        rhs.m_data = nullptr;
-        rhs.m_size = 0;
-        rhs.m_capacity = 0;
+        _moveFrom(rhs);
     }
     return *this;
 }
@@ -382,8 +403,11 @@ template<typename T, typename Alloc> KUN_INLINE void Array<T, Alloc>::reserve(Si
 }
 template<typename T, typename Alloc> KUN_INLINE void Array<T, Alloc>::shrink()
 {
-    auto new_capacity = m_alloc.getShrink(m_size, m_capacity);
-    _resizeMemory(new_capacity);
+    auto new_capacity = m_alloc.getShrink(m_size, m_capacity, sizeof(T));
+    if (new_capacity != m_capacity)
+    {
+        _resizeMemory(new_capacity);
+    }
 }
 template<typename T, typename Alloc> KUN_INLINE void Array<T, Alloc>::resize(SizeType size, const T& new_value)
 {
@@ -531,7 +555,7 @@ template<typename T, typename Alloc> KUN_INLINE void Array<T, Alloc>::addAtUnsaf
     KUN_Assert(isValidIndex(idx));
     auto move_n = m_size - idx;
     _grow(n);
-    memory::moveItems(m_data + idx + n, m_data + idx, move_n);
+    memory::relocateItems(m_data + idx + n, m_data + idx, move_n);
 }
 template<typename T, typename Alloc> KUN_INLINE void Array<T, Alloc>::addAtDefault(SizeType idx, SizeType n)
 {
@@ -630,15 +654,15 @@ template<typename T, typename Alloc> KUN_INLINE void Array<T, Alloc>::removeAt(S
         // calc move size
         auto move_n = m_size - index - n;
 
+        // destruct data
+        memory::destructItem(m_data + index, n);
+
         // move data
         if (move_n)
         {
-            memory::moveItems(m_data + index, m_data + m_size - move_n, move_n);
+            memory::relocateItems(m_data + index, m_data + m_size - move_n, move_n);
         }
 
-        // destruct data
-        memory::destructItem(m_data + index + move_n, n);
-
         // update size
         m_size -= n;
     }
@@ -651,15 +675,15 @@ template<typename T, typename Alloc> KUN_INLINE void Array<T, Alloc>::removeAtSw
         // calc move size
         auto move_n = std::min(m_size - index - n, n);
 
+        // destruct data
+        memory::destructItem(m_data + index, n);
+
         // move data
         if (move_n)
         {
-            memory::moveItems(m_data + index, m_data + m_size - move_n, move_n);
+            memory::relocateItems(m_data + index, m_data + m_size - move_n, move_n);
         }
 
-        // destruct data
-        memory::destructItem(m_data + index + move_n, n);
-
         // update size
         m_size -= n;
     }
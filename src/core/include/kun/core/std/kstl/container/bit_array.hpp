@@ -2,6 +2,7 @@
 #include "kun/core/config.h"
 #include "kun/core/std/types.hpp"
 #include "kun/core/std/kstl/algo/bit_array.hpp"
+#include "kun/core/std/kstl/algo/parallel.hpp"
 #include "kun/core/memory/memory.h"
 #include "bit_iterator.hpp"
 #include "fwd.hpp"
@@ -13,10 +14,13 @@ template<typename Alloc> class BitArray final
 {
 public:
     using SizeType = typename Alloc::SizeType;
+    static constexpr SizeType npos = (SizeType)::kun::npos;
     using It = BitIt<SizeType, false>;
     using CIt = BitIt<SizeType, true>;
     using TIt = TrueBitIt<SizeType>;
 
+    static_assert(!Alloc::has_inline_storage, "BitArray not support inline allocator");
+
     // ctor & dtor
     BitArray(Alloc alloc = Alloc());
     BitArray(SizeType size, bool v, Alloc alloc = Alloc());
@@ -81,16 +85,26 @@ public:
     BitIt<SizeType, true>  begin() const;
     BitIt<SizeType, true>  end() const;
 
+    // parallel foreach true bit, func(index) is called on worker threads, bits are split into word aligned chunks of at least
+    // grain bits, so func can modify bits of its own index
+    template<typename TF> void parallelForEach(TF&& func, SizeType grain = parallel_grain) const;
+    static constexpr SizeType  parallel_grain = 16384;
+
 private:
     // helper
     void _grow(SizeType size);
     void _resizeMemory(SizeType new_capacity);
 
 private:
-    u32*     m_data;
-    SizeType m_size;
-    SizeType m_capacity;
-    Alloc    m_alloc;
+    u32*                        m_data;
+    SizeType                    m_size;
+    SizeType                    m_capacity;
+    KUN_NO_UNIQUE_ADDRESS Alloc m_alloc;
+};
+
+// relocatable as its allocator
+template<typename Alloc> struct is_trivially_relocatable<BitArray<Alloc>> : is_trivially_relocatable<Alloc>
+{
 };
 }// namespace kun
 
@@ -106,7 +120,7 @@ template<typename Alloc> KUN_INLINE void BitArray<Alloc>::_grow(SizeType size)
         SizeType old_word_size = algo::calcNumWords(m_size);
         SizeType old_word_capacity = algo::calcNumWords(m_capacity);
         SizeType new_word_size = algo::calcNumWords(m_size + size);
-        SizeType new_word_capacity = m_alloc.getGrow(new_word_size, old_word_capacity);
+        SizeType new_word_capacity = m_alloc.getGrow(new_word_size, old_word_capacity, sizeof(u32));
 
         // realloc
         m_data = m_alloc.resizeContainer(m_data, old_word_size, old_word_capacity, new_word_capacity);
@@ -393,4 +407,12 @@ template<typename Alloc> KUN_INLINE typename BitArray<Alloc>::It  BitArray<Alloc
 template<typename Alloc> KUN_INLINE typename BitArray<Alloc>::CIt BitArray<Alloc>::begin() const { return CIt(*this); }
 template<typename Alloc> KUN_INLINE typename BitArray<Alloc>::CIt BitArray<Alloc>::end() const { return CIt(*this, m_size); }
 
+// parallel foreach
+template<typename Alloc> template<typename TF> KUN_INLINE void BitArray<Alloc>::parallelForEach(TF&& func, SizeType grain) const
+{
+    algo::parallelForBits(m_size, grain, [&](SizeType begin, SizeType end) {
+        for (TIt it(m_data, end, begin); it; ++it) { func(it.index()); }
+    });
+}
+
 }// namespace kun
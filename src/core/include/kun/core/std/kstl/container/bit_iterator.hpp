@@ -140,6 +140,13 @@ public:
 private:
     KUN_INLINE void _findFirstSetBit()
     {
+        // empty or end iterator
+        if (m_bit_index >= m_size)
+        {
+            m_bit_index = m_size;
+            return;
+        }
+
         const TS last_DWORD_idx = (m_size - 1) / algo::NumBitsPerDWORD;
 
         // skip zero words
@@ -0,0 +1,152 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/std/types.hpp"
+#include "kun/core/std/kstl/kvpair.hpp"
+#include "umap.hpp"
+#include "concurrent_uset.hpp"
+#include "fwd.hpp"
+
+// ConcurrentUMap def
+// same as ConcurrentUSet, value is copied out or visited under lock
+namespace kun
+{
+template<typename K, typename V, typename Config, typename Alloc, u32 ShardCount>
+class ConcurrentUMap : public ConcurrentUSet<KVPair<K, V>, Config, Alloc, ShardCount>
+{
+    using Super = ConcurrentUSet<KVPair<K, V>, Config, Alloc, ShardCount>;
+    using typename Super::Shard;
+
+public:
+    using PairType = KVPair<K, V>;
+    using typename Super::SizeType;
+    using typename Super::HashType;
+    using typename Super::KeyType;
+    using typename Super::HasherType;
+
+    // ctor & dtor
+    ConcurrentUMap(Alloc alloc = Alloc());
+    ~ConcurrentUMap();
+
+    // add (add or assign value), return true if key already exist
+    using Super::add;
+    using Super::addHashed;
+    template<typename TK, typename TV> bool add(TK&& key, TV&& value);
+    template<typename TK, typename TV> bool addHashed(TK&& key, TV&& value, HashType hash);
+
+    // try add (first check existence, then add, never assign), return true if key already exist
+    using Super::tryAdd;
+    using Super::tryAddHashed;
+    template<typename TK, typename TV> bool tryAdd(TK&& key, TV&& value);
+    template<typename TK, typename TV> bool tryAddHashed(TK&& key, TV&& value, HashType hash);
+
+    // find or add value, creator() is called only when key is missing and must return the V to add
+    // visitor(V&) is called with the found or added value under unique lock, return true if key already exist
+    template<typename TCreator, typename TVisitor> bool findOrAddValue(const KeyType& key, TCreator&& creator, TVisitor&& visitor);
+    template<typename TCreator, typename TVisitor>
+    bool findOrAddValueHashed(const KeyType& key, HashType hash, TCreator&& creator, TVisitor&& visitor);
+
+    // find value, copy value to out if found, return true if found
+    bool findValue(const KeyType& key, V& out) const;
+    bool findValueHashed(const KeyType& key, HashType hash, V& out) const;
+};
+}// namespace kun
+
+// ConcurrentUMap impl
+namespace kun
+{
+// ctor & dtor
+template<typename K, typename V, typename Config, typename Alloc, u32 ShardCount>
+KUN_INLINE ConcurrentUMap<K, V, Config, Alloc, ShardCount>::ConcurrentUMap(Alloc alloc)
+    : Super(std::move(alloc))
+{
+}
+template<typename K, typename V, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE ConcurrentUMap<K, V, Config, Alloc, ShardCount>::~ConcurrentUMap() {}
+
+// add (add or assign value)
+template<typename K, typename V, typename Config, typename Alloc, u32 ShardCount>
+template<typename TK, typename TV>
+KUN_INLINE bool ConcurrentUMap<K, V, Config, Alloc, ShardCount>::add(TK&& key, TV&& value)
+{
+    HashType hash = HasherType()(key);
+    return addHashed(std::forward<TK>(key), std::forward<TV>(value), hash);
+}
+template<typename K, typename V, typename Config, typename Alloc, u32 ShardCount>
+template<typename TK, typename TV>
+KUN_INLINE bool ConcurrentUMap<K, V, Config, Alloc, ShardCount>::addHashed(TK&& key, TV&& value, HashType hash)
+{
+    Shard&                              shard = Super::_shardOf(hash);
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    if constexpr (!Config::multi_key)
+    {
+        // assign value only, key is already equal
+        if (auto info = shard.set.findHashed(key, hash))
+        {
+            info->value = std::forward<TV>(value);
+            return true;
+        }
+    }
+    shard.set.emplaceAnywayHashed(hash, std::forward<TK>(key), std::forward<TV>(value));
+    return false;
+}
+
+// try add (first check existence, then add, never assign)
+template<typename K, typename V, typename Config, typename Alloc, u32 ShardCount>
+template<typename TK, typename TV>
+KUN_INLINE bool ConcurrentUMap<K, V, Config, Alloc, ShardCount>::tryAdd(TK&& key, TV&& value)
+{
+    HashType hash = HasherType()(key);
+    return tryAddHashed(std::forward<TK>(key), std::forward<TV>(value), hash);
+}
+template<typename K, typename V, typename Config, typename Alloc, u32 ShardCount>
+template<typename TK, typename TV>
+KUN_INLINE bool ConcurrentUMap<K, V, Config, Alloc, ShardCount>::tryAddHashed(TK&& key, TV&& value, HashType hash)
+{
+    Shard& shard = Super::_shardOf(hash);
+
+    // most try add hit existing key, check it with shared lock first
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.lock);
+        if (shard.set.containHashed(key, hash))
+        {
+            return true;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    if (shard.set.containHashed(key, hash))
+    {
+        return true;
+    }
+    shard.set.emplaceAnywayHashed(hash, std::forward<TK>(key), std::forward<TV>(value));
+    return false;
+}
+
+// find or add value
+template<typename K, typename V, typename Config, typename Alloc, u32 ShardCount>
+template<typename TCreator, typename TVisitor>
+KUN_INLINE bool ConcurrentUMap<K, V, Config, Alloc, ShardCount>::findOrAddValue(const KeyType& key, TCreator&& creator, TVisitor&& visitor)
+{
+    return findOrAddValueHashed(key, HasherType()(key), std::forward<TCreator>(creator), std::forward<TVisitor>(visitor));
+}
+template<typename K, typename V, typename Config, typename Alloc, u32 ShardCount>
+template<typename TCreator, typename TVisitor>
+KUN_INLINE bool ConcurrentUMap<K, V, Config, Alloc, ShardCount>::findOrAddValueHashed(const KeyType& key, HashType hash, TCreator&& creator,
+                                                                                      TVisitor&& visitor)
+{
+    auto pair_creator = [&]() { return PairType(key, creator()); };
+    auto pair_visitor = [&](PairType& pair) { visitor(pair.value); };
+    return Super::findOrAddHashed(key, hash, pair_creator, pair_visitor);
+}
+
+// find value
+template<typename K, typename V, typename Config, typename Alloc, u32 ShardCount>
+KUN_INLINE bool ConcurrentUMap<K, V, Config, Alloc, ShardCount>::findValue(const KeyType& key, V& out) const
+{
+    return findValueHashed(key, HasherType()(key), out);
+}
+template<typename K, typename V, typename Config, typename Alloc, u32 ShardCount>
+KUN_INLINE bool ConcurrentUMap<K, V, Config, Alloc, ShardCount>::findValueHashed(const KeyType& key, HashType hash, V& out) const
+{
+    return Super::visitHashed(key, hash, [&](const PairType& pair) { out = pair.value; });
+}
+}// namespace kun
@@ -0,0 +1,364 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/std/types.hpp"
+#include "uset.hpp"
+#include "fwd.hpp"
+#include <mutex>
+#include <shared_mutex>
+
+// ConcurrentUSet def
+// thread safe hash set built from ShardCount independent USet, shard is selected by the high bits of mixed hash right below
+// the 4 bits used by bucket tag of USet, bucket of USet use the low bits of hash, so shard, bucket and tag never correlate
+// every shard has its own reader/writer lock and sits in its own cache line
+// element never leaves the lock, so lookups take a visitor that is invoked under shared lock instead of returning pointer
+// NOTE: visitor must not access the same container, or it may dead lock
+namespace kun
+{
+template<typename T, typename Config, typename Alloc, u32 ShardCount> class ConcurrentUSet
+{
+public:
+    using SetType = USet<T, Config, Alloc>;
+    using SizeType = typename SetType::SizeType;
+    static constexpr SizeType npos = (SizeType)::kun::npos;
+    using HashType = typename SetType::HashType;
+    using KeyType = typename SetType::KeyType;
+    using HasherType = typename SetType::HasherType;
+
+    static_assert(ShardCount > 0 && (ShardCount & (ShardCount - 1)) == 0, "shard count must be power of 2");
+
+    // ctor & dtor
+    ConcurrentUSet(Alloc alloc = Alloc());
+    ~ConcurrentUSet();
+
+    // not copyable & movable, shards are guarded by locks
+    ConcurrentUSet(const ConcurrentUSet& other) = delete;
+    ConcurrentUSet(ConcurrentUSet&& other) = delete;
+    ConcurrentUSet& operator=(const ConcurrentUSet& rhs) = delete;
+    ConcurrentUSet& operator=(ConcurrentUSet&& rhs) = delete;
+
+    // getter, only a snapshot when other threads are writing
+    SizeType size() const;
+    bool     empty() const;
+
+    // memory op
+    void clear();
+    void reserve(SizeType capacity);
+
+    // shard
+    static constexpr u32 shardCount();
+    u32                  shardIndex(HashType hash) const;
+
+    // add (add or assign), return true if key already exist
+    bool add(const T& v);
+    bool add(T&& v);
+    bool addHashed(const T& v, HashType hash);
+    bool addHashed(T&& v, HashType hash);
+
+    // try add (first check existence, then add, never assign), return true if key already exist
+    bool tryAdd(const T& v);
+    bool tryAdd(T&& v);
+    bool tryAddHashed(const T& v, HashType hash);
+    bool tryAddHashed(T&& v, HashType hash);
+
+    // find or add, key is hashed only once, lookup and add are done under unique lock, visitor may modify the element
+    // creator() is called only when key is missing and must return the T to add, visitor(T&) is called with the found or
+    // added element under unique lock, return true if key already exist
+    // use visit() for read only lookup, it only takes shared lock
+    template<typename TCreator, typename TVisitor> bool findOrAdd(const KeyType& key, TCreator&& creator, TVisitor&& visitor);
+    template<typename TCreator, typename TVisitor> bool findOrAddHashed(const KeyType& key, HashType hash, TCreator&& creator, TVisitor&& visitor);
+
+    // remove, return true if removed
+    bool remove(const KeyType& key);
+    bool removeHashed(const KeyType& key, HashType hash);
+
+    // visit, visitor(const T&) is called under shared lock if found, return true if found
+    template<typename TVisitor> bool visit(const KeyType& key, TVisitor&& visitor) const;
+    template<typename TVisitor> bool visitHashed(const KeyType& key, HashType hash, TVisitor&& visitor) const;
+
+    // contain
+    bool contain(const KeyType& key) const;
+    bool containHashed(const KeyType& key, HashType hash) const;
+
+    // foreach, lock shard by shard, func(const T&) never see a half written shard
+    template<typename TFunc> void forEach(TFunc&& func) const;
+
+protected:
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex lock;
+        SetType                   set;
+
+        KUN_INLINE explicit Shard(Alloc alloc)
+            : set(std::move(alloc))
+        {
+        }
+    };
+
+    // helpers
+    static constexpr u32 _shardBits();
+    const KeyType&       _keyOf(const T& v) const;
+    HashType             _hashOf(const T& v) const;
+    Shard&               _shardOf(HashType hash);
+    const Shard&         _shardOf(HashType hash) const;
+
+protected:
+    Shard*                      m_shards;
+    KUN_NO_UNIQUE_ADDRESS Alloc m_alloc;
+};
+}// namespace kun
+
+// ConcurrentUSet impl
+namespace kun
+{
+// helpers
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE constexpr u32 ConcurrentUSet<T, Config, Alloc, ShardCount>::_shardBits()
+{
+    u32 bits = 0;
+    while ((1u << bits) < ShardCount) { ++bits; }
+    return bits;
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+KUN_INLINE const typename ConcurrentUSet<T, Config, Alloc, ShardCount>::KeyType& ConcurrentUSet<T, Config, Alloc, ShardCount>::_keyOf(const T& v) const
+{
+    return typename Config::KeyMapperType()(v);
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+KUN_INLINE typename ConcurrentUSet<T, Config, Alloc, ShardCount>::HashType ConcurrentUSet<T, Config, Alloc, ShardCount>::_hashOf(const T& v) const
+{
+    return HasherType()(_keyOf(v));
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+KUN_INLINE typename ConcurrentUSet<T, Config, Alloc, ShardCount>::Shard& ConcurrentUSet<T, Config, Alloc, ShardCount>::_shardOf(HashType hash)
+{
+    return m_shards[shardIndex(hash)];
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+KUN_INLINE const typename ConcurrentUSet<T, Config, Alloc, ShardCount>::Shard& ConcurrentUSet<T, Config, Alloc, ShardCount>::_shardOf(HashType hash) const
+{
+    return m_shards[shardIndex(hash)];
+}
+
+// ctor & dtor
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+KUN_INLINE ConcurrentUSet<T, Config, Alloc, ShardCount>::ConcurrentUSet(Alloc alloc)
+    : m_shards(nullptr)
+    , m_alloc(std::move(alloc))
+{
+    m_shards = m_alloc.template alloc<Shard>(ShardCount);
+    for (u32 i = 0; i < ShardCount; ++i) { new (m_shards + i) Shard(m_alloc); }
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE ConcurrentUSet<T, Config, Alloc, ShardCount>::~ConcurrentUSet()
+{
+    memory::destructItem(m_shards, ShardCount);
+    m_alloc.free(m_shards);
+}
+
+// getter
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+KUN_INLINE typename ConcurrentUSet<T, Config, Alloc, ShardCount>::SizeType ConcurrentUSet<T, Config, Alloc, ShardCount>::size() const
+{
+    SizeType result = 0;
+    for (u32 i = 0; i < ShardCount; ++i)
+    {
+        std::shared_lock<std::shared_mutex> lock(m_shards[i].lock);
+        result += m_shards[i].set.size();
+    }
+    return result;
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::empty() const
+{
+    return size() == 0;
+}
+
+// memory op
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE void ConcurrentUSet<T, Config, Alloc, ShardCount>::clear()
+{
+    for (u32 i = 0; i < ShardCount; ++i)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_shards[i].lock);
+        m_shards[i].set.clear();
+    }
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE void ConcurrentUSet<T, Config, Alloc, ShardCount>::reserve(SizeType capacity)
+{
+    // hash spread evenly, give every shard a bit more than average
+    SizeType shard_capacity = capacity / ShardCount + capacity / ShardCount / 8 + 1;
+    for (u32 i = 0; i < ShardCount; ++i)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_shards[i].lock);
+        m_shards[i].set.reserve(shard_capacity);
+    }
+}
+
+// shard
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE constexpr u32 ConcurrentUSet<T, Config, Alloc, ShardCount>::shardCount()
+{
+    return ShardCount;
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE u32 ConcurrentUSet<T, Config, Alloc, ShardCount>::shardIndex(HashType hash) const
+{
+    if constexpr (ShardCount == 1)
+    {
+        return 0;
+    }
+    else
+    {
+        // fibonacci hashing, so identity hash still spread, the top 4 bits are taken by USet::_tagOf, use the bits below them
+        constexpr u32 shard_bits = _shardBits();
+        static_assert(shard_bits <= 60, "too many shards");
+        return (u32)((((u64)hash * 0x9E3779B97F4A7C15ull) >> (60 - shard_bits)) & (ShardCount - 1));
+    }
+}
+
+// add (add or assign)
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::add(const T& v)
+{
+    return addHashed(v, _hashOf(v));
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::add(T&& v)
+{
+    HashType hash = _hashOf(v);
+    return addHashed(std::move(v), hash);
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::addHashed(const T& v, HashType hash)
+{
+    Shard&                              shard = _shardOf(hash);
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    return shard.set.addHashed(v, hash).already_exist;
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::addHashed(T&& v, HashType hash)
+{
+    Shard&                              shard = _shardOf(hash);
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    return shard.set.addHashed(std::move(v), hash).already_exist;
+}
+
+// try add (first check existence, then add, never assign)
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::tryAdd(const T& v)
+{
+    return tryAddHashed(v, _hashOf(v));
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::tryAdd(T&& v)
+{
+    HashType hash = _hashOf(v);
+    return tryAddHashed(std::move(v), hash);
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::tryAddHashed(const T& v, HashType hash)
+{
+    Shard& shard = _shardOf(hash);
+
+    // most try add hit existing key, check it with shared lock first
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.lock);
+        if (shard.set.containHashed(_keyOf(v), hash))
+        {
+            return true;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    return shard.set.tryAddHashed(v, hash).already_exist;
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::tryAddHashed(T&& v, HashType hash)
+{
+    Shard& shard = _shardOf(hash);
+
+    // most try add hit existing key, check it with shared lock first
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.lock);
+        if (shard.set.containHashed(_keyOf(v), hash))
+        {
+            return true;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    return shard.set.tryAddHashed(std::move(v), hash).already_exist;
+}
+
+// find or add
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+template<typename TCreator, typename TVisitor>
+KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::findOrAdd(const KeyType& key, TCreator&& creator, TVisitor&& visitor)
+{
+    return findOrAddHashed(key, HasherType()(key), std::forward<TCreator>(creator), std::forward<TVisitor>(visitor));
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+template<typename TCreator, typename TVisitor>
+KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::findOrAddHashed(const KeyType& key, HashType hash, TCreator&& creator, TVisitor&& visitor)
+{
+    Shard& shard = _shardOf(hash);
+
+    // visitor may write the element, so never call it under shared lock
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    if (auto info = shard.set.findHashed(key, hash))
+    {
+        visitor(*info);
+        return true;
+    }
+    auto info = shard.set.emplaceAnywayHashed(hash, creator());
+    visitor(*info);
+    return false;
+}
+
+// remove
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::remove(const KeyType& key)
+{
+    return removeHashed(key, HasherType()(key));
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::removeHashed(const KeyType& key, HashType hash)
+{
+    Shard&                              shard = _shardOf(hash);
+    std::unique_lock<std::shared_mutex> lock(shard.lock);
+    return shard.set.removeHashed(key, hash) != npos;
+}
+
+// visit
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+template<typename TVisitor>
+KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::visit(const KeyType& key, TVisitor&& visitor) const
+{
+    return visitHashed(key, HasherType()(key), std::forward<TVisitor>(visitor));
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+template<typename TVisitor>
+KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::visitHashed(const KeyType& key, HashType hash, TVisitor&& visitor) const
+{
+    const Shard&                        shard = _shardOf(hash);
+    std::shared_lock<std::shared_mutex> lock(shard.lock);
+    if (auto info = shard.set.findHashed(key, hash))
+    {
+        visitor(*info);
+        return true;
+    }
+    return false;
+}
+
+// contain
+template<typename T, typename Config, typename Alloc, u32 ShardCount> KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::contain(const KeyType& key) const
+{
+    return containHashed(key, HasherType()(key));
+}
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+KUN_INLINE bool ConcurrentUSet<T, Config, Alloc, ShardCount>::containHashed(const KeyType& key, HashType hash) const
+{
+    const Shard&                        shard = _shardOf(hash);
+    std::shared_lock<std::shared_mutex> lock(shard.lock);
+    return shard.set.containHashed(key, hash);
+}
+
+// foreach
+template<typename T, typename Config, typename Alloc, u32 ShardCount>
+template<typename TFunc>
+KUN_INLINE void ConcurrentUSet<T, Config, Alloc, ShardCount>::forEach(TFunc&& func) const
+{
+    for (u32 i = 0; i < ShardCount; ++i)
+    {
+        std::shared_lock<std::shared_mutex> lock(m_shards[i].lock);
+        for (const T& v : m_shards[i].set) { func(v); }
+    }
+}
+}// namespace kun
@@ -0,0 +1,184 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/std/types.hpp"
+#include "kun/core/std/kstl/algo/functor.hpp"
+#include "kun/core/std/kstl/algo/eytzinger.hpp"
+#include "array.hpp"
+#include "fwd.hpp"
+
+// EytzingerIndex def
+// static search index of a sorted array, keep a copy of keys in eytzinger layout and the rank of each key
+// results are index in the sorted source, so it can be attached to a sorted Array (or FlatSet data) for repeated queries
+// the index is a snapshot, rebuild it after source changed
+namespace kun
+{
+template<typename T, typename Alloc> class EytzingerIndex
+{
+public:
+    using SizeType = typename Alloc::SizeType;
+    static constexpr SizeType npos = (SizeType)::kun::npos;
+
+    // ctor & dtor
+    EytzingerIndex(Alloc alloc = Alloc());
+    EytzingerIndex(const T* sorted, SizeType n, Alloc alloc = Alloc());
+    ~EytzingerIndex();
+
+    // copy & move
+    EytzingerIndex(const EytzingerIndex& other, Alloc alloc = Alloc());
+    EytzingerIndex(EytzingerIndex&& other);
+
+    // assign & move assign
+    EytzingerIndex& operator=(const EytzingerIndex& rhs);
+    EytzingerIndex& operator=(EytzingerIndex&& rhs);
+
+    // getter
+    SizeType        size() const;
+    bool            empty() const;
+    const T*        layout() const;// 1 based, layout()[0] is unused
+    const SizeType* ranks() const; // ranks()[0] is size()
+    Alloc&          allocator();
+    const Alloc&    allocator() const;
+
+    // build
+    void                                 build(const T* sorted, SizeType n);
+    template<typename TAlloc> void       attach(const Array<T, TAlloc>& sorted);
+    void                                 clear();
+    void                                 release();
+
+    // bound, return index in sorted source, size() if not found
+    template<typename TF, typename TP = Less<>> SizeType lowerBound(const TF& v, TP p = TP()) const;
+    template<typename TF, typename TP = Less<>> SizeType upperBound(const TF& v, TP p = TP()) const;
+
+    // find, return index in sorted source, npos if not found
+    template<typename TF, typename TP = Less<>> SizeType find(const TF& v, TP p = TP()) const;
+    template<typename TF, typename TP = Less<>> bool     contain(const TF& v, TP p = TP()) const;
+
+private:
+    Array<T, Alloc>        m_layout;
+    Array<SizeType, Alloc> m_ranks;
+};
+}// namespace kun
+
+// EytzingerIndex impl
+namespace kun
+{
+// ctor & dtor
+template<typename T, typename Alloc>
+KUN_INLINE EytzingerIndex<T, Alloc>::EytzingerIndex(Alloc alloc)
+    : m_layout(alloc)
+    , m_ranks(std::move(alloc))
+{
+}
+template<typename T, typename Alloc>
+KUN_INLINE EytzingerIndex<T, Alloc>::EytzingerIndex(const T* sorted, SizeType n, Alloc alloc)
+    : m_layout(alloc)
+    , m_ranks(std::move(alloc))
+{
+    build(sorted, n);
+}
+template<typename T, typename Alloc> KUN_INLINE EytzingerIndex<T, Alloc>::~EytzingerIndex() = default;
+
+// copy & move
+template<typename T, typename Alloc>
+KUN_INLINE EytzingerIndex<T, Alloc>::EytzingerIndex(const EytzingerIndex& other, Alloc alloc)
+    : m_layout(other.m_layout, alloc)
+    , m_ranks(other.m_ranks, std::move(alloc))
+{
+}
+template<typename T, typename Alloc>
+KUN_INLINE EytzingerIndex<T, Alloc>::EytzingerIndex(EytzingerIndex&& other)
+    : m_layout(std::move(other.m_layout))
+    , m_ranks(std::move(other.m_ranks))
+{
+}
+
+// assign & move assign
+template<typename T, typename Alloc> KUN_INLINE EytzingerIndex<T, Alloc>& EytzingerIndex<T, Alloc>::operator=(const EytzingerIndex& rhs)
+{
+    m_layout = rhs.m_layout;
+    m_ranks = rhs.m_ranks;
+    return *this;
+}
+template<typename T, typename Alloc> KUN_INLINE EytzingerIndex<T, Alloc>& EytzingerIndex<T, Alloc>::operator=(EytzingerIndex&& rhs)
+{
+    m_layout = std::move(rhs.m_layout);
+    m_ranks = std::move(rhs.m_ranks);
+    return *this;
+}
+
+// getter
+template<typename T, typename Alloc> KUN_INLINE typename EytzingerIndex<T, Alloc>::SizeType EytzingerIndex<T, Alloc>::size() const
+{
+    return m_ranks.size() ? m_ranks.size() - 1 : 0;
+}
+template<typename T, typename Alloc> KUN_INLINE bool     EytzingerIndex<T, Alloc>::empty() const { return size() == 0; }
+template<typename T, typename Alloc> KUN_INLINE const T* EytzingerIndex<T, Alloc>::layout() const { return m_layout.data(); }
+template<typename T, typename Alloc> KUN_INLINE const typename EytzingerIndex<T, Alloc>::SizeType* EytzingerIndex<T, Alloc>::ranks() const
+{
+    return m_ranks.data();
+}
+template<typename T, typename Alloc> KUN_INLINE Alloc&       EytzingerIndex<T, Alloc>::allocator() { return m_layout.allocator(); }
+template<typename T, typename Alloc> KUN_INLINE const Alloc& EytzingerIndex<T, Alloc>::allocator() const { return m_layout.allocator(); }
+
+// build
+template<typename T, typename Alloc> KUN_INLINE void EytzingerIndex<T, Alloc>::build(const T* sorted, SizeType n)
+{
+    clear();
+    if (n)
+    {
+        // slot 0 is unused, fill it with first key to keep every slot constructed
+        m_layout.resize(n + 1, sorted[0]);
+        m_ranks.resizeUnsafe(n + 1);
+        algo::eytzingerBuild(sorted, n, m_layout.data(), m_ranks.data());
+    }
+}
+template<typename T, typename Alloc> template<typename TAlloc> KUN_INLINE void EytzingerIndex<T, Alloc>::attach(const Array<T, TAlloc>& sorted)
+{
+    build(sorted.data(), (SizeType)sorted.size());
+}
+template<typename T, typename Alloc> KUN_INLINE void EytzingerIndex<T, Alloc>::clear()
+{
+    m_layout.clear();
+    m_ranks.clear();
+}
+template<typename T, typename Alloc> KUN_INLINE void EytzingerIndex<T, Alloc>::release()
+{
+    m_layout.release();
+    m_ranks.release();
+}
+
+// bound
+template<typename T, typename Alloc>
+template<typename TF, typename TP>
+KUN_INLINE typename EytzingerIndex<T, Alloc>::SizeType EytzingerIndex<T, Alloc>::lowerBound(const TF& v, TP p) const
+{
+    if (empty())
+        return 0;
+    return m_ranks[algo::eytzingerLowerBound(m_layout.data(), size(), v, p)];
+}
+template<typename T, typename Alloc>
+template<typename TF, typename TP>
+KUN_INLINE typename EytzingerIndex<T, Alloc>::SizeType EytzingerIndex<T, Alloc>::upperBound(const TF& v, TP p) const
+{
+    if (empty())
+        return 0;
+    return m_ranks[algo::eytzingerUpperBound(m_layout.data(), size(), v, p)];
+}
+
+// find
+template<typename T, typename Alloc>
+template<typename TF, typename TP>
+KUN_INLINE typename EytzingerIndex<T, Alloc>::SizeType EytzingerIndex<T, Alloc>::find(const TF& v, TP p) const
+{
+    if (empty())
+        return npos;
+    SizeType k = algo::eytzingerLowerBound(m_layout.data(), size(), v, p);
+    return (k && !p(v, m_layout[k])) ? m_ranks[k] : (SizeType)npos;
+}
+template<typename T, typename Alloc>
+template<typename TF, typename TP>
+KUN_INLINE bool EytzingerIndex<T, Alloc>::contain(const TF& v, TP p) const
+{
+    return find(v, p) != (SizeType)npos;
+}
+}// namespace kun
@@ -0,0 +1,161 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/std/types.hpp"
+#include "kun/core/std/kstl/kvpair.hpp"
+#include "flat_set.hpp"
+#include "fwd.hpp"
+
+// FlatMap config
+namespace kun
+{
+template<typename K, typename V, bool MultiKey> struct FlatMapConfigDefault
+{
+    using KeyType = K;
+    using KeyMapperType = MapKVPairKey<K, V>;
+    using ComparerType = Less<KeyType>;
+
+    static constexpr bool multi_key = MultiKey;
+};
+}// namespace kun
+
+// FlatMap def
+namespace kun
+{
+template<typename K, typename V, typename Config, typename Alloc> class FlatMap : public FlatSet<KVPair<K, V>, Config, Alloc>
+{
+    using Super = FlatSet<KVPair<K, V>, Config, Alloc>;
+
+public:
+    using PairType = KVPair<K, V>;
+    using typename Super::SizeType;
+    using typename Super::KeyType;
+    using typename Super::DataInfo;
+    using typename Super::CDataInfo;
+
+    // ctor & dtor
+    FlatMap(Alloc alloc = Alloc());
+    FlatMap(SizeType reserve_size, Alloc alloc = Alloc());
+    FlatMap(const PairType* p, SizeType n, Alloc alloc = Alloc());
+    FlatMap(std::initializer_list<PairType> init_list, Alloc alloc = Alloc());
+    ~FlatMap();
+
+    // copy & move
+    FlatMap(const FlatMap& other, Alloc alloc = Alloc());
+    FlatMap(FlatMap&& other);
+
+    // assign & move assign
+    FlatMap& operator=(const FlatMap& rhs);
+    FlatMap& operator=(FlatMap&& rhs);
+
+    // add (add or assign value)
+    using Super::add;
+    template<typename TK, typename TV> DataInfo add(TK&& key, TV&& value);
+
+    // try add (first check existence, then add, never assign)
+    using Super::tryAdd;
+    template<typename TK, typename TV> DataInfo tryAdd(TK&& key, TV&& value);
+
+    // find value
+    V*       findValue(const KeyType& key);
+    const V* findValue(const KeyType& key) const;
+};
+
+// relocatable as its allocator
+template<typename K, typename V, typename Config, typename Alloc> struct is_trivially_relocatable<FlatMap<K, V, Config, Alloc>> : is_trivially_relocatable<Alloc>
+{
+};
+}// namespace kun
+
+// FlatMap impl
+namespace kun
+{
+// ctor & dtor
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE FlatMap<K, V, Config, Alloc>::FlatMap(Alloc alloc)
+    : Super(std::move(alloc))
+{
+}
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE FlatMap<K, V, Config, Alloc>::FlatMap(SizeType reserve_size, Alloc alloc)
+    : Super(reserve_size, std::move(alloc))
+{
+}
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE FlatMap<K, V, Config, Alloc>::FlatMap(const PairType* p, SizeType n, Alloc alloc)
+    : Super(p, n, std::move(alloc))
+{
+}
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE FlatMap<K, V, Config, Alloc>::FlatMap(std::initializer_list<PairType> init_list, Alloc alloc)
+    : Super(init_list, std::move(alloc))
+{
+}
+template<typename K, typename V, typename Config, typename Alloc> KUN_INLINE FlatMap<K, V, Config, Alloc>::~FlatMap() = default;
+
+// copy & move
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE FlatMap<K, V, Config, Alloc>::FlatMap(const FlatMap& other, Alloc alloc)
+    : Super(other, std::move(alloc))
+{
+}
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE FlatMap<K, V, Config, Alloc>::FlatMap(FlatMap&& other)
+    : Super(std::move(other))
+{
+}
+
+// assign & move assign
+template<typename K, typename V, typename Config, typename Alloc> KUN_INLINE FlatMap<K, V, Config, Alloc>& FlatMap<K, V, Config, Alloc>::operator=(const FlatMap& rhs)
+{
+    Super::operator=(rhs);
+    return *this;
+}
+template<typename K, typename V, typename Config, typename Alloc> KUN_INLINE FlatMap<K, V, Config, Alloc>& FlatMap<K, V, Config, Alloc>::operator=(FlatMap&& rhs)
+{
+    Super::operator=(std::move(rhs));
+    return *this;
+}
+
+// add (add or assign value)
+template<typename K, typename V, typename Config, typename Alloc>
+template<typename TK, typename TV>
+KUN_INLINE typename FlatMap<K, V, Config, Alloc>::DataInfo FlatMap<K, V, Config, Alloc>::add(TK&& key, TV&& value)
+{
+    if constexpr (!Config::multi_key)
+    {
+        // assign value only, key is already equal
+        if (DataInfo info = Super::find(key))
+        {
+            info->value = std::forward<TV>(value);
+            info.already_exist = true;
+            return info;
+        }
+    }
+    return Super::add(PairType(std::forward<TK>(key), std::forward<TV>(value)));
+}
+
+// try add (first check existence, then add, never assign)
+template<typename K, typename V, typename Config, typename Alloc>
+template<typename TK, typename TV>
+KUN_INLINE typename FlatMap<K, V, Config, Alloc>::DataInfo FlatMap<K, V, Config, Alloc>::tryAdd(TK&& key, TV&& value)
+{
+    if (DataInfo info = Super::find(key))
+    {
+        info.already_exist = true;
+        return info;
+    }
+    return Super::add(PairType(std::forward<TK>(key), std::forward<TV>(value)));
+}
+
+// find value
+template<typename K, typename V, typename Config, typename Alloc> KUN_INLINE V* FlatMap<K, V, Config, Alloc>::findValue(const KeyType& key)
+{
+    DataInfo info = Super::find(key);
+    return info ? &info->value : nullptr;
+}
+template<typename K, typename V, typename Config, typename Alloc> KUN_INLINE const V* FlatMap<K, V, Config, Alloc>::findValue(const KeyType& key) const
+{
+    CDataInfo info = Super::find(key);
+    return info ? &info->value : nullptr;
+}
+}// namespace kun
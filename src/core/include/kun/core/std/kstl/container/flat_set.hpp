@@ -0,0 +1,613 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/std/types.hpp"
+#include "kun/core/std/kstl/algo/functor.hpp"
+#include "kun/core/std/kstl/algo/binarySearch.hpp"
+#include "kun/core/std/kstl/span.hpp"
+#include "array.hpp"
+#include "uset_iterator.hpp"
+#include "fwd.hpp"
+
+// FlatSet config
+namespace kun
+{
+template<typename T, bool MultiKey> struct FlatSetConfigDefault
+{
+    using KeyType = T;
+    using KeyMapperType = MapFwd<T>;
+    using ComparerType = Less<KeyType>;
+
+    static constexpr bool multi_key = MultiKey;
+};
+}// namespace kun
+
+// FlatSet def
+// sorted contiguous set on Array, no bucket and no per element hash/link, lookup is binary search over keys
+// suitable for read-mostly tables, single add/remove cost O(n) because of element movement, so batch them with
+// build() or append(), which sort the input once and merge it into the storage in O(n + m log m)
+// element with equal key keep insertion order in multi key mode
+namespace kun
+{
+template<typename T, typename Config, typename Alloc> class FlatSet
+{
+public:
+    using SizeType = typename Alloc::SizeType;
+    static constexpr SizeType npos = (SizeType)::kun::npos;
+    using KeyType = typename Config::KeyType;
+    using keyMapperType = typename Config::KeyMapperType;
+    using ComparerType = typename Config::ComparerType;
+    using DataArr = Array<T, Alloc>;
+    using DataInfo = USetDataInfo<T, SizeType>;
+    using CDataInfo = USetDataInfo<const T, SizeType>;
+
+    // ctor & dtor
+    FlatSet(Alloc alloc = Alloc());
+    FlatSet(SizeType reserve_size, Alloc alloc = Alloc());
+    FlatSet(const T* p, SizeType n, Alloc alloc = Alloc());
+    FlatSet(std::initializer_list<T> init_list, Alloc alloc = Alloc());
+    ~FlatSet();
+
+    // copy & move
+    FlatSet(const FlatSet& other, Alloc alloc = Alloc());
+    FlatSet(FlatSet&& other);
+
+    // assign & move assign
+    FlatSet& operator=(const FlatSet& rhs);
+    FlatSet& operator=(FlatSet&& rhs);
+
+    // compare
+    bool operator==(const FlatSet& rhs) const;
+    bool operator!=(const FlatSet& rhs) const;
+
+    // getter
+    SizeType       size() const;
+    SizeType       capacity() const;
+    SizeType       slack() const;
+    bool           empty() const;
+    const DataArr& data() const;
+    Alloc&         allocator();
+    const Alloc&   allocator() const;
+
+    // validate
+    bool isValidIndex(SizeType idx) const;
+    bool isValidPointer(const T* p) const;
+    bool isSorted() const;
+
+    // memory op
+    void clear();
+    void release(SizeType capacity = 0);
+    void reserve(SizeType capacity);
+    void shrink();
+
+    // data op
+    KeyType&       keyOf(T& v) const;
+    const KeyType& keyOf(const T& v) const;
+    bool           keyLess(const T& a, const T& b) const;
+    bool           keyEqual(const T& a, const T& b) const;
+
+    // build, replace content with items and sort them once, for equal keys the last one win (same as add one by one)
+    // build() without param sort and unique the data that modified through dataUnsafe()
+    void     build();
+    void     build(const T* p, SizeType n);
+    void     build(std::initializer_list<T> init_list);
+    DataArr& dataUnsafe();
+
+    // add (add or assign)
+    DataInfo add(const T& v);
+    DataInfo add(T&& v);
+
+    // try add (first check existence, then add, never assign)
+    DataInfo tryAdd(const T& v);
+    DataInfo tryAdd(T&& v);
+
+    // emplace
+    template<typename... Args> DataInfo emplace(Args&&... args);
+
+    // append, merge-based batch insert, items are sorted and merged into storage in O(n + m log m)
+    void append(const FlatSet& set);
+    void append(std::initializer_list<T> init_list);
+    void append(const T* p, SizeType n);
+
+    // remove
+    SizeType                       remove(const KeyType& key);
+    SizeType                       removeAll(const KeyType& key);// [multi set extend]
+    void                           removeAt(SizeType index, SizeType n = 1);
+    template<typename TP> SizeType removeIf(TP&& p);
+
+    // modify, must not change key
+    T&       operator[](SizeType index);
+    const T& operator[](SizeType index) const;
+
+    // bound, return index in [0, size()]
+    SizeType lowerBound(const KeyType& key) const;
+    SizeType upperBound(const KeyType& key) const;
+
+    // range, return items of key in [lower_key, upper_key)
+    Span<T>       equalRange(const KeyType& key);
+    Span<const T> equalRange(const KeyType& key) const;
+    Span<T>       range(const KeyType& lower_key, const KeyType& upper_key);
+    Span<const T> range(const KeyType& lower_key, const KeyType& upper_key) const;
+
+    // find
+    DataInfo  find(const KeyType& key);
+    CDataInfo find(const KeyType& key) const;
+
+    // contain
+    bool     contain(const KeyType& key) const;
+    SizeType count(const KeyType& key) const;// [multi set extend]
+
+    // support foreach
+    T*       begin();
+    T*       end();
+    const T* begin() const;
+    const T* end() const;
+
+private:
+    // helper
+    template<typename TV> DataInfo _add(TV&& v, bool assign);
+    template<typename TV> void     _insertAt(SizeType index, TV&& v);
+    SizeType                       _sortAndUnique(T* p, SizeType n);
+    void                           _mergeSorted(T* p, SizeType n);
+
+private:
+    DataArr m_data;
+};
+
+// relocatable as its allocator
+template<typename T, typename Config, typename Alloc> struct is_trivially_relocatable<FlatSet<T, Config, Alloc>> : is_trivially_relocatable<Alloc>
+{
+};
+}// namespace kun
+
+// FlatSet impl
+namespace kun
+{
+// helper
+template<typename T, typename Config, typename Alloc>
+template<typename TV>
+KUN_INLINE typename FlatSet<T, Config, Alloc>::DataInfo FlatSet<T, Config, Alloc>::_add(TV&& v, bool assign)
+{
+    if constexpr (Config::multi_key)
+    {
+        // equal keys keep insertion order
+        SizeType index = upperBound(keyOf(v));
+        _insertAt(index, std::forward<TV>(v));
+        return DataInfo(m_data.data() + index, index);
+    }
+    else
+    {
+        SizeType index = lowerBound(keyOf(v));
+        if (index < size() && !ComparerType()(keyOf(v), keyOf(m_data[index])))
+        {
+            if (assign)
+            {
+                m_data[index] = std::forward<TV>(v);
+            }
+            return DataInfo(m_data.data() + index, index, true);
+        }
+        _insertAt(index, std::forward<TV>(v));
+        return DataInfo(m_data.data() + index, index);
+    }
+}
+template<typename T, typename Config, typename Alloc>
+template<typename TV>
+KUN_INLINE void FlatSet<T, Config, Alloc>::_insertAt(SizeType index, TV&& v)
+{
+    if (index == size())
+    {
+        m_data.emplace(std::forward<TV>(v));
+    }
+    else
+    {
+        m_data.emplaceAt(index, std::forward<TV>(v));
+    }
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename FlatSet<T, Config, Alloc>::SizeType FlatSet<T, Config, Alloc>::_sortAndUnique(T* p, SizeType n)
+{
+    // stable sort keep input order of equal keys, so the last one of equal run is the last added
+    auto less = [this](const T& a, const T& b) { return keyLess(a, b); };
+    algo::mergeSort(p, p + n, less);
+
+    if constexpr (Config::multi_key)
+    {
+        return n;
+    }
+    else
+    {
+        SizeType write = 0;
+        for (SizeType read = 0; read < n; ++read)
+        {
+            // skip to the last one of equal run
+            while (read + 1 < n && !keyLess(p[read], p[read + 1])) { ++read; }
+            if (write != read)
+            {
+                p[write] = std::move(p[read]);
+            }
+            ++write;
+        }
+        return write;
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void FlatSet<T, Config, Alloc>::_mergeSorted(T* p, SizeType n)
+{
+    if (!n)
+        return;
+
+    SizeType old_size = size();
+
+    // assign existing keys and drop them from input, items before the first input key can be skipped
+    if constexpr (!Config::multi_key)
+    {
+        SizeType i = lowerBound(keyOf(p[0]));
+        SizeType write = 0;
+        for (SizeType j = 0; j < n; ++j)
+        {
+            while (i < old_size && keyLess(m_data[i], p[j])) { ++i; }
+            if (i < old_size && !keyLess(p[j], m_data[i]))
+            {
+                m_data[i] = std::move(p[j]);
+                ++i;
+            }
+            else
+            {
+                if (write != j)
+                {
+                    p[write] = std::move(p[j]);
+                }
+                ++write;
+            }
+        }
+        n = write;
+        if (!n)
+            return;
+    }
+
+    // merge from back, the tail part [old_size, old_size + n) is uninitialized, so it is constructed instead of assigned
+    // input item is placed after existing equal keys, merge stop when input is used up, remaining items are already in place
+    m_data.addUnsafe(n);
+    T*       data = m_data.data();
+    SizeType i = old_size;
+    SizeType j = n;
+    SizeType k = old_size + n;
+    while (j)
+    {
+        --k;
+        T* src = (i && keyLess(p[j - 1], data[i - 1])) ? data + (--i) : p + (--j);
+        if (k >= old_size)
+        {
+            new (data + k) T(std::move(*src));
+        }
+        else
+        {
+            data[k] = std::move(*src);
+        }
+    }
+}
+
+// ctor & dtor
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE FlatSet<T, Config, Alloc>::FlatSet(Alloc alloc)
+    : m_data(std::move(alloc))
+{
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE FlatSet<T, Config, Alloc>::FlatSet(SizeType reserve_size, Alloc alloc)
+    : m_data(std::move(alloc))
+{
+    reserve(reserve_size);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE FlatSet<T, Config, Alloc>::FlatSet(const T* p, SizeType n, Alloc alloc)
+    : m_data(std::move(alloc))
+{
+    build(p, n);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE FlatSet<T, Config, Alloc>::FlatSet(std::initializer_list<T> init_list, Alloc alloc)
+    : m_data(std::move(alloc))
+{
+    build(init_list);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE FlatSet<T, Config, Alloc>::~FlatSet() = default;
+
+// copy & move
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE FlatSet<T, Config, Alloc>::FlatSet(const FlatSet& other, Alloc alloc)
+    : m_data(other.m_data, std::move(alloc))
+{
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE FlatSet<T, Config, Alloc>::FlatSet(FlatSet&& other)
+    : m_data(std::move(other.m_data))
+{
+}
+
+// assign & move assign
+template<typename T, typename Config, typename Alloc> KUN_INLINE FlatSet<T, Config, Alloc>& FlatSet<T, Config, Alloc>::operator=(const FlatSet& rhs)
+{
+    m_data = rhs.m_data;
+    return *this;
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE FlatSet<T, Config, Alloc>& FlatSet<T, Config, Alloc>::operator=(FlatSet&& rhs)
+{
+    m_data = std::move(rhs.m_data);
+    return *this;
+}
+
+// compare
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool FlatSet<T, Config, Alloc>::operator==(const FlatSet& rhs) const
+{
+    return m_data == rhs.m_data;
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool FlatSet<T, Config, Alloc>::operator!=(const FlatSet& rhs) const
+{
+    return !(*this == rhs);
+}
+
+// getter
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename FlatSet<T, Config, Alloc>::SizeType FlatSet<T, Config, Alloc>::size() const
+{
+    return m_data.size();
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename FlatSet<T, Config, Alloc>::SizeType FlatSet<T, Config, Alloc>::capacity() const
+{
+    return m_data.capacity();
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename FlatSet<T, Config, Alloc>::SizeType FlatSet<T, Config, Alloc>::slack() const
+{
+    return m_data.slack();
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool FlatSet<T, Config, Alloc>::empty() const { return m_data.size() == 0; }
+template<typename T, typename Config, typename Alloc> KUN_INLINE const typename FlatSet<T, Config, Alloc>::DataArr& FlatSet<T, Config, Alloc>::data() const
+{
+    return m_data;
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE Alloc&       FlatSet<T, Config, Alloc>::allocator() { return m_data.allocator(); }
+template<typename T, typename Config, typename Alloc> KUN_INLINE const Alloc& FlatSet<T, Config, Alloc>::allocator() const { return m_data.allocator(); }
+
+// validate
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool FlatSet<T, Config, Alloc>::isValidIndex(SizeType idx) const
+{
+    return m_data.isValidIndex(idx);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool FlatSet<T, Config, Alloc>::isValidPointer(const T* p) const
+{
+    return m_data.isValidPointer(p);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool FlatSet<T, Config, Alloc>::isSorted() const
+{
+    for (SizeType i = 1; i < size(); ++i)
+    {
+        if (Config::multi_key ? keyLess(m_data[i], m_data[i - 1]) : !keyLess(m_data[i - 1], m_data[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// memory op
+template<typename T, typename Config, typename Alloc> KUN_INLINE void FlatSet<T, Config, Alloc>::clear() { m_data.clear(); }
+template<typename T, typename Config, typename Alloc> KUN_INLINE void FlatSet<T, Config, Alloc>::release(SizeType capacity) { m_data.release(capacity); }
+template<typename T, typename Config, typename Alloc> KUN_INLINE void FlatSet<T, Config, Alloc>::reserve(SizeType capacity) { m_data.reserve(capacity); }
+template<typename T, typename Config, typename Alloc> KUN_INLINE void FlatSet<T, Config, Alloc>::shrink() { m_data.shrink(); }
+
+// data op
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename FlatSet<T, Config, Alloc>::KeyType& FlatSet<T, Config, Alloc>::keyOf(T& v) const
+{
+    return keyMapperType()(v);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE const typename FlatSet<T, Config, Alloc>::KeyType& FlatSet<T, Config, Alloc>::keyOf(const T& v) const
+{
+    return keyMapperType()(v);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool FlatSet<T, Config, Alloc>::keyLess(const T& a, const T& b) const
+{
+    return ComparerType()(keyOf(a), keyOf(b));
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool FlatSet<T, Config, Alloc>::keyEqual(const T& a, const T& b) const
+{
+    return !keyLess(a, b) && !keyLess(b, a);
+}
+
+// build
+template<typename T, typename Config, typename Alloc> KUN_INLINE void FlatSet<T, Config, Alloc>::build()
+{
+    SizeType new_size = _sortAndUnique(m_data.data(), m_data.size());
+    if (new_size != m_data.size())
+    {
+        m_data.pop(m_data.size() - new_size);
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void FlatSet<T, Config, Alloc>::build(const T* p, SizeType n)
+{
+    m_data.assign(p, n);
+    build();
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void FlatSet<T, Config, Alloc>::build(std::initializer_list<T> init_list)
+{
+    m_data.assign(init_list);
+    build();
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename FlatSet<T, Config, Alloc>::DataArr& FlatSet<T, Config, Alloc>::dataUnsafe()
+{
+    return m_data;
+}
+
+// add (add or assign)
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename FlatSet<T, Config, Alloc>::DataInfo FlatSet<T, Config, Alloc>::add(const T& v)
+{
+    return _add(v, true);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename FlatSet<T, Config, Alloc>::DataInfo FlatSet<T, Config, Alloc>::add(T&& v)
+{
+    return _add(std::move(v), true);
+}
+
+// try add (first check existence, then add, never assign)
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename FlatSet<T, Config, Alloc>::DataInfo FlatSet<T, Config, Alloc>::tryAdd(const T& v)
+{
+    return _add(v, false);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename FlatSet<T, Config, Alloc>::DataInfo FlatSet<T, Config, Alloc>::tryAdd(T&& v)
+{
+    return _add(std::move(v), false);
+}
+
+// emplace
+template<typename T, typename Config, typename Alloc>
+template<typename... Args>
+KUN_INLINE typename FlatSet<T, Config, Alloc>::DataInfo FlatSet<T, Config, Alloc>::emplace(Args&&... args)
+{
+    return _add(T(std::forward<Args>(args)...), true);
+}
+
+// append
+template<typename T, typename Config, typename Alloc> KUN_INLINE void FlatSet<T, Config, Alloc>::append(const FlatSet& set)
+{
+    // already sorted and unique, only need merge
+    if (set.empty())
+        return;
+    DataArr items(set.m_data, m_data.allocator());
+    _mergeSorted(items.data(), items.size());
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void FlatSet<T, Config, Alloc>::append(std::initializer_list<T> init_list)
+{
+    append(init_list.begin(), (SizeType)init_list.size());
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void FlatSet<T, Config, Alloc>::append(const T* p, SizeType n)
+{
+    if (!n)
+        return;
+    if (empty())
+    {
+        build(p, n);
+        return;
+    }
+
+    DataArr items(p, n, m_data.allocator());
+    _mergeSorted(items.data(), _sortAndUnique(items.data(), items.size()));
+}
+
+// remove
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename FlatSet<T, Config, Alloc>::SizeType FlatSet<T, Config, Alloc>::remove(const KeyType& key)
+{
+    SizeType index = lowerBound(key);
+    if (index < size() && !ComparerType()(key, keyOf(m_data[index])))
+    {
+        m_data.removeAt(index);
+        return 1;
+    }
+    return 0;
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename FlatSet<T, Config, Alloc>::SizeType FlatSet<T, Config, Alloc>::removeAll(const KeyType& key)
+{
+    SizeType begin = lowerBound(key);
+    SizeType end = upperBound(key);
+    if (end > begin)
+    {
+        m_data.removeAt(begin, end - begin);
+    }
+    return end - begin;
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void FlatSet<T, Config, Alloc>::removeAt(SizeType index, SizeType n)
+{
+    m_data.removeAt(index, n);
+}
+template<typename T, typename Config, typename Alloc>
+template<typename TP>
+KUN_INLINE typename FlatSet<T, Config, Alloc>::SizeType FlatSet<T, Config, Alloc>::removeIf(TP&& p)
+{
+    // remove keep the order of remaining items
+    return m_data.removeAllIf(std::forward<TP>(p));
+}
+
+// modify
+template<typename T, typename Config, typename Alloc> KUN_INLINE T& FlatSet<T, Config, Alloc>::operator[](SizeType index) { return m_data[index]; }
+template<typename T, typename Config, typename Alloc> KUN_INLINE const T& FlatSet<T, Config, Alloc>::operator[](SizeType index) const
+{
+    return m_data[index];
+}
+
+// bound
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename FlatSet<T, Config, Alloc>::SizeType FlatSet<T, Config, Alloc>::lowerBound(const KeyType& key) const
+{
+    auto pred = [this](const T& v, const KeyType& k) { return ComparerType()(keyOf(v), k); };
+    return (SizeType)(algo::lowerBoundBranchless(begin(), end(), key, pred) - begin());
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename FlatSet<T, Config, Alloc>::SizeType FlatSet<T, Config, Alloc>::upperBound(const KeyType& key) const
+{
+    auto pred = [this](const KeyType& k, const T& v) { return ComparerType()(k, keyOf(v)); };
+    return (SizeType)(algo::upperBoundBranchless(begin(), end(), key, pred) - begin());
+}
+
+// range
+template<typename T, typename Config, typename Alloc> KUN_INLINE Span<T> FlatSet<T, Config, Alloc>::equalRange(const KeyType& key)
+{
+    SizeType lower = lowerBound(key);
+    SizeType upper = upperBound(key);
+    return upper > lower ? Span<T>(m_data.data() + lower, upper - lower) : Span<T>();
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE Span<const T> FlatSet<T, Config, Alloc>::equalRange(const KeyType& key) const
+{
+    SizeType lower = lowerBound(key);
+    SizeType upper = upperBound(key);
+    return upper > lower ? Span<const T>(m_data.data() + lower, upper - lower) : Span<const T>();
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE Span<T> FlatSet<T, Config, Alloc>::range(const KeyType& lower_key, const KeyType& upper_key)
+{
+    SizeType lower = lowerBound(lower_key);
+    SizeType upper = lowerBound(upper_key);
+    return upper > lower ? Span<T>(m_data.data() + lower, upper - lower) : Span<T>();
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE Span<const T> FlatSet<T, Config, Alloc>::range(const KeyType& lower_key, const KeyType& upper_key) const
+{
+    SizeType lower = lowerBound(lower_key);
+    SizeType upper = lowerBound(upper_key);
+    return upper > lower ? Span<const T>(m_data.data() + lower, upper - lower) : Span<const T>();
+}
+
+// find
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename FlatSet<T, Config, Alloc>::DataInfo FlatSet<T, Config, Alloc>::find(const KeyType& key)
+{
+    SizeType index = lowerBound(key);
+    if (index < size() && !ComparerType()(key, keyOf(m_data[index])))
+    {
+        return DataInfo(m_data.data() + index, index);
+    }
+    return DataInfo();
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename FlatSet<T, Config, Alloc>::CDataInfo FlatSet<T, Config, Alloc>::find(const KeyType& key) const
+{
+    SizeType index = lowerBound(key);
+    if (index < size() && !ComparerType()(key, keyOf(m_data[index])))
+    {
+        return CDataInfo(m_data.data() + index, index);
+    }
+    return CDataInfo();
+}
+
+// contain
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool FlatSet<T, Config, Alloc>::contain(const KeyType& key) const { return (bool)find(key); }
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename FlatSet<T, Config, Alloc>::SizeType FlatSet<T, Config, Alloc>::count(const KeyType& key) const
+{
+    return upperBound(key) - lowerBound(key);
+}
+
+// support foreach
+template<typename T, typename Config, typename Alloc> KUN_INLINE T*       FlatSet<T, Config, Alloc>::begin() { return m_data.begin(); }
+template<typename T, typename Config, typename Alloc> KUN_INLINE T*       FlatSet<T, Config, Alloc>::end() { return m_data.end(); }
+template<typename T, typename Config, typename Alloc> KUN_INLINE const T* FlatSet<T, Config, Alloc>::begin() const { return m_data.begin(); }
+template<typename T, typename Config, typename Alloc> KUN_INLINE const T* FlatSet<T, Config, Alloc>::end() const { return m_data.end(); }
+}// namespace kun
@@ -1,10 +1,22 @@
 #pragma once
+#include "kun/core/std/types.hpp"
 
 // allocator
 namespace kun
 {
-class PmrAllocator;
+struct GrowPolicyDefault;
+template<typename TDerived, typename TS, typename GrowPolicy = GrowPolicyDefault> class AllocTemplate;
+
+template<typename TS = Size> class BasicPmrAllocator;
+using PmrAllocator = BasicPmrAllocator<Size>;
+using PmrAllocator32 = BasicPmrAllocator<u32>;// u32 index, see BasicPmrAllocator
 using DefaultAllocator = PmrAllocator;
+template<typename T, Size N, typename Fallback = DefaultAllocator> class InlineAllocator;
+template<typename Resource, typename TS = Size, typename GrowPolicy = GrowPolicyDefault> class StaticAllocator;
+template<typename GrowPolicy, typename Base = DefaultAllocator> class GrowPolicyAllocator;
+struct MiStaticResource;
+using MiAllocator = StaticAllocator<MiStaticResource>;
+using MiAllocator32 = StaticAllocator<MiStaticResource, u32>;
 }// namespace kun
 
 // containers
@@ -12,9 +24,34 @@ namespace kun
 {
 template<typename Alloc = DefaultAllocator> class BitArray;
 template<typename T, typename Alloc = DefaultAllocator> class Array;
-template<typename T, typename Alloc = DefaultAllocator> class SparseArray;
+template<typename T, Size N, typename Fallback = DefaultAllocator> using InlineArray = Array<T, InlineAllocator<T, N, Fallback>>;
+struct SparseArrayStorageDefault;
+struct SparseArrayStorageCompact;
+template<typename T, typename TS, bool DoubleLink = true> union SparseArrayData;
+template<typename T, typename TS, bool Const, bool DoubleLink = true> class SparseArrayIt;
+template<typename T, typename Alloc = DefaultAllocator, typename Storage = SparseArrayStorageDefault> class SparseArray;
+template<typename T, typename Alloc = DefaultAllocator> using CompactSparseArray = SparseArray<T, Alloc, SparseArrayStorageCompact>;
+template<typename T, typename Alloc = DefaultAllocator> class EytzingerIndex;
+struct SlotHandle;
+template<typename T, typename Alloc = DefaultAllocator> class SlotMap;
 
 template<typename T, bool MultiKey = false> struct USetConfigDefault;
 template<typename T, typename Config = USetConfigDefault<T>, typename Alloc = DefaultAllocator> class USet;
 
+template<typename K, typename V, bool MultiKey = false> struct UMapConfigDefault;
+template<typename K, typename V, typename Config = UMapConfigDefault<K, V>, typename Alloc = DefaultAllocator> class UMap;
+
+template<typename T, typename Config = USetConfigDefault<T>, typename Alloc = DefaultAllocator> class SwissUSet;
+template<typename T, typename Config = USetConfigDefault<T>, typename Alloc = DefaultAllocator> class RobinUSet;
+
+template<typename T, bool MultiKey = false> struct FlatSetConfigDefault;
+template<typename T, typename Config = FlatSetConfigDefault<T>, typename Alloc = DefaultAllocator> class FlatSet;
+
+template<typename K, typename V, bool MultiKey = false> struct FlatMapConfigDefault;
+template<typename K, typename V, typename Config = FlatMapConfigDefault<K, V>, typename Alloc = DefaultAllocator> class FlatMap;
+
+template<typename T, typename Config = USetConfigDefault<T>, typename Alloc = DefaultAllocator, u32 ShardCount = 16> class ConcurrentUSet;
+template<typename K, typename V, typename Config = UMapConfigDefault<K, V>, typename Alloc = DefaultAllocator, u32 ShardCount = 16>
+class ConcurrentUMap;
+
 }// namespace kun
\ No newline at end of file
@@ -0,0 +1,880 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/std/types.hpp"
+#include "kun/core/std/kstl/algo/functor.hpp"
+#include "kun/core/memory/memory.h"
+#include "kun/core/memory/copy_move_policy.hpp"
+#include "kun/core/std/kstl/span.hpp"
+#include "robin_uset_iterator.hpp"
+#include "fwd.hpp"
+
+// RobinUSet def
+// open addressing hash set with robin hood linear probing, use the same config as USet, but multi key is not supported
+// layout: [slots: capacity * T][dist: capacity * u8], dist is probe length + 1 of the slot, 0 means empty
+// items in a cluster are kept sorted by home slot, so lookup stops once it meets a slot closer to home than itself, and
+// remove shift the following items back instead of leave tombstone, probe length stay short even at 0.9 load factor
+namespace kun
+{
+template<typename T, typename Config, typename Alloc> class RobinUSet
+{
+public:
+    using SizeType = typename Alloc::SizeType;
+    static constexpr SizeType npos = (SizeType)::kun::npos;
+    using HashType = typename Config::HashType;
+    using KeyType = typename Config::KeyType;
+    using keyMapperType = typename Config::KeyMapperType;
+    using HasherType = typename Config::HasherType;
+    using ComparerType = typename Config::ComparerType;
+    using DataInfo = USetDataInfo<T, SizeType>;
+    using CDataInfo = USetDataInfo<const T, SizeType>;
+    using It = RobinUSetIt<T, SizeType, false>;
+    using CIt = RobinUSetIt<T, SizeType, true>;
+
+    static_assert(!Config::multi_key, "RobinUSet not support multi key");
+    static_assert(!Alloc::has_inline_storage, "RobinUSet not support inline allocator");
+
+    // ctor & dtor
+    RobinUSet(Alloc alloc = Alloc());
+    RobinUSet(SizeType reserve_size, Alloc alloc = Alloc());
+    RobinUSet(const T* p, SizeType n, Alloc alloc = Alloc());
+    RobinUSet(std::initializer_list<T> init_list, Alloc alloc = Alloc());
+    ~RobinUSet();
+
+    // copy & move
+    RobinUSet(const RobinUSet& other, Alloc alloc = Alloc());
+    RobinUSet(RobinUSet&& other);
+
+    // assign & move assign
+    RobinUSet& operator=(const RobinUSet& rhs);
+    RobinUSet& operator=(RobinUSet&& rhs);
+
+    // compare
+    bool operator==(const RobinUSet& rhs) const;
+    bool operator!=(const RobinUSet& rhs) const;
+
+    // getter
+    SizeType     size() const;
+    SizeType     capacity() const;
+    SizeType     slack() const;
+    SizeType     growthLeft() const;
+    bool         empty() const;
+    const u8*    dist() const;
+    Alloc&       allocator();
+    const Alloc& allocator() const;
+
+    // probe statistics, for tuning hasher & capacity
+    // histogram[i] count items with probe length i (0 means at home slot), longer probes are counted into the last one
+    f32      loadFactor() const;
+    SizeType maxProbeLength() const;
+    void     probeHistogram(Span<SizeType> histogram) const;
+
+    // validate
+    bool hasData(SizeType idx) const;
+    bool isValidIndex(SizeType idx) const;
+
+    // memory op
+    void clear();
+    void release(SizeType capacity = 0);
+    void reserve(SizeType capacity);
+    void shrink();
+
+    // data op
+    KeyType&       keyOf(T& v) const;
+    const KeyType& keyOf(const T& v) const;
+    bool           keyEqual(const T& a, const T& b) const;
+    HashType       hashOf(const T& v) const;
+
+    // rehash, rebuild all probe sequences
+    void rehash();
+
+    // add (add or assign)
+    DataInfo add(const T& v);
+    DataInfo add(T&& v);
+    DataInfo addHashed(const T& v, HashType hash);
+    DataInfo addHashed(T&& v, HashType hash);
+
+    // try add (first check existence, then add, never assign)
+    DataInfo tryAdd(const T& v);
+    DataInfo tryAdd(T&& v);
+    DataInfo tryAddHashed(const T& v, HashType hash);
+    DataInfo tryAddHashed(T&& v, HashType hash);
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
+    DataInfo tryAddAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer());
+
+    // emplace
+    template<typename... Args> DataInfo emplace(Args&&... args);
+    template<typename... Args> DataInfo emplaceHashed(HashType hash, Args&&... args);
+
+    // append
+    void append(const RobinUSet& set);
+    void append(std::initializer_list<T> init_list);
+    void append(const T* p, SizeType n);
+
+    // remove
+    SizeType remove(const KeyType& key);
+    SizeType removeHashed(const KeyType& key, HashType hash);
+    void     removeAt(SizeType index);
+
+    // remove as
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
+    SizeType removeAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer());
+
+    // modify
+    T&       operator[](SizeType index);
+    const T& operator[](SizeType index) const;
+
+    // find
+    DataInfo  find(const KeyType& key);
+    CDataInfo find(const KeyType& key) const;
+    DataInfo  findHashed(const KeyType& key, HashType hash);
+    CDataInfo findHashed(const KeyType& key, HashType hash) const;
+
+    // find as
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
+    DataInfo findAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer());
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
+    CDataInfo findAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer()) const;
+
+    // contain
+    bool contain(const KeyType& key) const;
+    bool containHashed(const KeyType& key, HashType hash) const;
+
+    // contain as
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
+    bool containAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer()) const;
+
+    // support foreach
+    It  begin();
+    It  end();
+    CIt begin() const;
+    CIt end() const;
+
+    // max load factor 0.9, probe length never exceed max_dist - 1
+    static constexpr SizeType min_capacity = 8;
+    static constexpr u8       max_dist = 255;
+
+private:
+    // helpers
+    static SizeType _maxLoad(SizeType capacity);
+    static SizeType _calcCapacity(SizeType size);
+    SizeType        _homeOf(HashType hash) const;
+    template<typename TPred> SizeType _findIndex(HashType hash, TPred&& pred) const;
+    SizeType                          _shiftInsert(HashType hash);
+    SizeType                          _prepareInsert(HashType hash);
+    void                              _alloc(SizeType capacity);
+    void                              _free();
+    void                              _resize(SizeType new_capacity);
+
+private:
+    T*                          m_slots;
+    u8*                         m_dist;
+    SizeType                    m_size;
+    SizeType                    m_capacity;
+    KUN_NO_UNIQUE_ADDRESS Alloc m_alloc;
+};
+
+// relocatable as its allocator
+template<typename T, typename Config, typename Alloc> struct is_trivially_relocatable<RobinUSet<T, Config, Alloc>> : is_trivially_relocatable<Alloc>
+{
+};
+}// namespace kun
+
+// RobinUSet impl
+namespace kun
+{
+// helpers
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::_maxLoad(SizeType capacity)
+{
+    // max load factor 9/10
+    return capacity - capacity / 10;
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::_calcCapacity(SizeType size)
+{
+    if (size)
+    {
+        SizeType result = min_capacity;
+        while (_maxLoad(result) < size) { result <<= 1; }
+        return result;
+    }
+    else
+    {
+        return 0;
+    }
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::_homeOf(HashType hash) const
+{
+    // user hash may be identity (e.g. integer), spread it before mask
+    u64 result = (u64)hash * 0x9E3779B97F4A7C15ull;
+    return (SizeType)(result ^ (result >> 32)) & (m_capacity - 1);
+}
+template<typename T, typename Config, typename Alloc>
+template<typename TPred>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::_findIndex(HashType hash, TPred&& pred) const
+{
+    if (m_size)
+    {
+        SizeType mask = m_capacity - 1;
+        SizeType index = _homeOf(hash);
+
+        // empty slot (dist 0) or a richer item means the key can't be further
+        for (u32 dist = 1; m_dist[index] >= dist; ++dist)
+        {
+            if (m_dist[index] == dist && pred(keyOf(m_slots[index])))
+            {
+                return index;
+            }
+            index = (index + 1) & mask;
+        }
+    }
+    return npos;
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::_shiftInsert(HashType hash)
+{
+    KUN_Assert(m_capacity > m_size);
+
+    SizeType mask = m_capacity - 1;
+
+    // find insert position, the first item closer to home than new item
+    SizeType index = _homeOf(hash);
+    u32      dist = 1;
+    while (m_dist[index] >= dist)
+    {
+        index = (index + 1) & mask;
+        ++dist;
+    }
+    if (dist > max_dist)
+    {
+        return npos;
+    }
+
+    // find cluster end, every item in [index, end) will move forward one slot
+    SizeType end = index;
+    while (m_dist[end])
+    {
+        if (m_dist[end] == max_dist)
+        {
+            return npos;
+        }
+        end = (end + 1) & mask;
+    }
+
+    // shift items, it's the same as swap along the probe but move every item only once
+    while (end != index)
+    {
+        SizeType prev = (end - 1) & mask;
+        new (m_slots + end) T(std::move(m_slots[prev]));
+        memory::destructItem(m_slots + prev, 1);
+        m_dist[end] = m_dist[prev] + 1;
+        end = prev;
+    }
+    m_dist[index] = (u8)dist;
+    return index;
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::_prepareInsert(HashType hash)
+{
+    if (m_size + 1 > _maxLoad(m_capacity))
+    {
+        _resize(_calcCapacity(m_size + 1));
+    }
+
+    // probe too long, the only way to shorten it is grow
+    SizeType index;
+    while ((index = _shiftInsert(hash)) == npos) { _resize(m_capacity << 1); }
+
+    ++m_size;
+    return index;
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void RobinUSet<T, Config, Alloc>::_alloc(SizeType capacity)
+{
+    KUN_Assert(capacity >= min_capacity && (capacity & (capacity - 1)) == 0);
+
+    m_slots = (T*)m_alloc.allocRaw(capacity * sizeof(T) + capacity, alignof(T));
+    m_dist = reinterpret_cast<u8*>(m_slots + capacity);
+    m_capacity = capacity;
+    memory::memset(m_dist, 0, capacity);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void RobinUSet<T, Config, Alloc>::_free()
+{
+    if (m_slots)
+    {
+        m_alloc.free(m_slots);
+        m_slots = nullptr;
+        m_dist = nullptr;
+        m_capacity = 0;
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void RobinUSet<T, Config, Alloc>::_resize(SizeType new_capacity)
+{
+    KUN_Assert(_maxLoad(new_capacity) >= m_size);
+
+    T*       old_slots = m_slots;
+    u8*      old_dist = m_dist;
+    SizeType old_capacity = m_capacity;
+
+    // alloc new memory
+    if (new_capacity)
+    {
+        _alloc(new_capacity);
+    }
+    else
+    {
+        m_slots = nullptr;
+        m_dist = nullptr;
+        m_capacity = 0;
+    }
+
+    // move items
+    if (old_slots)
+    {
+        for (SizeType i = 0; i < old_capacity; ++i)
+        {
+            if (old_dist[i])
+            {
+                SizeType index = _shiftInsert(hashOf(old_slots[i]));
+                KUN_Assert(index != npos && "probe length overflow, hasher is too bad");
+                new (m_slots + index) T(std::move(old_slots[i]));
+                memory::destructItem(old_slots + i, 1);
+            }
+        }
+        m_alloc.free(old_slots);
+    }
+}
+
+// ctor & dtor
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE RobinUSet<T, Config, Alloc>::RobinUSet(Alloc alloc)
+    : m_slots(nullptr)
+    , m_dist(nullptr)
+    , m_size(0)
+    , m_capacity(0)
+    , m_alloc(std::move(alloc))
+{
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE RobinUSet<T, Config, Alloc>::RobinUSet(SizeType reserve_size, Alloc alloc)
+    : RobinUSet(std::move(alloc))
+{
+    reserve(reserve_size);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE RobinUSet<T, Config, Alloc>::RobinUSet(const T* p, SizeType n, Alloc alloc)
+    : RobinUSet(std::move(alloc))
+{
+    append(p, n);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE RobinUSet<T, Config, Alloc>::RobinUSet(std::initializer_list<T> init_list, Alloc alloc)
+    : RobinUSet(std::move(alloc))
+{
+    append(init_list);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE RobinUSet<T, Config, Alloc>::~RobinUSet() { release(); }
+
+// copy & move
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE RobinUSet<T, Config, Alloc>::RobinUSet(const RobinUSet& other, Alloc alloc)
+    : RobinUSet(std::move(alloc))
+{
+    *this = other;
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE RobinUSet<T, Config, Alloc>::RobinUSet(RobinUSet&& other)
+    : m_slots(other.m_slots)
+    , m_dist(other.m_dist)
+    , m_size(other.m_size)
+    , m_capacity(other.m_capacity)
+    , m_alloc(std::move(other.m_alloc))
+{
+    other.m_slots = nullptr;
+    other.m_dist = nullptr;
+    other.m_size = 0;
+    other.m_capacity = 0;
+}
+
+// assign & move assign
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE RobinUSet<T, Config, Alloc>& RobinUSet<T, Config, Alloc>::operator=(const RobinUSet& rhs)
+{
+    if (this != &rhs)
+    {
+        // clear
+        clear();
+
+        if (!rhs.empty())
+        {
+            // realloc memory
+            if (m_capacity != rhs.m_capacity)
+            {
+                _free();
+                _alloc(rhs.m_capacity);
+            }
+
+            // copy dist, the probe sequence is only decided by capacity, so layout can be reused
+            memory::memcpy(m_dist, rhs.m_dist, m_capacity);
+            for (SizeType i = 0; i < m_capacity; ++i)
+            {
+                if (m_dist[i])
+                {
+                    new (m_slots + i) T(rhs.m_slots[i]);
+                }
+            }
+            m_size = rhs.m_size;
+        }
+    }
+    return *this;
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE RobinUSet<T, Config, Alloc>& RobinUSet<T, Config, Alloc>::operator=(RobinUSet&& rhs)
+{
+    if (this != &rhs)
+    {
+        // release
+        release();
+
+        // move data
+        m_slots = rhs.m_slots;
+        m_dist = rhs.m_dist;
+        m_size = rhs.m_size;
+        m_capacity = rhs.m_capacity;
+        m_alloc = std::move(rhs.m_alloc);
+
+        // clean up rhs
+        rhs.m_slots = nullptr;
+        rhs.m_dist = nullptr;
+        rhs.m_size = 0;
+        rhs.m_capacity = 0;
+    }
+    return *this;
+}
+
+// compare
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool RobinUSet<T, Config, Alloc>::operator==(const RobinUSet& rhs) const
+{
+    if (size() == rhs.size())
+    {
+        for (const auto& v : rhs)
+        {
+            if (!contain(keyOf(v)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool RobinUSet<T, Config, Alloc>::operator!=(const RobinUSet& rhs) const
+{
+    return !(*this == rhs);
+}
+
+// getter
+template<typename T, typename Config, typename Alloc> typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::size() const
+{
+    return m_size;
+}
+template<typename T, typename Config, typename Alloc> typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::capacity() const
+{
+    return m_capacity;
+}
+template<typename T, typename Config, typename Alloc> typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::slack() const
+{
+    return m_capacity - m_size;
+}
+template<typename T, typename Config, typename Alloc> typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::growthLeft() const
+{
+    return _maxLoad(m_capacity) - m_size;
+}
+template<typename T, typename Config, typename Alloc> bool         RobinUSet<T, Config, Alloc>::empty() const { return m_size == 0; }
+template<typename T, typename Config, typename Alloc> const u8*    RobinUSet<T, Config, Alloc>::dist() const { return m_dist; }
+template<typename T, typename Config, typename Alloc> Alloc&       RobinUSet<T, Config, Alloc>::allocator() { return m_alloc; }
+template<typename T, typename Config, typename Alloc> const Alloc& RobinUSet<T, Config, Alloc>::allocator() const { return m_alloc; }
+
+// probe statistics
+template<typename T, typename Config, typename Alloc> KUN_INLINE f32 RobinUSet<T, Config, Alloc>::loadFactor() const
+{
+    return m_capacity ? (f32)m_size / (f32)m_capacity : 0.f;
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::maxProbeLength() const
+{
+    u8 result = 0;
+    for (SizeType i = 0; i < m_capacity; ++i) { result = m_dist[i] > result ? m_dist[i] : result; }
+    return result ? result - 1 : 0;
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void RobinUSet<T, Config, Alloc>::probeHistogram(Span<SizeType> histogram) const
+{
+    if (histogram.empty())
+    {
+        return;
+    }
+
+    SizeType last = (SizeType)histogram.size() - 1;
+    for (SizeType i = 0; i <= last; ++i) { histogram.data()[i] = 0; }
+    for (SizeType i = 0; i < m_capacity; ++i)
+    {
+        if (m_dist[i])
+        {
+            SizeType probe_length = m_dist[i] - 1;
+            ++histogram.data()[probe_length < last ? probe_length : last];
+        }
+    }
+}
+
+// validate
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool RobinUSet<T, Config, Alloc>::hasData(SizeType idx) const
+{
+    return isValidIndex(idx) && m_dist[idx] != 0;
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool RobinUSet<T, Config, Alloc>::isValidIndex(SizeType idx) const
+{
+    return idx < m_capacity;
+}
+
+// memory op
+template<typename T, typename Config, typename Alloc> KUN_INLINE void RobinUSet<T, Config, Alloc>::clear()
+{
+    if (m_size)
+    {
+        for (SizeType i = 0; i < m_capacity; ++i)
+        {
+            if (m_dist[i])
+            {
+                memory::destructItem(m_slots + i, 1);
+            }
+        }
+        memory::memset(m_dist, 0, m_capacity);
+        m_size = 0;
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void RobinUSet<T, Config, Alloc>::release(SizeType capacity)
+{
+    clear();
+    _free();
+    if (capacity)
+    {
+        _alloc(_calcCapacity(capacity));
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void RobinUSet<T, Config, Alloc>::reserve(SizeType capacity)
+{
+    if (capacity > _maxLoad(m_capacity))
+    {
+        _resize(_calcCapacity(capacity));
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void RobinUSet<T, Config, Alloc>::shrink()
+{
+    SizeType new_capacity = _calcCapacity(m_size);
+    if (new_capacity < m_capacity)
+    {
+        _resize(new_capacity);
+    }
+}
+
+// data op
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename RobinUSet<T, Config, Alloc>::KeyType& RobinUSet<T, Config, Alloc>::keyOf(T& v) const
+{
+    return keyMapperType()(v);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE const typename RobinUSet<T, Config, Alloc>::KeyType& RobinUSet<T, Config, Alloc>::keyOf(const T& v) const
+{
+    return keyMapperType()(v);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool RobinUSet<T, Config, Alloc>::keyEqual(const T& a, const T& b) const
+{
+    return ComparerType()(keyOf(a), keyOf(b));
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::HashType RobinUSet<T, Config, Alloc>::hashOf(const T& v) const
+{
+    return HasherType()(keyOf(v));
+}
+
+// rehash
+template<typename T, typename Config, typename Alloc> KUN_INLINE void RobinUSet<T, Config, Alloc>::rehash() { _resize(m_capacity); }
+
+// add (add or assign)
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::add(const T& v)
+{
+    return addHashed(v, hashOf(v));
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::add(T&& v)
+{
+    HashType hash = hashOf(v);
+    return addHashed(std::move(v), hash);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::addHashed(const T& v, HashType hash)
+{
+    KUN_Assert(hashOf(v) == hash);
+
+    if (DataInfo info = findHashed(keyOf(v), hash))
+    {
+        // cover the old data
+        *info.data = v;
+        info.already_exist = true;
+        return info;
+    }
+
+    SizeType index = _prepareInsert(hash);
+    new (m_slots + index) T(v);
+    return DataInfo(m_slots + index, index);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::addHashed(T&& v, HashType hash)
+{
+    KUN_Assert(hashOf(v) == hash);
+
+    if (DataInfo info = findHashed(keyOf(v), hash))
+    {
+        // cover the old data
+        *info.data = std::move(v);
+        info.already_exist = true;
+        return info;
+    }
+
+    SizeType index = _prepareInsert(hash);
+    new (m_slots + index) T(std::move(v));
+    return DataInfo(m_slots + index, index);
+}
+
+// try add (first check existence, then add, never assign)
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::tryAdd(const T& v)
+{
+    return tryAddHashed(v, hashOf(v));
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::tryAdd(T&& v)
+{
+    HashType hash = hashOf(v);
+    return tryAddHashed(std::move(v), hash);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::tryAddHashed(const T& v, HashType hash)
+{
+    if (DataInfo info = findHashed(keyOf(v), hash))
+    {
+        info.already_exist = true;
+        return info;
+    }
+
+    SizeType index = _prepareInsert(hash);
+    new (m_slots + index) T(v);
+    return DataInfo(m_slots + index, index);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::tryAddHashed(T&& v, HashType hash)
+{
+    if (DataInfo info = findHashed(keyOf(v), hash))
+    {
+        info.already_exist = true;
+        return info;
+    }
+
+    SizeType index = _prepareInsert(hash);
+    new (m_slots + index) T(std::move(v));
+    return DataInfo(m_slots + index, index);
+}
+template<typename T, typename Config, typename Alloc>
+template<typename AsType, typename AsHasher, typename AsComparer>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::tryAddAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer)
+{
+    HashType hash = hasher(v);
+    SizeType index = _findIndex(hash, [&](const KeyType& key) { return comparer(key, v); });
+    if (index != npos)
+    {
+        return DataInfo(m_slots + index, index, true);
+    }
+
+    index = _prepareInsert(hash);
+    new (m_slots + index) T(std::forward<AsType>(v));
+    KUN_Assert(hashOf(m_slots[index]) == hash);
+    return DataInfo(m_slots + index, index);
+}
+
+// emplace
+template<typename T, typename Config, typename Alloc>
+template<typename... Args>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::emplace(Args&&... args)
+{
+    // key is unknown before construct, so build a temporary item
+    T v(std::forward<Args>(args)...);
+    return add(std::move(v));
+}
+template<typename T, typename Config, typename Alloc>
+template<typename... Args>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::emplaceHashed(HashType hash, Args&&... args)
+{
+    T v(std::forward<Args>(args)...);
+    return addHashed(std::move(v), hash);
+}
+
+// append
+template<typename T, typename Config, typename Alloc> KUN_INLINE void RobinUSet<T, Config, Alloc>::append(const RobinUSet& set)
+{
+    reserve(m_size + set.size());
+    for (const auto& v : set) { add(v); }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void RobinUSet<T, Config, Alloc>::append(std::initializer_list<T> init_list)
+{
+    reserve(m_size + (SizeType)init_list.size());
+    for (const auto& v : init_list) { add(v); }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void RobinUSet<T, Config, Alloc>::append(const T* p, SizeType n)
+{
+    reserve(m_size + n);
+    for (SizeType i = 0; i < n; ++i) { add(p[i]); }
+}
+
+// remove
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::remove(const KeyType& key)
+{
+    return removeHashed(key, HasherType()(key));
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::removeHashed(const KeyType& key, HashType hash)
+{
+    KUN_Assert(HasherType()(key) == hash);
+
+    SizeType index = _findIndex(hash, [&](const KeyType& k) { return ComparerType()(k, key); });
+    if (index != npos)
+    {
+        removeAt(index);
+    }
+    return index;
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void RobinUSet<T, Config, Alloc>::removeAt(SizeType index)
+{
+    KUN_Assert(hasData(index));
+
+    memory::destructItem(m_slots + index, 1);
+    --m_size;
+
+    // backward shift, move following items one slot closer to home until meet empty slot or item at home
+    SizeType mask = m_capacity - 1;
+    SizeType next = (index + 1) & mask;
+    while (m_dist[next] > 1)
+    {
+        new (m_slots + index) T(std::move(m_slots[next]));
+        memory::destructItem(m_slots + next, 1);
+        m_dist[index] = m_dist[next] - 1;
+        index = next;
+        next = (next + 1) & mask;
+    }
+    m_dist[index] = 0;
+}
+
+// remove as
+template<typename T, typename Config, typename Alloc>
+template<typename AsType, typename AsHasher, typename AsComparer>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::SizeType RobinUSet<T, Config, Alloc>::removeAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer)
+{
+    SizeType index = _findIndex(hasher(v), [&](const KeyType& key) { return comparer(key, v); });
+    if (index != npos)
+    {
+        removeAt(index);
+    }
+    return index;
+}
+
+// modify
+template<typename T, typename Config, typename Alloc> KUN_INLINE T& RobinUSet<T, Config, Alloc>::operator[](SizeType index)
+{
+    KUN_Assert(hasData(index));
+    return m_slots[index];
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE const T& RobinUSet<T, Config, Alloc>::operator[](SizeType index) const
+{
+    KUN_Assert(hasData(index));
+    return m_slots[index];
+}
+
+// find
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::find(const KeyType& key)
+{
+    return findHashed(key, HasherType()(key));
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::CDataInfo RobinUSet<T, Config, Alloc>::find(const KeyType& key) const
+{
+    DataInfo info = const_cast<RobinUSet*>(this)->find(key);
+    return CDataInfo(info.data, info.index);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::findHashed(const KeyType& key, HashType hash)
+{
+    KUN_Assert(HasherType()(key) == hash);
+
+    SizeType index = _findIndex(hash, [&](const KeyType& k) { return ComparerType()(k, key); });
+    return index != npos ? DataInfo(m_slots + index, index) : DataInfo();
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::CDataInfo RobinUSet<T, Config, Alloc>::findHashed(const KeyType& key, HashType hash) const
+{
+    DataInfo info = const_cast<RobinUSet*>(this)->findHashed(key, hash);
+    return CDataInfo(info.data, info.index);
+}
+
+// find as
+template<typename T, typename Config, typename Alloc>
+template<typename AsType, typename AsHasher, typename AsComparer>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::DataInfo RobinUSet<T, Config, Alloc>::findAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer)
+{
+    SizeType index = _findIndex(hasher(v), [&](const KeyType& key) { return comparer(key, v); });
+    return index != npos ? DataInfo(m_slots + index, index) : DataInfo();
+}
+template<typename T, typename Config, typename Alloc>
+template<typename AsType, typename AsHasher, typename AsComparer>
+KUN_INLINE typename RobinUSet<T, Config, Alloc>::CDataInfo RobinUSet<T, Config, Alloc>::findAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer) const
+{
+    DataInfo info = const_cast<RobinUSet*>(this)->findAs(std::forward<AsType>(v), std::forward<AsHasher>(hasher), std::forward<AsComparer>(comparer));
+    return CDataInfo(info.data, info.index);
+}
+
+// contain
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool RobinUSet<T, Config, Alloc>::contain(const KeyType& key) const
+{
+    return (bool)find(key);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool RobinUSet<T, Config, Alloc>::containHashed(const KeyType& key, HashType hash) const
+{
+    return (bool)findHashed(key, hash);
+}
+
+// contain as
+template<typename T, typename Config, typename Alloc>
+template<typename AsType, typename AsHasher, typename AsComparer>
+KUN_INLINE bool RobinUSet<T, Config, Alloc>::containAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer) const
+{
+    return (bool)findAs(std::forward<AsType>(v), std::forward<AsHasher>(hasher), std::forward<AsComparer>(comparer));
+}
+
+// support foreach
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename RobinUSet<T, Config, Alloc>::It RobinUSet<T, Config, Alloc>::begin()
+{
+    return It(m_dist, m_slots, m_capacity);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename RobinUSet<T, Config, Alloc>::It RobinUSet<T, Config, Alloc>::end()
+{
+    return It(m_dist, m_slots, m_capacity, m_capacity);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename RobinUSet<T, Config, Alloc>::CIt RobinUSet<T, Config, Alloc>::begin() const
+{
+    return CIt(m_dist, m_slots, m_capacity);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename RobinUSet<T, Config, Alloc>::CIt RobinUSet<T, Config, Alloc>::end() const
+{
+    return CIt(m_dist, m_slots, m_capacity, m_capacity);
+}
+}// namespace kun
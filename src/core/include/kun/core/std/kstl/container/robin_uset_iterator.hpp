@@ -0,0 +1,52 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/std/types.hpp"
+#include "uset_iterator.hpp"
+
+// RobinUSet iterator
+namespace kun
+{
+template<typename T, typename TS, bool Const> class RobinUSetIt
+{
+public:
+    using ValueType = std::conditional_t<Const, const T, T>;
+
+    KUN_INLINE explicit RobinUSetIt(const u8* dist, ValueType* slots, TS capacity, TS start = 0)
+        : m_dist(dist)
+        , m_slots(slots)
+        , m_capacity(capacity)
+        , m_index(start)
+    {
+        _skipToFull();
+    }
+
+    // impl cpp iterator
+    KUN_INLINE RobinUSetIt& operator++()
+    {
+        ++m_index;
+        _skipToFull();
+        return *this;
+    }
+    KUN_INLINE bool       operator==(const RobinUSetIt& rhs) const { return m_index == rhs.m_index && m_slots == rhs.m_slots; }
+    KUN_INLINE bool       operator!=(const RobinUSetIt& rhs) const { return !(*this == rhs); }
+    KUN_INLINE            operator bool() const { return m_index < m_capacity; }
+    KUN_INLINE bool       operator!() const { return !(bool)*this; }
+    KUN_INLINE ValueType& operator*() const { return m_slots[m_index]; }
+    KUN_INLINE ValueType* operator->() const { return &m_slots[m_index]; }
+
+    // other data
+    KUN_INLINE TS index() const { return m_index; }
+
+private:
+    KUN_INLINE void _skipToFull()
+    {
+        while (m_index < m_capacity && m_dist[m_index] == 0) { ++m_index; }
+    }
+
+private:
+    const u8*  m_dist;
+    ValueType* m_slots;
+    TS         m_capacity;
+    TS         m_index;
+};
+}// namespace kun
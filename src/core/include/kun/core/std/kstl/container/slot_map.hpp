@@ -0,0 +1,308 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/std/types.hpp"
+#include "kun/core/std/kstl/hash.hpp"
+#include "array.hpp"
+#include "sparse_array.hpp"
+#include "fwd.hpp"
+
+// SlotHandle def
+// 64 bit handle of SlotMap, low 32 bits is slot index, high 32 bits is generation of the slot
+// generation of a live slot is always odd, so default handle is always invalid
+namespace kun
+{
+struct SlotHandle
+{
+    u64 value = 0;
+
+    KUN_INLINE SlotHandle() = default;
+    KUN_INLINE SlotHandle(u32 index, u32 generation)
+        : value(((u64)generation << 32) | (u64)index)
+    {
+    }
+    KUN_INLINE static SlotHandle fromRaw(u64 raw)
+    {
+        SlotHandle handle;
+        handle.value = raw;
+        return handle;
+    }
+
+    // getter
+    KUN_INLINE u32  index() const { return (u32)value; }
+    KUN_INLINE u32  generation() const { return (u32)(value >> 32); }
+    KUN_INLINE bool isNull() const { return value == 0; }
+    KUN_INLINE      operator bool() const { return value != 0; }
+
+    // compare
+    KUN_INLINE bool operator==(const SlotHandle& rhs) const { return value == rhs.value; }
+    KUN_INLINE bool operator!=(const SlotHandle& rhs) const { return value != rhs.value; }
+    KUN_INLINE bool operator<(const SlotHandle& rhs) const { return value < rhs.value; }
+};
+template<> struct Hash<SlotHandle>
+{
+    KUN_INLINE Size operator()(const SlotHandle& handle) const { return Hash<u64>()(handle.value); }
+};
+}// namespace kun
+
+// SlotMap def
+// items live in a CompactSparseArray, each slot pairs with a generation counter that bumped on both add and remove
+// odd generation means live slot, a handle is valid only when its generation matches the slot, so validation is one load
+// and a removed-and-reused slot never aliases old handles
+// generations are kept after clear() and release(), old handles stay invalid for the whole life of the map
+namespace kun
+{
+template<typename T, typename Alloc> class SlotMap
+{
+public:
+    using SizeType = typename Alloc::SizeType;
+    static constexpr SizeType npos = (SizeType)::kun::npos;
+    using Handle = SlotHandle;
+    using SlotArray = CompactSparseArray<T, Alloc>;
+    using It = typename SlotArray::It;
+    using CIt = typename SlotArray::CIt;
+
+    // ctor & dtor
+    SlotMap(Alloc alloc = Alloc());
+    ~SlotMap();
+
+    // copy & move, handles of other are also valid for the copy
+    SlotMap(const SlotMap& other, Alloc alloc = Alloc());
+    SlotMap(SlotMap&& other) noexcept;
+
+    // assign & move assign
+    SlotMap& operator=(const SlotMap& rhs);
+    SlotMap& operator=(SlotMap&& rhs) noexcept;
+
+    // getter
+    SizeType         size() const;
+    SizeType         capacity() const;
+    SizeType         sparseSize() const;
+    bool             empty() const;
+    const SlotArray& slots() const;
+    u32              generation(SizeType index) const;
+    Alloc&           allocator();
+    const Alloc&     allocator() const;
+
+    // validate
+    bool   isValid(Handle handle) const;
+    bool   contain(Handle handle) const;
+    Handle handleOf(SizeType index) const;
+
+    // memory op
+    void clear();
+    void release(SizeType capacity = 0);
+    void reserve(SizeType capacity);
+    void shrink();
+
+    // add
+    Handle add(const T& v);
+    Handle add(T&& v);
+
+    // emplace
+    template<typename... Args> Handle emplace(Args&&... args);
+
+    // remove
+    bool remove(Handle handle);
+    void removeAt(SizeType index);
+
+    // find, nullptr if handle is invalid
+    T*       find(Handle handle);
+    const T* find(Handle handle) const;
+
+    // modify
+    T&       operator[](Handle handle);
+    const T& operator[](Handle handle) const;
+
+    // support foreach, use it.index() with handleOf() to get handle
+    It  begin();
+    It  end();
+    CIt begin() const;
+    CIt end() const;
+
+private:
+    // helper
+    Handle _onAdd(SizeType index);
+    void   _bumpGeneration(SizeType index);
+
+private:
+    SlotArray         m_slots;
+    Array<u32, Alloc> m_generations;
+};
+
+// relocatable as its allocator
+template<typename T, typename Alloc> struct is_trivially_relocatable<SlotMap<T, Alloc>> : is_trivially_relocatable<Alloc>
+{
+};
+}// namespace kun
+
+// SlotMap impl
+namespace kun
+{
+// helper
+template<typename T, typename Alloc> KUN_INLINE typename SlotMap<T, Alloc>::Handle SlotMap<T, Alloc>::_onAdd(SizeType index)
+{
+    KUN_Assert(index < (SizeType)0xFFFFFFFF && "SlotMap index must fit in u32");
+
+    // first use of this slot
+    if (index >= m_generations.size())
+    {
+        m_generations.add(0);
+    }
+    _bumpGeneration(index);
+    return Handle((u32)index, m_generations[index]);
+}
+template<typename T, typename Alloc> KUN_INLINE void SlotMap<T, Alloc>::_bumpGeneration(SizeType index)
+{
+    // wrap keeps parity, a stale handle only aliases after 2^31 reuses of the same slot
+    ++m_generations[index];
+}
+
+// ctor & dtor
+template<typename T, typename Alloc>
+KUN_INLINE SlotMap<T, Alloc>::SlotMap(Alloc alloc)
+    : m_slots(alloc)
+    , m_generations(std::move(alloc))
+{
+}
+template<typename T, typename Alloc> KUN_INLINE SlotMap<T, Alloc>::~SlotMap() = default;
+
+// copy & move
+template<typename T, typename Alloc>
+KUN_INLINE SlotMap<T, Alloc>::SlotMap(const SlotMap& other, Alloc alloc)
+    : m_slots(other.m_slots, alloc)
+    , m_generations(other.m_generations, std::move(alloc))
+{
+}
+template<typename T, typename Alloc>
+KUN_INLINE SlotMap<T, Alloc>::SlotMap(SlotMap&& other) noexcept
+    : m_slots(std::move(other.m_slots))
+    , m_generations(std::move(other.m_generations))
+{
+}
+
+// assign & move assign
+template<typename T, typename Alloc> KUN_INLINE SlotMap<T, Alloc>& SlotMap<T, Alloc>::operator=(const SlotMap& rhs)
+{
+    m_slots = rhs.m_slots;
+    m_generations = rhs.m_generations;
+    return *this;
+}
+template<typename T, typename Alloc> KUN_INLINE SlotMap<T, Alloc>& SlotMap<T, Alloc>::operator=(SlotMap&& rhs) noexcept
+{
+    m_slots = std::move(rhs.m_slots);
+    m_generations = std::move(rhs.m_generations);
+    return *this;
+}
+
+// getter
+template<typename T, typename Alloc> KUN_INLINE typename SlotMap<T, Alloc>::SizeType SlotMap<T, Alloc>::size() const { return m_slots.size(); }
+template<typename T, typename Alloc> KUN_INLINE typename SlotMap<T, Alloc>::SizeType SlotMap<T, Alloc>::capacity() const { return m_slots.capacity(); }
+template<typename T, typename Alloc> KUN_INLINE typename SlotMap<T, Alloc>::SizeType SlotMap<T, Alloc>::sparseSize() const { return m_slots.sparseSize(); }
+template<typename T, typename Alloc> KUN_INLINE bool SlotMap<T, Alloc>::empty() const { return m_slots.empty(); }
+template<typename T, typename Alloc> KUN_INLINE const typename SlotMap<T, Alloc>::SlotArray& SlotMap<T, Alloc>::slots() const { return m_slots; }
+template<typename T, typename Alloc> KUN_INLINE u32 SlotMap<T, Alloc>::generation(SizeType index) const
+{
+    return index < m_generations.size() ? m_generations[index] : 0;
+}
+template<typename T, typename Alloc> KUN_INLINE Alloc&       SlotMap<T, Alloc>::allocator() { return m_slots.allocator(); }
+template<typename T, typename Alloc> KUN_INLINE const Alloc& SlotMap<T, Alloc>::allocator() const { return m_slots.allocator(); }
+
+// validate
+template<typename T, typename Alloc> KUN_INLINE bool SlotMap<T, Alloc>::isValid(Handle handle) const
+{
+    // only live slot has odd generation, so a matched odd generation implies a live slot
+    SizeType index = handle.index();
+    return (handle.generation() & 1) && index < m_generations.size() && m_generations[index] == handle.generation();
+}
+template<typename T, typename Alloc> KUN_INLINE bool SlotMap<T, Alloc>::contain(Handle handle) const { return isValid(handle); }
+template<typename T, typename Alloc> KUN_INLINE typename SlotMap<T, Alloc>::Handle SlotMap<T, Alloc>::handleOf(SizeType index) const
+{
+    KUN_Assert(m_slots.hasData(index));
+    return Handle((u32)index, m_generations[index]);
+}
+
+// memory op
+template<typename T, typename Alloc> KUN_INLINE void SlotMap<T, Alloc>::clear()
+{
+    for (auto it = m_slots.begin(); it; ++it)
+    {
+        _bumpGeneration(it.index());
+    }
+    m_slots.clear();
+}
+template<typename T, typename Alloc> KUN_INLINE void SlotMap<T, Alloc>::release(SizeType capacity)
+{
+    for (auto it = m_slots.begin(); it; ++it)
+    {
+        _bumpGeneration(it.index());
+    }
+    m_slots.release(capacity);
+}
+template<typename T, typename Alloc> KUN_INLINE void SlotMap<T, Alloc>::reserve(SizeType capacity)
+{
+    m_slots.reserve(capacity);
+    m_generations.reserve(capacity);
+}
+template<typename T, typename Alloc> KUN_INLINE void SlotMap<T, Alloc>::shrink() { m_slots.shrink(); }
+
+// add
+template<typename T, typename Alloc> KUN_INLINE typename SlotMap<T, Alloc>::Handle SlotMap<T, Alloc>::add(const T& v)
+{
+    return _onAdd(m_slots.add(v).index);
+}
+template<typename T, typename Alloc> KUN_INLINE typename SlotMap<T, Alloc>::Handle SlotMap<T, Alloc>::add(T&& v)
+{
+    return _onAdd(m_slots.add(std::move(v)).index);
+}
+
+// emplace
+template<typename T, typename Alloc> template<typename... Args> KUN_INLINE typename SlotMap<T, Alloc>::Handle SlotMap<T, Alloc>::emplace(Args&&... args)
+{
+    return _onAdd(m_slots.emplace(std::forward<Args>(args)...).index);
+}
+
+// remove
+template<typename T, typename Alloc> KUN_INLINE bool SlotMap<T, Alloc>::remove(Handle handle)
+{
+    if (isValid(handle))
+    {
+        removeAt(handle.index());
+        return true;
+    }
+    return false;
+}
+template<typename T, typename Alloc> KUN_INLINE void SlotMap<T, Alloc>::removeAt(SizeType index)
+{
+    KUN_Assert(m_slots.hasData(index));
+    m_slots.removeAt(index);
+    _bumpGeneration(index);
+}
+
+// find
+template<typename T, typename Alloc> KUN_INLINE T* SlotMap<T, Alloc>::find(Handle handle)
+{
+    return isValid(handle) ? &m_slots[handle.index()] : nullptr;
+}
+template<typename T, typename Alloc> KUN_INLINE const T* SlotMap<T, Alloc>::find(Handle handle) const
+{
+    return isValid(handle) ? &m_slots[handle.index()] : nullptr;
+}
+
+// modify
+template<typename T, typename Alloc> KUN_INLINE T& SlotMap<T, Alloc>::operator[](Handle handle)
+{
+    KUN_Assert(isValid(handle));
+    return m_slots[handle.index()];
+}
+template<typename T, typename Alloc> KUN_INLINE const T& SlotMap<T, Alloc>::operator[](Handle handle) const
+{
+    KUN_Assert(isValid(handle));
+    return m_slots[handle.index()];
+}
+
+// support foreach
+template<typename T, typename Alloc> KUN_INLINE typename SlotMap<T, Alloc>::It  SlotMap<T, Alloc>::begin() { return m_slots.begin(); }
+template<typename T, typename Alloc> KUN_INLINE typename SlotMap<T, Alloc>::It  SlotMap<T, Alloc>::end() { return m_slots.end(); }
+template<typename T, typename Alloc> KUN_INLINE typename SlotMap<T, Alloc>::CIt SlotMap<T, Alloc>::begin() const { return m_slots.begin(); }
+template<typename T, typename Alloc> KUN_INLINE typename SlotMap<T, Alloc>::CIt SlotMap<T, Alloc>::end() const { return m_slots.end(); }
+}// namespace kun
@@ -6,20 +6,25 @@
 #include "kun/core/std/kstl/algo/merge_sort.hpp"
 #include "kun/core/std/kstl/algo/remove.hpp"
 #include "kun/core/std/kstl/algo/find.hpp"
+#include "kun/core/std/kstl/algo/parallel.hpp"
+#include "array.hpp"
 #include "fwd.hpp"
 
 // SparseArray def
 namespace kun
 {
-template<typename T, typename Alloc> class SparseArray
+template<typename T, typename Alloc, typename Storage> class SparseArray
 {
 public:
     using SizeType = typename Alloc::SizeType;
-    using DataType = SparseArrayData<T, SizeType>;
+    static constexpr SizeType npos = (SizeType)::kun::npos;
+    using DataType = SparseArrayData<T, SizeType, Storage::double_link>;
     using DataInfo = SparseArrayDataInfo<T, SizeType>;
     using CDataInfo = SparseArrayDataInfo<const T, SizeType>;
-    using It = SparseArrayIt<T, SizeType, false>;
-    using CIt = SparseArrayIt<T, SizeType, true>;
+    using It = SparseArrayIt<T, SizeType, false, Storage::double_link>;
+    using CIt = SparseArrayIt<T, SizeType, true, Storage::double_link>;
+
+    static_assert(!Alloc::has_inline_storage, "SparseArray not support inline allocator");
 
     // ctor & dtor
     SparseArray(Alloc alloc = Alloc());
@@ -77,6 +82,17 @@ public:
     bool compactStable();
     bool compactTop();
 
+    // compact with remap, on_move(old_index, new_index) is called for each moved item
+    // remap version fill out_remap[old_index] with new index (npos for holes), size of out_remap is the old sparse size
+    template<typename TF> bool     compact(TF&& on_move);
+    template<typename TF> bool     compactStable(TF&& on_move);
+    template<typename TAlloc> bool compactWithRemap(Array<SizeType, TAlloc>& out_remap);
+    template<typename TAlloc> bool compactStableWithRemap(Array<SizeType, TAlloc>& out_remap);
+
+    // incremental compact, move at most max_moves items from top into holes, return true when array is compact
+    bool                       compactStep(SizeType max_moves);
+    template<typename TF> bool compactStep(SizeType max_moves, TF&& on_move);
+
     // add
     DataInfo add(const T& v);
     DataInfo add(T&& v);
@@ -142,6 +158,12 @@ public:
     CIt begin() const;
     CIt end() const;
 
+    // parallel foreach, func(item) is called on worker threads, sparse range is split into word aligned chunks of at least
+    // grain slots, func must not add or remove items
+    template<typename TF> void parallelForEach(TF&& func, SizeType grain = parallel_grain);
+    template<typename TF> void parallelForEach(TF&& func, SizeType grain = parallel_grain) const;
+    static constexpr SizeType  parallel_grain = 4096;
+
 private:
     // helper
     void _setBit(SizeType index, bool v);
@@ -150,15 +172,30 @@ private:
     void _resizeMemory(SizeType new_capacity);
     void _grow(SizeType n);
 
+    // freelist helper
+    static void _copyHole(DataType& dst, const DataType& src);
+    void        _pushHole(SizeType index);
+    SizeType    _popHole();
+    void        _unlinkHole(SizeType index);
+    void        _unlinkHolesFrom(SizeType start);// unlink all holes at or after start
+
+    // compact helper
+    template<typename TAlloc> void _initRemap(Array<SizeType, TAlloc>& out_remap) const;
+
 private:
-    u32*      m_bit_array;
-    SizeType  m_bit_array_size;
-    SizeType  m_num_hole;
-    SizeType  m_freelist_head;
-    SizeType  m_sparse_size;
-    SizeType  m_capacity;
-    DataType* m_data;
-    Alloc     m_alloc;
+    u32*                        m_bit_array;
+    SizeType                    m_bit_array_size;
+    SizeType                    m_num_hole;
+    SizeType                    m_freelist_head;
+    SizeType                    m_sparse_size;
+    SizeType                    m_capacity;
+    DataType*                   m_data;
+    KUN_NO_UNIQUE_ADDRESS Alloc m_alloc;
+};
+
+// relocatable as its allocator
+template<typename T, typename Alloc, typename Storage> struct is_trivially_relocatable<SparseArray<T, Alloc, Storage>> : is_trivially_relocatable<Alloc>
+{
 };
 }// namespace kun
 
@@ -166,13 +203,118 @@ private:
 namespace kun
 {
 // helper
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::_setBit(SizeType index, bool v) { algo::setBit(m_bit_array, index, v); }
-template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::_getBit(SizeType index) const { return algo::getBit(m_bit_array, index); }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::_setBitRange(SizeType start, SizeType n, bool v)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::_setBit(SizeType index, bool v) { algo::setBit(m_bit_array, index, v); }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE bool SparseArray<T, Alloc, Storage>::_getBit(SizeType index) const { return algo::getBit(m_bit_array, index); }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::_setBitRange(SizeType start, SizeType n, bool v)
 {
     algo::setBitRange(m_bit_array, start, n, v);
 }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::_resizeMemory(SizeType new_capacity)
+
+// freelist helper
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::_copyHole(DataType& dst, const DataType& src)
+{
+    if constexpr (Storage::double_link)
+    {
+        dst.prev = src.prev;
+    }
+    dst.next = src.next;
+}
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::_pushHole(SizeType index)
+{
+    DataType& data = m_data[index];
+    if constexpr (Storage::double_link)
+    {
+        if (m_num_hole)
+        {
+            m_data[m_freelist_head].prev = index;
+        }
+        data.prev = npos;
+    }
+    data.next = m_freelist_head;
+    m_freelist_head = index;
+    ++m_num_hole;
+}
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::_popHole()
+{
+    KUN_Assert(m_num_hole);
+
+    // remove and use first index from freelist
+    SizeType index = m_freelist_head;
+    m_freelist_head = m_data[m_freelist_head].next;
+    --m_num_hole;
+
+    // break link
+    if constexpr (Storage::double_link)
+    {
+        if (m_num_hole)
+        {
+            m_data[m_freelist_head].prev = npos;
+        }
+    }
+    return index;
+}
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::_unlinkHole(SizeType index)
+{
+    DataType& data = m_data[index];
+    if constexpr (Storage::double_link)
+    {
+        if (m_freelist_head == index)
+        {
+            m_freelist_head = data.next;
+        }
+        if (data.next != npos)
+        {
+            m_data[data.next].prev = data.prev;
+        }
+        if (data.prev != npos)
+        {
+            m_data[data.prev].next = data.next;
+        }
+    }
+    else
+    {
+        // find previous node
+        SizeType* link = &m_freelist_head;
+        while (*link != index)
+        {
+            KUN_Assert(*link != npos && "hole not in freelist");
+            link = &m_data[*link].next;
+        }
+        *link = data.next;
+    }
+    --m_num_hole;
+}
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::_unlinkHolesFrom(SizeType start)
+{
+    if constexpr (Storage::double_link)
+    {
+        for (SizeType i = start; i < m_sparse_size; ++i)
+        {
+            if (isHole(i))
+            {
+                _unlinkHole(i);
+            }
+        }
+    }
+    else
+    {
+        // one pass filter
+        SizeType* link = &m_freelist_head;
+        while (*link != npos)
+        {
+            if (*link >= start)
+            {
+                *link = m_data[*link].next;
+                --m_num_hole;
+            }
+            else
+            {
+                link = &m_data[*link].next;
+            }
+        }
+    }
+}
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::_resizeMemory(SizeType new_capacity)
 {
     if (new_capacity)
     {
@@ -196,12 +338,11 @@ template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::_res
                 DataType& old_data = *(m_data + i);
                 if (hasData(i))
                 {
-                    new_data.data = std::move(old_data.data);
+                    new (&new_data.data) T(std::move(old_data.data));
                 }
                 else
                 {
-                    new_data.prev = old_data.prev;
-                    new_data.next = old_data.next;
+                    _copyHole(new_data, old_data);
                 }
             }
 
@@ -274,14 +415,14 @@ template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::_res
         m_data = nullptr;
     }
 }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::_grow(SizeType n)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::_grow(SizeType n)
 {
     auto new_sparse_size = m_sparse_size + n;
 
     // grow memory
     if (new_sparse_size > m_capacity)
     {
-        auto new_capacity = m_alloc.getGrow(new_sparse_size, m_capacity);
+        auto new_capacity = m_alloc.getGrow(new_sparse_size, m_capacity, sizeof(DataType));
 
         // grow memory
         if constexpr (memory::memory_policy_traits<T>::use_realloc)
@@ -300,16 +441,15 @@ template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::_gro
                 DataType& old_data = *(m_data + i);
                 if (hasData(i))
                 {
-                    new_data.data = std::move(old_data.data);
+                    new (&new_data.data) T(std::move(old_data.data));
                     if constexpr (memory::memory_policy_traits<T>::call_dtor)
                     {
-                        old_data->data.~T();
+                        old_data.data.~T();
                     }
                 }
                 else
                 {
-                    new_data.prev = old_data.prev;
-                    new_data.next = old_data.next;
+                    _copyHole(new_data, old_data);
                 }
             }
 
@@ -327,7 +467,7 @@ template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::_gro
             // calc grow size
             SizeType data_word_size = algo::calcNumWords(m_capacity);
             SizeType old_word_size = algo::calcNumWords(m_bit_array_size);
-            SizeType new_word_size = m_alloc.getGrow(data_word_size, old_word_size);
+            SizeType new_word_size = m_alloc.getGrow(data_word_size, old_word_size, sizeof(u32));
 
             // alloc memory and clean
             if (new_word_size > old_word_size)
@@ -348,9 +488,21 @@ template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::_gro
     m_sparse_size = new_sparse_size;
 }
 
+// compact helper
+template<typename T, typename Alloc, typename Storage>
+template<typename TAlloc>
+KUN_INLINE void SparseArray<T, Alloc, Storage>::_initRemap(Array<SizeType, TAlloc>& out_remap) const
+{
+    out_remap.resizeUnsafe(m_sparse_size);
+    for (SizeType i = 0; i < m_sparse_size; ++i)
+    {
+        out_remap[i] = hasData(i) ? i : npos;
+    }
+}
+
 // ctor & dtor
-template<typename T, typename Alloc>
-KUN_INLINE SparseArray<T, Alloc>::SparseArray(Alloc alloc)
+template<typename T, typename Alloc, typename Storage>
+KUN_INLINE SparseArray<T, Alloc, Storage>::SparseArray(Alloc alloc)
     : m_bit_array(nullptr)
     , m_bit_array_size(0)
     , m_num_hole(0)
@@ -361,8 +513,8 @@ KUN_INLINE SparseArray<T, Alloc>::SparseArray(Alloc alloc)
     , m_alloc(std::move(alloc))
 {
 }
-template<typename T, typename Alloc>
-KUN_INLINE SparseArray<T, Alloc>::SparseArray(SizeType size, Alloc alloc)
+template<typename T, typename Alloc, typename Storage>
+KUN_INLINE SparseArray<T, Alloc, Storage>::SparseArray(SizeType size, Alloc alloc)
     : m_bit_array(nullptr)
     , m_bit_array_size(0)
     , m_num_hole(0)
@@ -383,8 +535,8 @@ KUN_INLINE SparseArray<T, Alloc>::SparseArray(SizeType size, Alloc alloc)
         for (SizeType i = 0; i < size; ++i) { new (&m_data[i].data) T(); }
     }
 }
-template<typename T, typename Alloc>
-KUN_INLINE SparseArray<T, Alloc>::SparseArray(SizeType size, const T& v, Alloc alloc)
+template<typename T, typename Alloc, typename Storage>
+KUN_INLINE SparseArray<T, Alloc, Storage>::SparseArray(SizeType size, const T& v, Alloc alloc)
     : m_bit_array(nullptr)
     , m_bit_array_size(0)
     , m_num_hole(0)
@@ -405,8 +557,8 @@ KUN_INLINE SparseArray<T, Alloc>::SparseArray(SizeType size, const T& v, Alloc a
         for (SizeType i = 0; i < size; ++i) { new (&m_data[i].data) T(v); }
     }
 }
-template<typename T, typename Alloc>
-KUN_INLINE SparseArray<T, Alloc>::SparseArray(const T* p, SizeType n, Alloc alloc)
+template<typename T, typename Alloc, typename Storage>
+KUN_INLINE SparseArray<T, Alloc, Storage>::SparseArray(const T* p, SizeType n, Alloc alloc)
     : m_bit_array(nullptr)
     , m_bit_array_size(0)
     , m_num_hole(0)
@@ -427,8 +579,8 @@ KUN_INLINE SparseArray<T, Alloc>::SparseArray(const T* p, SizeType n, Alloc allo
         for (SizeType i = 0; i < n; ++i) { new (&m_data[i].data) T(p[i]); }
     }
 }
-template<typename T, typename Alloc>
-KUN_INLINE SparseArray<T, Alloc>::SparseArray(std::initializer_list<T> init_list, Alloc alloc)
+template<typename T, typename Alloc, typename Storage>
+KUN_INLINE SparseArray<T, Alloc, Storage>::SparseArray(std::initializer_list<T> init_list, Alloc alloc)
     : m_bit_array(nullptr)
     , m_bit_array_size(0)
     , m_num_hole(0)
@@ -450,11 +602,11 @@ KUN_INLINE SparseArray<T, Alloc>::SparseArray(std::initializer_list<T> init_list
         for (SizeType i = 0; i < size; ++i) { new (&m_data[i].data) T(*(init_list.begin() + i)); }
     }
 }
-template<typename T, typename Alloc> KUN_INLINE SparseArray<T, Alloc>::~SparseArray() { release(); }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE SparseArray<T, Alloc, Storage>::~SparseArray() { release(); }
 
 // copy & move
-template<typename T, typename Alloc>
-KUN_INLINE SparseArray<T, Alloc>::SparseArray(const SparseArray& other, Alloc alloc)
+template<typename T, typename Alloc, typename Storage>
+KUN_INLINE SparseArray<T, Alloc, Storage>::SparseArray(const SparseArray& other, Alloc alloc)
     : m_bit_array(nullptr)
     , m_bit_array_size(0)
     , m_num_hole(0)
@@ -466,8 +618,8 @@ KUN_INLINE SparseArray<T, Alloc>::SparseArray(const SparseArray& other, Alloc al
 {
     (*this) = other;
 }
-template<typename T, typename Alloc>
-KUN_INLINE SparseArray<T, Alloc>::SparseArray(SparseArray&& other) noexcept
+template<typename T, typename Alloc, typename Storage>
+KUN_INLINE SparseArray<T, Alloc, Storage>::SparseArray(SparseArray&& other) noexcept
     : m_bit_array(other.m_bit_array)
     , m_bit_array_size(other.m_bit_array_size)
     , m_num_hole(other.m_num_hole)
@@ -487,7 +639,7 @@ KUN_INLINE SparseArray<T, Alloc>::SparseArray(SparseArray&& other) noexcept
 }
 
 // assign & move assign
-template<typename T, typename Alloc> KUN_INLINE SparseArray<T, Alloc>& SparseArray<T, Alloc>::operator=(const SparseArray& rhs)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE SparseArray<T, Alloc, Storage>& SparseArray<T, Alloc, Storage>::operator=(const SparseArray& rhs)
 {
     if (this != &rhs)
     {
@@ -505,12 +657,11 @@ template<typename T, typename Alloc> KUN_INLINE SparseArray<T, Alloc>& SparseArr
 
                 if (rhs.hasData(i))
                 {
-                    new (dst_data) T(*src_data);
+                    new (&dst_data->data) T(src_data->data);
                 }
                 else
                 {
-                    dst_data->prev = src_data->prev;
-                    dst_data->next = src_data->next;
+                    _copyHole(*dst_data, *src_data);
                 }
             }
         }
@@ -529,7 +680,7 @@ template<typename T, typename Alloc> KUN_INLINE SparseArray<T, Alloc>& SparseArr
     }
     return *this;
 }
-template<typename T, typename Alloc> KUN_INLINE SparseArray<T, Alloc>& SparseArray<T, Alloc>::operator=(SparseArray&& rhs) noexcept
+template<typename T, typename Alloc, typename Storage> KUN_INLINE SparseArray<T, Alloc, Storage>& SparseArray<T, Alloc, Storage>::operator=(SparseArray&& rhs) noexcept
 {
     if (this != &rhs)
     {
@@ -558,7 +709,7 @@ template<typename T, typename Alloc> KUN_INLINE SparseArray<T, Alloc>& SparseArr
 }
 
 // special assign
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::assign(const T* p, SizeType n)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::assign(const T* p, SizeType n)
 {
     clear();
 
@@ -573,7 +724,7 @@ template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::assi
         for (SizeType i = 0; i < n; ++i) { new (&m_data[i].data) T(p[i]); }
     }
 }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::assign(std::initializer_list<T> init_list)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::assign(std::initializer_list<T> init_list)
 {
     clear();
 
@@ -591,7 +742,7 @@ template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::assi
 }
 
 // compare
-template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::operator==(const SparseArray& rhs) const
+template<typename T, typename Alloc, typename Storage> KUN_INLINE bool SparseArray<T, Alloc, Storage>::operator==(const SparseArray& rhs) const
 {
     if (m_sparse_size == rhs.m_sparse_size)
     {
@@ -616,60 +767,60 @@ template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::oper
     }
     return false;
 }
-template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::operator!=(const SparseArray& rhs) const { return !((*this) == rhs); }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE bool SparseArray<T, Alloc, Storage>::operator!=(const SparseArray& rhs) const { return !((*this) == rhs); }
 
 // getter
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::size() const
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::size() const
 {
     return m_sparse_size - m_num_hole;
 }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::capacity() const
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::capacity() const
 {
     return m_capacity;
 }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::slack() const
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::slack() const
 {
     return m_capacity - m_sparse_size + m_num_hole;
 }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::sparseSize() const
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::sparseSize() const
 {
     return m_sparse_size;
 }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::holeSize() const
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::holeSize() const
 {
     return m_num_hole;
 }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::bitArraySize() const
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::bitArraySize() const
 {
     return m_bit_array_size;
 }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::freelistHead() const
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::freelistHead() const
 {
     return m_freelist_head;
 }
-template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::isCompact() const { return m_num_hole == 0; }
-template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::empty() const { return (m_sparse_size - m_num_hole) == 0; }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::DataType*       SparseArray<T, Alloc>::data() { return m_data; }
-template<typename T, typename Alloc> KUN_INLINE const typename SparseArray<T, Alloc>::DataType* SparseArray<T, Alloc>::data() const { return m_data; }
-template<typename T, typename Alloc> KUN_INLINE u32*         SparseArray<T, Alloc>::bitArray() { return m_bit_array; }
-template<typename T, typename Alloc> KUN_INLINE const u32*   SparseArray<T, Alloc>::bitArray() const { return m_bit_array; }
-template<typename T, typename Alloc> KUN_INLINE Alloc&       SparseArray<T, Alloc>::allocator() { return m_alloc; }
-template<typename T, typename Alloc> KUN_INLINE const Alloc& SparseArray<T, Alloc>::allocator() const { return m_alloc; }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE bool SparseArray<T, Alloc, Storage>::isCompact() const { return m_num_hole == 0; }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE bool SparseArray<T, Alloc, Storage>::empty() const { return (m_sparse_size - m_num_hole) == 0; }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::DataType*       SparseArray<T, Alloc, Storage>::data() { return m_data; }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE const typename SparseArray<T, Alloc, Storage>::DataType* SparseArray<T, Alloc, Storage>::data() const { return m_data; }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE u32*         SparseArray<T, Alloc, Storage>::bitArray() { return m_bit_array; }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE const u32*   SparseArray<T, Alloc, Storage>::bitArray() const { return m_bit_array; }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE Alloc&       SparseArray<T, Alloc, Storage>::allocator() { return m_alloc; }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE const Alloc& SparseArray<T, Alloc, Storage>::allocator() const { return m_alloc; }
 
 // validate
-template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::hasData(SizeType idx) const { return _getBit(idx); }
-template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::isHole(SizeType idx) const { return !_getBit(idx); }
-template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::isValidIndex(SizeType idx) const
+template<typename T, typename Alloc, typename Storage> KUN_INLINE bool SparseArray<T, Alloc, Storage>::hasData(SizeType idx) const { return _getBit(idx); }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE bool SparseArray<T, Alloc, Storage>::isHole(SizeType idx) const { return !_getBit(idx); }
+template<typename T, typename Alloc, typename Storage> KUN_INLINE bool SparseArray<T, Alloc, Storage>::isValidIndex(SizeType idx) const
 {
     return idx >= 0 && idx < m_sparse_size;
 }
-template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::isValidPointer(const T* p) const
+template<typename T, typename Alloc, typename Storage> KUN_INLINE bool SparseArray<T, Alloc, Storage>::isValidPointer(const T* p) const
 {
     return p >= reinterpret_cast<T*>(m_data) && p < reinterpret_cast<T*>(m_data + m_sparse_size);
 }
 
 // memory op
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::clear()
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::clear()
 {
     // destruct items
     if constexpr (memory::memory_policy_traits<T>::call_dtor)
@@ -694,24 +845,32 @@ template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::clea
     m_freelist_head = npos;
     m_sparse_size = 0;
 }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::release(SizeType capacity)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::release(SizeType capacity)
 {
     clear();
     _resizeMemory(capacity);
 }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::reserve(SizeType capacity)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::reserve(SizeType capacity)
 {
     if (capacity > m_capacity)
     {
         _resizeMemory(capacity);
     }
 }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::shrink()
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::shrink()
 {
-    auto new_capacity = m_alloc.getShrink(m_sparse_size, m_capacity);
+    auto new_capacity = m_alloc.getShrink(m_sparse_size, m_capacity, sizeof(DataType));
     _resizeMemory(new_capacity);
 }
-template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::compact()
+template<typename T, typename Alloc, typename Storage> KUN_INLINE bool SparseArray<T, Alloc, Storage>::compact()
+{
+    return compact([](SizeType, SizeType) {});
+}
+template<typename T, typename Alloc, typename Storage> KUN_INLINE bool SparseArray<T, Alloc, Storage>::compactStable()
+{
+    return compactStable([](SizeType, SizeType) {});
+}
+template<typename T, typename Alloc, typename Storage> template<typename TF> KUN_INLINE bool SparseArray<T, Alloc, Storage>::compact(TF&& on_move)
 {
     if (!isCompact())
     {
@@ -729,8 +888,10 @@ template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::comp
                 } while (!hasData(search_index));
 
                 // move element to the hole
-                *(m_data + m_freelist_head) = std::move(*(m_data + search_index));
+                new (&(m_data + m_freelist_head)->data) T(std::move((m_data + search_index)->data));
                 (m_data + search_index)->data.~T();
+                _setBit(m_freelist_head, true);
+                on_move(search_index, m_freelist_head);
             }
             m_freelist_head = next_index;
         }
@@ -749,7 +910,7 @@ template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::comp
         return false;
     }
 }
-template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::compactStable()
+template<typename T, typename Alloc, typename Storage> template<typename TF> KUN_INLINE bool SparseArray<T, Alloc, Storage>::compactStable(TF&& on_move)
 {
     if (!isCompact())
     {
@@ -770,9 +931,10 @@ template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::comp
             // move items
             while (read_index < m_sparse_size && hasData(read_index))
             {
-                (m_data + write_index)->data = std::move((m_data + read_index)->data);
+                new (&(m_data + write_index)->data) T(std::move((m_data + read_index)->data));
                 (m_data + read_index)->data.~T();
                 _setBit(write_index, true);
+                on_move(read_index, write_index);
                 ++write_index;
                 ++read_index;
             }
@@ -791,79 +953,86 @@ template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::comp
         return false;
     }
 }
-template<typename T, typename Alloc> KUN_INLINE bool SparseArray<T, Alloc>::compactTop()
+template<typename T, typename Alloc, typename Storage> KUN_INLINE bool SparseArray<T, Alloc, Storage>::compactTop()
 {
     if (!isCompact())
     {
-        bool has_changes = false;
-        for (SizeType i(m_sparse_size - 1), n(m_sparse_size); n; --i, --n)
-        {
-            DataType& data = m_data[i];
+        // find top holes
+        SizeType new_sparse_size = m_sparse_size;
+        while (new_sparse_size && isHole(new_sparse_size - 1)) { --new_sparse_size; }
 
-            if (isHole(i))
-            {
-                // remove from freelist
-                --m_num_hole;
-                if (m_freelist_head == i)
-                {
-                    m_freelist_head = data.next;
-                }
-                if (data.next != npos)
-                {
-                    m_data[data.next].prev = data.prev;
-                }
-                if (data.prev != npos)
-                {
-                    m_data[data.prev].next = data.next;
-                }
-
-                // update size
-                --m_sparse_size;
+        if (new_sparse_size != m_sparse_size)
+        {
+            // remove from freelist
+            _unlinkHolesFrom(new_sparse_size);
 
-                has_changes = true;
-            }
-            else
-            {
-                break;
-            }
+            // update size
+            m_sparse_size = new_sparse_size;
+            return true;
         }
-        return has_changes;
     }
-    else
+    return false;
+}
+template<typename T, typename Alloc, typename Storage> template<typename TAlloc> KUN_INLINE bool SparseArray<T, Alloc, Storage>::compactWithRemap(Array<SizeType, TAlloc>& out_remap)
+{
+    _initRemap(out_remap);
+    return compact([&out_remap](SizeType old_index, SizeType new_index) { out_remap[old_index] = new_index; });
+}
+template<typename T, typename Alloc, typename Storage>
+template<typename TAlloc>
+KUN_INLINE bool SparseArray<T, Alloc, Storage>::compactStableWithRemap(Array<SizeType, TAlloc>& out_remap)
+{
+    _initRemap(out_remap);
+    return compactStable([&out_remap](SizeType old_index, SizeType new_index) { out_remap[old_index] = new_index; });
+}
+template<typename T, typename Alloc, typename Storage> KUN_INLINE bool SparseArray<T, Alloc, Storage>::compactStep(SizeType max_moves)
+{
+    return compactStep(max_moves, [](SizeType, SizeType) {});
+}
+template<typename T, typename Alloc, typename Storage> template<typename TF> KUN_INLINE bool SparseArray<T, Alloc, Storage>::compactStep(SizeType max_moves, TF&& on_move)
+{
+    // after compactTop, top item is always alive and every hole is below it
+    compactTop();
+    for (; max_moves && m_num_hole; --max_moves)
     {
-        return false;
+        SizeType hole_index = _popHole();
+        SizeType last_index = m_sparse_size - 1;
+
+        // move top item to the hole
+        new (&m_data[hole_index].data) T(std::move(m_data[last_index].data));
+        m_data[last_index].data.~T();
+        _setBit(hole_index, true);
+        _setBit(last_index, false);
+        --m_sparse_size;
+        on_move(last_index, hole_index);
+
+        // drop holes exposed by the move
+        compactTop();
     }
+    return isCompact();
 }
 
 // add
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::DataInfo SparseArray<T, Alloc>::add(const T& v)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::DataInfo SparseArray<T, Alloc, Storage>::add(const T& v)
 {
     DataInfo info = addUnsafe();
     new (info.data) T(v);
     return info;
 }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::DataInfo SparseArray<T, Alloc>::add(T&& v)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::DataInfo SparseArray<T, Alloc, Storage>::add(T&& v)
 {
     DataInfo info = addUnsafe();
     new (info.data) T(std::move(v));
     return info;
 }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::DataInfo SparseArray<T, Alloc>::addUnsafe()
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::DataInfo SparseArray<T, Alloc, Storage>::addUnsafe()
 {
     SizeType index;
 
     if (m_num_hole)
     {
-        // remove and use first index from freelist
-        index = m_freelist_head;
-        m_freelist_head = m_data[m_freelist_head].next;
-        --m_num_hole;
-
-        // break link
-        if (m_num_hole)
-        {
-            m_data[m_freelist_head].prev = npos;
-        }
+        // use first index from freelist
+        index = _popHole();
     }
     else
     {
@@ -877,13 +1046,13 @@ template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::
 
     return DataInfo(&m_data[index].data, index);
 }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::DataInfo SparseArray<T, Alloc>::addDefault()
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::DataInfo SparseArray<T, Alloc, Storage>::addDefault()
 {
     DataInfo info = addUnsafe();
     new (info.data) T();
     return info;
 }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::DataInfo SparseArray<T, Alloc>::addZeroed()
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::DataInfo SparseArray<T, Alloc, Storage>::addZeroed()
 {
     DataInfo info = addUnsafe();
     memory::memzero(info.data, sizeof(T));
@@ -891,83 +1060,69 @@ template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::
 }
 
 // add at
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::addAt(SizeType idx, const T& v)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::addAt(SizeType idx, const T& v)
 {
     addAtUnsafe(idx);
     new (&m_data[idx].data) T(v);
 }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::addAt(SizeType idx, T&& v)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::addAt(SizeType idx, T&& v)
 {
     addAtUnsafe(idx);
     new (&m_data[idx].data) T(std::move(v));
 }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::addAtUnsafe(SizeType idx)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::addAtUnsafe(SizeType idx)
 {
     KUN_Assert(isHole(idx));
     KUN_Assert(isValidIndex(idx));
 
-    DataType& data = m_data[idx];
-
     // remove from freelist
-    --m_num_hole;
-    if (m_freelist_head == idx)
-    {
-        m_freelist_head = data.next;
-    }
-    if (data.next != npos)
-    {
-        m_data[data.next].prev = data.prev;
-    }
-    if (data.prev != npos)
-    {
-        m_data[data.prev].next = data.next;
-    }
+    _unlinkHole(idx);
 
     // setup bit
     _setBit(idx, true);
 }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::addAtDefault(SizeType idx)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::addAtDefault(SizeType idx)
 {
     addAtUnsafe(idx);
     new (&m_data[idx].data) T();
 }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::addAtZeroed(SizeType idx)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::addAtZeroed(SizeType idx)
 {
     addAtUnsafe(idx);
     memory::memzero(&m_data[idx].data, sizeof(T));
 }
 
 // emplace
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Storage>
 template<typename... Args>
-KUN_INLINE typename SparseArray<T, Alloc>::DataInfo SparseArray<T, Alloc>::emplace(Args&&... args)
+KUN_INLINE typename SparseArray<T, Alloc, Storage>::DataInfo SparseArray<T, Alloc, Storage>::emplace(Args&&... args)
 {
     DataInfo info = addUnsafe();
     new (info.data) T(std::forward<Args>(args)...);
     return info;
 }
-template<typename T, typename Alloc> template<typename... Args> KUN_INLINE void SparseArray<T, Alloc>::emplaceAt(SizeType index, Args&&... args)
+template<typename T, typename Alloc, typename Storage> template<typename... Args> KUN_INLINE void SparseArray<T, Alloc, Storage>::emplaceAt(SizeType index, Args&&... args)
 {
     addAtUnsafe(index);
     new (&m_data[index].data) T(std::forward<Args>(args)...);
 }
 
 // append
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::append(const SparseArray& arr)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::append(const SparseArray& arr)
 {
     for (const T& data : arr) { add(data); }
 }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::append(std::initializer_list<T> init_list)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::append(std::initializer_list<T> init_list)
 {
     for (const T& data : init_list) { add(data); }
 }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::append(T* p, SizeType n)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::append(T* p, SizeType n)
 {
     for (SizeType i = 0; i < n; ++i) { add(p[i]); }
 }
 
 // remove
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::removeAt(SizeType index, SizeType n)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::removeAt(SizeType index, SizeType n)
 {
     KUN_Assert(isValidIndex(index));
     KUN_Assert(isValidIndex(index + n - 1));
@@ -980,7 +1135,7 @@ template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::remo
 
     removeAtUnsafe(index, n);
 }
-template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::removeAtUnsafe(SizeType index, SizeType n)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE void SparseArray<T, Alloc, Storage>::removeAtUnsafe(SizeType index, SizeType n)
 {
     KUN_Assert(isValidIndex(index));
     KUN_Assert(isValidIndex(index + n - 1));
@@ -988,17 +1143,8 @@ template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::remo
 
     for (; n; --n)
     {
-        DataType& data = m_data[index];
-
         // link to freelist
-        if (m_num_hole)
-        {
-            m_data[m_freelist_head].prev = index;
-        }
-        data.prev = npos;
-        data.next = m_freelist_head;
-        m_freelist_head = index;
-        ++m_num_hole;
+        _pushHole(index);
 
         // set flag
         _setBit(index, false);
@@ -1007,27 +1153,27 @@ template<typename T, typename Alloc> KUN_INLINE void SparseArray<T, Alloc>::remo
         ++index;
     }
 }
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Storage>
 template<typename TK>
-KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::remove(const TK& v)
+KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::remove(const TK& v)
 {
     return removeIf([&v](const T& a) { return a == v; });
 }
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Storage>
 template<typename TK>
-KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::removeLast(const TK& v)
+KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::removeLast(const TK& v)
 {
     return removeLastIf([&v](const T& a) { return a == v; });
 }
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Storage>
 template<typename TK>
-KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::removeAll(const TK& v)
+KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::removeAll(const TK& v)
 {
     return removeAllIf([&v](const T& a) { return a == v; });
 }
 
 // remove if
-template<typename T, typename Alloc> template<typename TP> KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::removeIf(TP&& p)
+template<typename T, typename Alloc, typename Storage> template<typename TP> KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::removeIf(TP&& p)
 {
     if (DataInfo info = findIf(std::forward<TP>(p)))
     {
@@ -1036,9 +1182,9 @@ template<typename T, typename Alloc> template<typename TP> KUN_INLINE typename S
     }
     return npos;
 }
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Storage>
 template<typename TP>
-KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::removeLastIf(TP&& p)
+KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::removeLastIf(TP&& p)
 {
     if (DataInfo info = findLastIf(std::forward<TP>(p)))
     {
@@ -1047,9 +1193,9 @@ KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::remov
     }
     return npos;
 }
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Storage>
 template<typename TP>
-KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::removeAllIf(TP&& p)
+KUN_INLINE typename SparseArray<T, Alloc, Storage>::SizeType SparseArray<T, Alloc, Storage>::removeAllIf(TP&& p)
 {
     SizeType count = 0;
     for (SizeType i = 0; i < m_sparse_size; ++i)
@@ -1064,45 +1210,45 @@ KUN_INLINE typename SparseArray<T, Alloc>::SizeType SparseArray<T, Alloc>::remov
 }
 
 // modify
-template<typename T, typename Alloc> KUN_INLINE T& SparseArray<T, Alloc>::operator[](SizeType index)
+template<typename T, typename Alloc, typename Storage> KUN_INLINE T& SparseArray<T, Alloc, Storage>::operator[](SizeType index)
 {
     KUN_Assert(isValidIndex(index));
     return m_data[index].data;
 }
-template<typename T, typename Alloc> KUN_INLINE const T& SparseArray<T, Alloc>::operator[](SizeType index) const
+template<typename T, typename Alloc, typename Storage> KUN_INLINE const T& SparseArray<T, Alloc, Storage>::operator[](SizeType index) const
 {
     KUN_Assert(isValidIndex(index));
     return m_data[index].data;
 }
 
 // find
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Storage>
 template<typename TK>
-KUN_INLINE typename SparseArray<T, Alloc>::DataInfo SparseArray<T, Alloc>::find(const TK& v)
+KUN_INLINE typename SparseArray<T, Alloc, Storage>::DataInfo SparseArray<T, Alloc, Storage>::find(const TK& v)
 {
     return findIf([&v](const T& a) { return a == v; });
 }
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Storage>
 template<typename TK>
-KUN_INLINE typename SparseArray<T, Alloc>::DataInfo SparseArray<T, Alloc>::findLast(const TK& v)
+KUN_INLINE typename SparseArray<T, Alloc, Storage>::DataInfo SparseArray<T, Alloc, Storage>::findLast(const TK& v)
 {
     return findLastIf([&v](const T& a) { return a == v; });
 }
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Storage>
 template<typename TK>
-KUN_INLINE typename SparseArray<T, Alloc>::CDataInfo SparseArray<T, Alloc>::find(const TK& v) const
+KUN_INLINE typename SparseArray<T, Alloc, Storage>::CDataInfo SparseArray<T, Alloc, Storage>::find(const TK& v) const
 {
     return findIf([&v](const T& a) { return a == v; });
 }
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Storage>
 template<typename TK>
-KUN_INLINE typename SparseArray<T, Alloc>::CDataInfo SparseArray<T, Alloc>::findLast(const TK& v) const
+KUN_INLINE typename SparseArray<T, Alloc, Storage>::CDataInfo SparseArray<T, Alloc, Storage>::findLast(const TK& v) const
 {
     return findLastIf([&v](const T& a) { return a == v; });
 }
 
 // find if
-template<typename T, typename Alloc> template<typename TP> KUN_INLINE typename SparseArray<T, Alloc>::DataInfo SparseArray<T, Alloc>::findIf(TP&& p)
+template<typename T, typename Alloc, typename Storage> template<typename TP> KUN_INLINE typename SparseArray<T, Alloc, Storage>::DataInfo SparseArray<T, Alloc, Storage>::findIf(TP&& p)
 {
     for (SizeType i = 0; i < m_sparse_size; ++i)
     {
@@ -1117,9 +1263,9 @@ template<typename T, typename Alloc> template<typename TP> KUN_INLINE typename S
     }
     return DataInfo();
 }
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Storage>
 template<typename TP>
-KUN_INLINE typename SparseArray<T, Alloc>::DataInfo SparseArray<T, Alloc>::findLastIf(TP&& p)
+KUN_INLINE typename SparseArray<T, Alloc, Storage>::DataInfo SparseArray<T, Alloc, Storage>::findLastIf(TP&& p)
 {
     for (SizeType i(m_sparse_size - 1), n(m_sparse_size); n; --i, --n)
     {
@@ -1134,9 +1280,9 @@ KUN_INLINE typename SparseArray<T, Alloc>::DataInfo SparseArray<T, Alloc>::findL
     }
     return DataInfo();
 }
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Storage>
 template<typename TP>
-KUN_INLINE typename SparseArray<T, Alloc>::CDataInfo SparseArray<T, Alloc>::findIf(TP&& p) const
+KUN_INLINE typename SparseArray<T, Alloc, Storage>::CDataInfo SparseArray<T, Alloc, Storage>::findIf(TP&& p) const
 {
     for (SizeType i = 0; i < m_sparse_size; ++i)
     {
@@ -1151,9 +1297,9 @@ KUN_INLINE typename SparseArray<T, Alloc>::CDataInfo SparseArray<T, Alloc>::find
     }
     return CDataInfo();
 }
-template<typename T, typename Alloc>
+template<typename T, typename Alloc, typename Storage>
 template<typename TP>
-KUN_INLINE typename SparseArray<T, Alloc>::CDataInfo SparseArray<T, Alloc>::findLastIf(TP&& p) const
+KUN_INLINE typename SparseArray<T, Alloc, Storage>::CDataInfo SparseArray<T, Alloc, Storage>::findLastIf(TP&& p) const
 {
     for (SizeType i(m_sparse_size - 1), n(m_sparse_size); n; --i, --n)
     {
@@ -1170,14 +1316,14 @@ KUN_INLINE typename SparseArray<T, Alloc>::CDataInfo SparseArray<T, Alloc>::find
 }
 
 // contain
-template<typename T, typename Alloc> template<typename TK> KUN_INLINE bool SparseArray<T, Alloc>::contain(const TK& v) const { return (bool)find(v); }
-template<typename T, typename Alloc> template<typename TP> KUN_INLINE bool SparseArray<T, Alloc>::containIf(TP&& p) const
+template<typename T, typename Alloc, typename Storage> template<typename TK> KUN_INLINE bool SparseArray<T, Alloc, Storage>::contain(const TK& v) const { return (bool)find(v); }
+template<typename T, typename Alloc, typename Storage> template<typename TP> KUN_INLINE bool SparseArray<T, Alloc, Storage>::containIf(TP&& p) const
 {
     return (bool)findIf(std::forward<TP>(p));
 }
 
 // sort
-template<typename T, typename Alloc> template<typename TP> KUN_INLINE void SparseArray<T, Alloc>::sort(TP&& p)
+template<typename T, typename Alloc, typename Storage> template<typename TP> KUN_INLINE void SparseArray<T, Alloc, Storage>::sort(TP&& p)
 {
     if (m_sparse_size)
     {
@@ -1185,7 +1331,7 @@ template<typename T, typename Alloc> template<typename TP> KUN_INLINE void Spars
         algo::introSort(m_data, m_data + m_sparse_size, [&p](const DataType& a, const DataType& b) { return p(a.data, b.data); });
     }
 }
-template<typename T, typename Alloc> template<typename TP> KUN_INLINE void SparseArray<T, Alloc>::sortStable(TP&& p)
+template<typename T, typename Alloc, typename Storage> template<typename TP> KUN_INLINE void SparseArray<T, Alloc, Storage>::sortStable(TP&& p)
 {
     if (m_sparse_size)
     {
@@ -1195,20 +1341,36 @@ template<typename T, typename Alloc> template<typename TP> KUN_INLINE void Spars
 }
 
 // support foreach
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::It SparseArray<T, Alloc>::begin()
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::It SparseArray<T, Alloc, Storage>::begin()
 {
     return It(m_data, m_sparse_size, m_bit_array);
 }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::It SparseArray<T, Alloc>::end()
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::It SparseArray<T, Alloc, Storage>::end()
 {
     return It(m_data, m_sparse_size, m_bit_array, m_sparse_size);
 }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::CIt SparseArray<T, Alloc>::begin() const
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::CIt SparseArray<T, Alloc, Storage>::begin() const
 {
     return CIt(m_data, m_sparse_size, m_bit_array);
 }
-template<typename T, typename Alloc> KUN_INLINE typename SparseArray<T, Alloc>::CIt SparseArray<T, Alloc>::end() const
+template<typename T, typename Alloc, typename Storage> KUN_INLINE typename SparseArray<T, Alloc, Storage>::CIt SparseArray<T, Alloc, Storage>::end() const
 {
     return CIt(m_data, m_sparse_size, m_bit_array, m_sparse_size);
 }
+
+// parallel foreach
+template<typename T, typename Alloc, typename Storage> template<typename TF> KUN_INLINE void SparseArray<T, Alloc, Storage>::parallelForEach(TF&& func, SizeType grain)
+{
+    algo::parallelForBits(m_sparse_size, grain, [&](SizeType begin, SizeType end) {
+        for (It it(m_data, end, m_bit_array, begin); it; ++it) { func(*it); }
+    });
+}
+template<typename T, typename Alloc, typename Storage>
+template<typename TF>
+KUN_INLINE void SparseArray<T, Alloc, Storage>::parallelForEach(TF&& func, SizeType grain) const
+{
+    algo::parallelForBits(m_sparse_size, grain, [&](SizeType begin, SizeType end) {
+        for (CIt it(m_data, end, m_bit_array, begin); it; ++it) { func(*it); }
+    });
+}
 }// namespace kun
\ No newline at end of file
@@ -1,13 +1,27 @@
 #pragma once
 #include "kun/core/config.h"
 #include "kun/core/std/types.hpp"
+#include "kun/core/std/traits.hpp"
 #include "bit_iterator.hpp"
 
 // SparseArray structs
 namespace kun
 {
+// storage policy
+// default: holes are doubly linked, slot = max(sizeof(T), 2 * sizeof(TS)), any hole can be unlinked in O(1)
+// compact: holes are singly linked, slot = max(sizeof(T), sizeof(TS)), add/removeAt are still O(1), but addAt and compactTop
+//          walk the freelist to unlink holes, suitable for handle tables of small items
+struct SparseArrayStorageDefault
+{
+    static constexpr bool double_link = true;
+};
+struct SparseArrayStorageCompact
+{
+    static constexpr bool double_link = false;
+};
+
 // data def
-template<typename T, typename TS> union SparseArrayData
+template<typename T, typename TS, bool DoubleLink> union SparseArrayData
 {
     // free linked list
     struct
@@ -19,6 +33,17 @@ template<typename T, typename TS> union SparseArrayData
     // data
     T data;
 };
+template<typename T, typename TS> union SparseArrayData<T, TS, false>
+{
+    // free linked list
+    TS next;
+
+    // data
+    T data;
+};
+template<typename T, typename TS, bool DoubleLink> struct is_trivially_relocatable<SparseArrayData<T, TS, DoubleLink>> : is_trivially_relocatable<T>
+{
+};
 // data info
 template<typename T, typename TS> struct SparseArrayDataInfo
 {
@@ -44,10 +69,10 @@ template<typename T, typename TS> struct SparseArrayDataInfo
 // SparseArray iterator
 namespace kun
 {
-template<typename T, typename TS, bool Const> class SparseArrayIt
+template<typename T, typename TS, bool Const, bool DoubleLink> class SparseArrayIt
 {
 public:
-    using DataType = std::conditional_t<Const, const SparseArrayData<T, TS>, SparseArrayData<T, TS>>;
+    using DataType = std::conditional_t<Const, const SparseArrayData<T, TS, DoubleLink>, SparseArrayData<T, TS, DoubleLink>>;
     using ValueType = std::conditional_t<Const, const T, T>;
     using BitItType = TrueBitIt<TS>;
 
@@ -0,0 +1,856 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/std/types.hpp"
+#include "kun/core/std/kstl/algo/functor.hpp"
+#include "kun/core/memory/memory.h"
+#include "kun/core/memory/copy_move_policy.hpp"
+#include "swiss_uset_iterator.hpp"
+#include "fwd.hpp"
+
+// SwissUSet def
+// open addressing hash set, use the same config as USet, but multi key is not supported
+// layout: [slots: capacity * T][ctrl: capacity * i8], slots are grouped by SwissGroup::width and probed group by group
+// every control byte store 7 bits of hash (h2), so most mismatched slots are rejected by one simd compare without touch slot memory
+namespace kun
+{
+template<typename T, typename Config, typename Alloc> class SwissUSet
+{
+public:
+    using SizeType = typename Alloc::SizeType;
+    static constexpr SizeType npos = (SizeType)::kun::npos;
+    using HashType = typename Config::HashType;
+    using KeyType = typename Config::KeyType;
+    using keyMapperType = typename Config::KeyMapperType;
+    using HasherType = typename Config::HasherType;
+    using ComparerType = typename Config::ComparerType;
+    using DataInfo = USetDataInfo<T, SizeType>;
+    using CDataInfo = USetDataInfo<const T, SizeType>;
+    using It = SwissUSetIt<T, SizeType, false>;
+    using CIt = SwissUSetIt<T, SizeType, true>;
+
+    static_assert(!Config::multi_key, "SwissUSet not support multi key");
+    static_assert(!Alloc::has_inline_storage, "SwissUSet not support inline allocator");
+
+    // ctor & dtor
+    SwissUSet(Alloc alloc = Alloc());
+    SwissUSet(SizeType reserve_size, Alloc alloc = Alloc());
+    SwissUSet(const T* p, SizeType n, Alloc alloc = Alloc());
+    SwissUSet(std::initializer_list<T> init_list, Alloc alloc = Alloc());
+    ~SwissUSet();
+
+    // copy & move
+    SwissUSet(const SwissUSet& other, Alloc alloc = Alloc());
+    SwissUSet(SwissUSet&& other);
+
+    // assign & move assign
+    SwissUSet& operator=(const SwissUSet& rhs);
+    SwissUSet& operator=(SwissUSet&& rhs);
+
+    // compare
+    bool operator==(const SwissUSet& rhs) const;
+    bool operator!=(const SwissUSet& rhs) const;
+
+    // getter
+    SizeType     size() const;
+    SizeType     capacity() const;
+    SizeType     slack() const;
+    SizeType     growthLeft() const;
+    bool         empty() const;
+    const i8*    ctrl() const;
+    Alloc&       allocator();
+    const Alloc& allocator() const;
+
+    // validate
+    bool hasData(SizeType idx) const;
+    bool isValidIndex(SizeType idx) const;
+
+    // memory op
+    void clear();
+    void release(SizeType capacity = 0);
+    void reserve(SizeType capacity);
+    void shrink();
+
+    // data op
+    KeyType&       keyOf(T& v) const;
+    const KeyType& keyOf(const T& v) const;
+    bool           keyEqual(const T& a, const T& b) const;
+    HashType       hashOf(const T& v) const;
+
+    // rehash, rebuild control bytes and drop all deleted marks
+    void rehash();
+
+    // add (add or assign)
+    DataInfo add(const T& v);
+    DataInfo add(T&& v);
+    DataInfo addHashed(const T& v, HashType hash);
+    DataInfo addHashed(T&& v, HashType hash);
+
+    // try add (first check existence, then add, never assign)
+    DataInfo tryAdd(const T& v);
+    DataInfo tryAdd(T&& v);
+    DataInfo tryAddHashed(const T& v, HashType hash);
+    DataInfo tryAddHashed(T&& v, HashType hash);
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
+    DataInfo tryAddAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer());
+
+    // emplace
+    template<typename... Args> DataInfo emplace(Args&&... args);
+    template<typename... Args> DataInfo emplaceHashed(HashType hash, Args&&... args);
+
+    // append
+    void append(const SwissUSet& set);
+    void append(std::initializer_list<T> init_list);
+    void append(const T* p, SizeType n);
+
+    // remove
+    SizeType remove(const KeyType& key);
+    SizeType removeHashed(const KeyType& key, HashType hash);
+    void     removeAt(SizeType index);
+
+    // remove as
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
+    SizeType removeAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer());
+
+    // modify
+    T&       operator[](SizeType index);
+    const T& operator[](SizeType index) const;
+
+    // find
+    DataInfo  find(const KeyType& key);
+    CDataInfo find(const KeyType& key) const;
+    DataInfo  findHashed(const KeyType& key, HashType hash);
+    CDataInfo findHashed(const KeyType& key, HashType hash) const;
+
+    // find as
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
+    DataInfo findAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer());
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
+    CDataInfo findAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer()) const;
+
+    // contain
+    bool contain(const KeyType& key) const;
+    bool containHashed(const KeyType& key, HashType hash) const;
+
+    // contain as
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
+    bool containAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer()) const;
+
+    // support foreach
+    It  begin();
+    It  end();
+    CIt begin() const;
+    CIt end() const;
+
+private:
+    // helpers
+    static SizeType _maxLoad(SizeType capacity);
+    static SizeType _calcCapacity(SizeType size);
+    static Size     _mixHash(HashType hash);
+    static i8       _h2(Size mixed_hash);
+    SizeType        _groupMask() const;
+    template<typename TPred> SizeType _findIndex(HashType hash, TPred&& pred) const;
+    SizeType                          _findInsertIndex(HashType hash) const;
+    SizeType                          _prepareInsert(HashType hash);
+    void                              _alloc(SizeType capacity);
+    void                              _free();
+    void                              _resize(SizeType new_capacity);
+
+private:
+    T*                          m_slots;
+    i8*                         m_ctrl;
+    SizeType                    m_size;
+    SizeType                    m_capacity;
+    SizeType                    m_growth_left;
+    KUN_NO_UNIQUE_ADDRESS Alloc m_alloc;
+};
+
+// relocatable as its allocator
+template<typename T, typename Config, typename Alloc> struct is_trivially_relocatable<SwissUSet<T, Config, Alloc>> : is_trivially_relocatable<Alloc>
+{
+};
+}// namespace kun
+
+// SwissUSet impl
+namespace kun
+{
+// helpers
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::SizeType SwissUSet<T, Config, Alloc>::_maxLoad(SizeType capacity)
+{
+    // max load factor 7/8
+    return capacity - capacity / 8;
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::SizeType SwissUSet<T, Config, Alloc>::_calcCapacity(SizeType size)
+{
+    if (size)
+    {
+        SizeType result = SwissGroup::width;
+        while (_maxLoad(result) < size) { result <<= 1; }
+        return result;
+    }
+    else
+    {
+        return 0;
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE Size SwissUSet<T, Config, Alloc>::_mixHash(HashType hash)
+{
+    // user hash may be identity (e.g. integer), spread it before split into h1 & h2
+    u64 result = (u64)hash * 0x9E3779B97F4A7C15ull;
+    return (Size)(result ^ (result >> 32));
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE i8 SwissUSet<T, Config, Alloc>::_h2(Size mixed_hash)
+{
+    return (i8)(mixed_hash & 0x7F);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::SizeType SwissUSet<T, Config, Alloc>::_groupMask() const
+{
+    return m_capacity / SwissGroup::width - 1;
+}
+template<typename T, typename Config, typename Alloc>
+template<typename TPred>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::SizeType SwissUSet<T, Config, Alloc>::_findIndex(HashType hash, TPred&& pred) const
+{
+    if (m_size)
+    {
+        Size     mixed_hash = _mixHash(hash);
+        i8       h2 = _h2(mixed_hash);
+        SizeType group_mask = _groupMask();
+        SizeType group_index = (SizeType)(mixed_hash >> 7) & group_mask;
+
+        // triangular probe, visit every group once when group count is power of 2
+        for (SizeType probe = 0; probe <= group_mask; ++probe)
+        {
+            SizeType   group_begin = group_index * SwissGroup::width;
+            SwissGroup group(m_ctrl + group_begin);
+            for (auto mask = group.match(h2); mask; ++mask)
+            {
+                SizeType index = group_begin + mask.lowest();
+                if (pred(keyOf(m_slots[index])))
+                {
+                    return index;
+                }
+            }
+
+            // empty slot means probe chain end
+            if (group.matchEmpty())
+            {
+                break;
+            }
+            group_index = (group_index + probe + 1) & group_mask;
+        }
+    }
+    return npos;
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::SizeType SwissUSet<T, Config, Alloc>::_findInsertIndex(HashType hash) const
+{
+    KUN_Assert(m_capacity > m_size);
+
+    Size     mixed_hash = _mixHash(hash);
+    SizeType group_mask = _groupMask();
+    SizeType group_index = (SizeType)(mixed_hash >> 7) & group_mask;
+    for (SizeType probe = 0;; ++probe)
+    {
+        SizeType   group_begin = group_index * SwissGroup::width;
+        SwissGroup group(m_ctrl + group_begin);
+        if (auto mask = group.matchEmptyOrDeleted())
+        {
+            return group_begin + mask.lowest();
+        }
+        group_index = (group_index + probe + 1) & group_mask;
+    }
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::SizeType SwissUSet<T, Config, Alloc>::_prepareInsert(HashType hash)
+{
+    SizeType index = m_capacity ? _findInsertIndex(hash) : npos;
+
+    // only empty slot consume growth, deleted slot can be reused freely
+    if (index == npos || (m_growth_left == 0 && SwissCtrl::isEmpty(m_ctrl[index])))
+    {
+        // too many deleted slots, rebuild in place, otherwise grow
+        SizeType new_size = m_size + 1;
+        _resize(new_size <= _maxLoad(m_capacity) / 2 ? m_capacity : _calcCapacity(new_size));
+        index = _findInsertIndex(hash);
+    }
+
+    m_growth_left -= SwissCtrl::isEmpty(m_ctrl[index]) ? 1 : 0;
+    m_ctrl[index] = _h2(_mixHash(hash));
+    ++m_size;
+    return index;
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void SwissUSet<T, Config, Alloc>::_alloc(SizeType capacity)
+{
+    KUN_Assert(capacity % SwissGroup::width == 0);
+
+    m_slots = (T*)m_alloc.allocRaw(capacity * sizeof(T) + capacity, alignof(T));
+    m_ctrl = reinterpret_cast<i8*>(m_slots + capacity);
+    m_capacity = capacity;
+    m_growth_left = _maxLoad(capacity);
+    memory::memset(m_ctrl, (u8)SwissCtrl::empty, capacity);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void SwissUSet<T, Config, Alloc>::_free()
+{
+    if (m_slots)
+    {
+        m_alloc.free(m_slots);
+        m_slots = nullptr;
+        m_ctrl = nullptr;
+        m_capacity = 0;
+        m_growth_left = 0;
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void SwissUSet<T, Config, Alloc>::_resize(SizeType new_capacity)
+{
+    KUN_Assert(_maxLoad(new_capacity) >= m_size);
+
+    T*       old_slots = m_slots;
+    i8*      old_ctrl = m_ctrl;
+    SizeType old_capacity = m_capacity;
+
+    // alloc new memory
+    if (new_capacity)
+    {
+        _alloc(new_capacity);
+    }
+    else
+    {
+        m_slots = nullptr;
+        m_ctrl = nullptr;
+        m_capacity = 0;
+        m_growth_left = 0;
+    }
+
+    // move items
+    if (old_slots)
+    {
+        for (SizeType i = 0; i < old_capacity; ++i)
+        {
+            if (SwissCtrl::isFull(old_ctrl[i]))
+            {
+                HashType hash = hashOf(old_slots[i]);
+                SizeType index = _findInsertIndex(hash);
+                m_ctrl[index] = _h2(_mixHash(hash));
+                new (m_slots + index) T(std::move(old_slots[i]));
+                memory::destructItem(old_slots + i, 1);
+            }
+        }
+        m_growth_left -= m_size;
+        m_alloc.free(old_slots);
+    }
+}
+
+// ctor & dtor
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE SwissUSet<T, Config, Alloc>::SwissUSet(Alloc alloc)
+    : m_slots(nullptr)
+    , m_ctrl(nullptr)
+    , m_size(0)
+    , m_capacity(0)
+    , m_growth_left(0)
+    , m_alloc(std::move(alloc))
+{
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE SwissUSet<T, Config, Alloc>::SwissUSet(SizeType reserve_size, Alloc alloc)
+    : SwissUSet(std::move(alloc))
+{
+    reserve(reserve_size);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE SwissUSet<T, Config, Alloc>::SwissUSet(const T* p, SizeType n, Alloc alloc)
+    : SwissUSet(std::move(alloc))
+{
+    append(p, n);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE SwissUSet<T, Config, Alloc>::SwissUSet(std::initializer_list<T> init_list, Alloc alloc)
+    : SwissUSet(std::move(alloc))
+{
+    append(init_list);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE SwissUSet<T, Config, Alloc>::~SwissUSet() { release(); }
+
+// copy & move
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE SwissUSet<T, Config, Alloc>::SwissUSet(const SwissUSet& other, Alloc alloc)
+    : SwissUSet(std::move(alloc))
+{
+    *this = other;
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE SwissUSet<T, Config, Alloc>::SwissUSet(SwissUSet&& other)
+    : m_slots(other.m_slots)
+    , m_ctrl(other.m_ctrl)
+    , m_size(other.m_size)
+    , m_capacity(other.m_capacity)
+    , m_growth_left(other.m_growth_left)
+    , m_alloc(std::move(other.m_alloc))
+{
+    other.m_slots = nullptr;
+    other.m_ctrl = nullptr;
+    other.m_size = 0;
+    other.m_capacity = 0;
+    other.m_growth_left = 0;
+}
+
+// assign & move assign
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE SwissUSet<T, Config, Alloc>& SwissUSet<T, Config, Alloc>::operator=(const SwissUSet& rhs)
+{
+    if (this != &rhs)
+    {
+        // clear
+        clear();
+
+        if (!rhs.empty())
+        {
+            // realloc memory
+            if (m_capacity != rhs.m_capacity)
+            {
+                _free();
+                _alloc(rhs.m_capacity);
+            }
+
+            // copy ctrl, the probe sequence is only decided by capacity, so layout can be reused
+            memory::memcpy(m_ctrl, rhs.m_ctrl, m_capacity);
+            for (SizeType i = 0; i < m_capacity; ++i)
+            {
+                if (SwissCtrl::isFull(m_ctrl[i]))
+                {
+                    new (m_slots + i) T(rhs.m_slots[i]);
+                }
+            }
+            m_size = rhs.m_size;
+            m_growth_left = rhs.m_growth_left;
+        }
+    }
+    return *this;
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE SwissUSet<T, Config, Alloc>& SwissUSet<T, Config, Alloc>::operator=(SwissUSet&& rhs)
+{
+    if (this != &rhs)
+    {
+        // release
+        release();
+
+        // move data
+        m_slots = rhs.m_slots;
+        m_ctrl = rhs.m_ctrl;
+        m_size = rhs.m_size;
+        m_capacity = rhs.m_capacity;
+        m_growth_left = rhs.m_growth_left;
+        m_alloc = std::move(rhs.m_alloc);
+
+        // clean up rhs
+        rhs.m_slots = nullptr;
+        rhs.m_ctrl = nullptr;
+        rhs.m_size = 0;
+        rhs.m_capacity = 0;
+        rhs.m_growth_left = 0;
+    }
+    return *this;
+}
+
+// compare
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool SwissUSet<T, Config, Alloc>::operator==(const SwissUSet& rhs) const
+{
+    if (size() == rhs.size())
+    {
+        for (const auto& v : rhs)
+        {
+            if (!contain(keyOf(v)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool SwissUSet<T, Config, Alloc>::operator!=(const SwissUSet& rhs) const
+{
+    return !(*this == rhs);
+}
+
+// getter
+template<typename T, typename Config, typename Alloc> typename SwissUSet<T, Config, Alloc>::SizeType SwissUSet<T, Config, Alloc>::size() const
+{
+    return m_size;
+}
+template<typename T, typename Config, typename Alloc> typename SwissUSet<T, Config, Alloc>::SizeType SwissUSet<T, Config, Alloc>::capacity() const
+{
+    return m_capacity;
+}
+template<typename T, typename Config, typename Alloc> typename SwissUSet<T, Config, Alloc>::SizeType SwissUSet<T, Config, Alloc>::slack() const
+{
+    return m_capacity - m_size;
+}
+template<typename T, typename Config, typename Alloc> typename SwissUSet<T, Config, Alloc>::SizeType SwissUSet<T, Config, Alloc>::growthLeft() const
+{
+    return m_growth_left;
+}
+template<typename T, typename Config, typename Alloc> bool         SwissUSet<T, Config, Alloc>::empty() const { return m_size == 0; }
+template<typename T, typename Config, typename Alloc> const i8*    SwissUSet<T, Config, Alloc>::ctrl() const { return m_ctrl; }
+template<typename T, typename Config, typename Alloc> Alloc&       SwissUSet<T, Config, Alloc>::allocator() { return m_alloc; }
+template<typename T, typename Config, typename Alloc> const Alloc& SwissUSet<T, Config, Alloc>::allocator() const { return m_alloc; }
+
+// validate
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool SwissUSet<T, Config, Alloc>::hasData(SizeType idx) const
+{
+    return isValidIndex(idx) && SwissCtrl::isFull(m_ctrl[idx]);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool SwissUSet<T, Config, Alloc>::isValidIndex(SizeType idx) const
+{
+    return idx < m_capacity;
+}
+
+// memory op
+template<typename T, typename Config, typename Alloc> KUN_INLINE void SwissUSet<T, Config, Alloc>::clear()
+{
+    if (m_size)
+    {
+        for (SizeType i = 0; i < m_capacity; ++i)
+        {
+            if (SwissCtrl::isFull(m_ctrl[i]))
+            {
+                memory::destructItem(m_slots + i, 1);
+            }
+        }
+        m_size = 0;
+    }
+    if (m_ctrl)
+    {
+        memory::memset(m_ctrl, (u8)SwissCtrl::empty, m_capacity);
+        m_growth_left = _maxLoad(m_capacity);
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void SwissUSet<T, Config, Alloc>::release(SizeType capacity)
+{
+    clear();
+    _free();
+    if (capacity)
+    {
+        _alloc(_calcCapacity(capacity));
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void SwissUSet<T, Config, Alloc>::reserve(SizeType capacity)
+{
+    if (capacity > m_size + m_growth_left)
+    {
+        _resize(_calcCapacity(capacity));
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void SwissUSet<T, Config, Alloc>::shrink()
+{
+    SizeType new_capacity = _calcCapacity(m_size);
+    if (new_capacity < m_capacity)
+    {
+        _resize(new_capacity);
+    }
+}
+
+// data op
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename SwissUSet<T, Config, Alloc>::KeyType& SwissUSet<T, Config, Alloc>::keyOf(T& v) const
+{
+    return keyMapperType()(v);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE const typename SwissUSet<T, Config, Alloc>::KeyType& SwissUSet<T, Config, Alloc>::keyOf(const T& v) const
+{
+    return keyMapperType()(v);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool SwissUSet<T, Config, Alloc>::keyEqual(const T& a, const T& b) const
+{
+    return ComparerType()(keyOf(a), keyOf(b));
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::HashType SwissUSet<T, Config, Alloc>::hashOf(const T& v) const
+{
+    return HasherType()(keyOf(v));
+}
+
+// rehash
+template<typename T, typename Config, typename Alloc> KUN_INLINE void SwissUSet<T, Config, Alloc>::rehash() { _resize(m_capacity); }
+
+// add (add or assign)
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::add(const T& v)
+{
+    return addHashed(v, hashOf(v));
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::add(T&& v)
+{
+    HashType hash = hashOf(v);
+    return addHashed(std::move(v), hash);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::addHashed(const T& v, HashType hash)
+{
+    KUN_Assert(hashOf(v) == hash);
+
+    if (DataInfo info = findHashed(keyOf(v), hash))
+    {
+        // cover the old data
+        *info.data = v;
+        info.already_exist = true;
+        return info;
+    }
+
+    SizeType index = _prepareInsert(hash);
+    new (m_slots + index) T(v);
+    return DataInfo(m_slots + index, index);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::addHashed(T&& v, HashType hash)
+{
+    KUN_Assert(hashOf(v) == hash);
+
+    if (DataInfo info = findHashed(keyOf(v), hash))
+    {
+        // cover the old data
+        *info.data = std::move(v);
+        info.already_exist = true;
+        return info;
+    }
+
+    SizeType index = _prepareInsert(hash);
+    new (m_slots + index) T(std::move(v));
+    return DataInfo(m_slots + index, index);
+}
+
+// try add (first check existence, then add, never assign)
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::tryAdd(const T& v)
+{
+    return tryAddHashed(v, hashOf(v));
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::tryAdd(T&& v)
+{
+    HashType hash = hashOf(v);
+    return tryAddHashed(std::move(v), hash);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::tryAddHashed(const T& v, HashType hash)
+{
+    if (DataInfo info = findHashed(keyOf(v), hash))
+    {
+        info.already_exist = true;
+        return info;
+    }
+
+    SizeType index = _prepareInsert(hash);
+    new (m_slots + index) T(v);
+    return DataInfo(m_slots + index, index);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::tryAddHashed(T&& v, HashType hash)
+{
+    if (DataInfo info = findHashed(keyOf(v), hash))
+    {
+        info.already_exist = true;
+        return info;
+    }
+
+    SizeType index = _prepareInsert(hash);
+    new (m_slots + index) T(std::move(v));
+    return DataInfo(m_slots + index, index);
+}
+template<typename T, typename Config, typename Alloc>
+template<typename AsType, typename AsHasher, typename AsComparer>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::tryAddAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer)
+{
+    HashType hash = hasher(v);
+    SizeType index = _findIndex(hash, [&](const KeyType& key) { return comparer(key, v); });
+    if (index != npos)
+    {
+        return DataInfo(m_slots + index, index, true);
+    }
+
+    index = _prepareInsert(hash);
+    new (m_slots + index) T(std::forward<AsType>(v));
+    KUN_Assert(hashOf(m_slots[index]) == hash);
+    return DataInfo(m_slots + index, index);
+}
+
+// emplace
+template<typename T, typename Config, typename Alloc>
+template<typename... Args>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::emplace(Args&&... args)
+{
+    // key is unknown before construct, so build a temporary item
+    T v(std::forward<Args>(args)...);
+    return add(std::move(v));
+}
+template<typename T, typename Config, typename Alloc>
+template<typename... Args>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::emplaceHashed(HashType hash, Args&&... args)
+{
+    T v(std::forward<Args>(args)...);
+    return addHashed(std::move(v), hash);
+}
+
+// append
+template<typename T, typename Config, typename Alloc> KUN_INLINE void SwissUSet<T, Config, Alloc>::append(const SwissUSet& set)
+{
+    reserve(m_size + set.size());
+    for (const auto& v : set) { add(v); }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void SwissUSet<T, Config, Alloc>::append(std::initializer_list<T> init_list)
+{
+    reserve(m_size + (SizeType)init_list.size());
+    for (const auto& v : init_list) { add(v); }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void SwissUSet<T, Config, Alloc>::append(const T* p, SizeType n)
+{
+    reserve(m_size + n);
+    for (SizeType i = 0; i < n; ++i) { add(p[i]); }
+}
+
+// remove
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::SizeType SwissUSet<T, Config, Alloc>::remove(const KeyType& key)
+{
+    return removeHashed(key, HasherType()(key));
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::SizeType SwissUSet<T, Config, Alloc>::removeHashed(const KeyType& key, HashType hash)
+{
+    KUN_Assert(HasherType()(key) == hash);
+
+    SizeType index = _findIndex(hash, [&](const KeyType& k) { return ComparerType()(k, key); });
+    if (index != npos)
+    {
+        removeAt(index);
+    }
+    return index;
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void SwissUSet<T, Config, Alloc>::removeAt(SizeType index)
+{
+    KUN_Assert(hasData(index));
+
+    memory::destructItem(m_slots + index, 1);
+    --m_size;
+
+    // if the group still has empty slot, no probe chain can pass through it, so mark as empty directly
+    SizeType group_begin = index - index % SwissGroup::width;
+    if (SwissGroup(m_ctrl + group_begin).matchEmpty())
+    {
+        m_ctrl[index] = SwissCtrl::empty;
+        ++m_growth_left;
+    }
+    else
+    {
+        m_ctrl[index] = SwissCtrl::deleted;
+    }
+}
+
+// remove as
+template<typename T, typename Config, typename Alloc>
+template<typename AsType, typename AsHasher, typename AsComparer>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::SizeType SwissUSet<T, Config, Alloc>::removeAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer)
+{
+    SizeType index = _findIndex(hasher(v), [&](const KeyType& key) { return comparer(key, v); });
+    if (index != npos)
+    {
+        removeAt(index);
+    }
+    return index;
+}
+
+// modify
+template<typename T, typename Config, typename Alloc> KUN_INLINE T& SwissUSet<T, Config, Alloc>::operator[](SizeType index)
+{
+    KUN_Assert(hasData(index));
+    return m_slots[index];
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE const T& SwissUSet<T, Config, Alloc>::operator[](SizeType index) const
+{
+    KUN_Assert(hasData(index));
+    return m_slots[index];
+}
+
+// find
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::find(const KeyType& key)
+{
+    return findHashed(key, HasherType()(key));
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::CDataInfo SwissUSet<T, Config, Alloc>::find(const KeyType& key) const
+{
+    DataInfo info = const_cast<SwissUSet*>(this)->find(key);
+    return CDataInfo(info.data, info.index);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::findHashed(const KeyType& key, HashType hash)
+{
+    KUN_Assert(HasherType()(key) == hash);
+
+    SizeType index = _findIndex(hash, [&](const KeyType& k) { return ComparerType()(k, key); });
+    return index != npos ? DataInfo(m_slots + index, index) : DataInfo();
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::CDataInfo SwissUSet<T, Config, Alloc>::findHashed(const KeyType& key, HashType hash) const
+{
+    DataInfo info = const_cast<SwissUSet*>(this)->findHashed(key, hash);
+    return CDataInfo(info.data, info.index);
+}
+
+// find as
+template<typename T, typename Config, typename Alloc>
+template<typename AsType, typename AsHasher, typename AsComparer>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::DataInfo SwissUSet<T, Config, Alloc>::findAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer)
+{
+    SizeType index = _findIndex(hasher(v), [&](const KeyType& key) { return comparer(key, v); });
+    return index != npos ? DataInfo(m_slots + index, index) : DataInfo();
+}
+template<typename T, typename Config, typename Alloc>
+template<typename AsType, typename AsHasher, typename AsComparer>
+KUN_INLINE typename SwissUSet<T, Config, Alloc>::CDataInfo SwissUSet<T, Config, Alloc>::findAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer) const
+{
+    DataInfo info = const_cast<SwissUSet*>(this)->findAs(std::forward<AsType>(v), std::forward<AsHasher>(hasher), std::forward<AsComparer>(comparer));
+    return CDataInfo(info.data, info.index);
+}
+
+// contain
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool SwissUSet<T, Config, Alloc>::contain(const KeyType& key) const
+{
+    return (bool)find(key);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool SwissUSet<T, Config, Alloc>::containHashed(const KeyType& key, HashType hash) const
+{
+    return (bool)findHashed(key, hash);
+}
+
+// contain as
+template<typename T, typename Config, typename Alloc>
+template<typename AsType, typename AsHasher, typename AsComparer>
+KUN_INLINE bool SwissUSet<T, Config, Alloc>::containAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer) const
+{
+    return (bool)findAs(std::forward<AsType>(v), std::forward<AsHasher>(hasher), std::forward<AsComparer>(comparer));
+}
+
+// support foreach
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename SwissUSet<T, Config, Alloc>::It SwissUSet<T, Config, Alloc>::begin()
+{
+    return It(m_ctrl, m_slots, m_capacity);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename SwissUSet<T, Config, Alloc>::It SwissUSet<T, Config, Alloc>::end()
+{
+    return It(m_ctrl, m_slots, m_capacity, m_capacity);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename SwissUSet<T, Config, Alloc>::CIt SwissUSet<T, Config, Alloc>::begin() const
+{
+    return CIt(m_ctrl, m_slots, m_capacity);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE typename SwissUSet<T, Config, Alloc>::CIt SwissUSet<T, Config, Alloc>::end() const
+{
+    return CIt(m_ctrl, m_slots, m_capacity, m_capacity);
+}
+}// namespace kun
@@ -0,0 +1,149 @@
+#pragma once
+#include "kun/core/config.h"
+#include "kun/core/std/types.hpp"
+#include "kun/core/math/basic.h"
+#include "uset_iterator.hpp"
+#include <cstring>
+#if KUN_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+// SwissUSet structs
+namespace kun
+{
+// control byte, full slot store the low 7 bits of hash (h2), so full slot is always >= 0
+struct SwissCtrl
+{
+    static constexpr i8 empty = -128;// 0b10000000
+    static constexpr i8 deleted = -2;// 0b11111110
+
+    KUN_INLINE static constexpr bool isFull(i8 ctrl) { return ctrl >= 0; }
+    KUN_INLINE static constexpr bool isEmpty(i8 ctrl) { return ctrl == empty; }
+    KUN_INLINE static constexpr bool isDeleted(i8 ctrl) { return ctrl == deleted; }
+};
+
+// bit mask of group match result, every matched slot take (1 << Shift) bits
+template<typename TMask, u32 Shift> struct SwissBitMask
+{
+    TMask mask;
+
+    KUN_INLINE explicit SwissBitMask(TMask mask)
+        : mask(mask)
+    {
+    }
+
+    // impl cpp iterator
+    KUN_INLINE explicit operator bool() const { return mask != 0; }
+    KUN_INLINE u32      operator*() const { return lowest(); }
+    KUN_INLINE SwissBitMask& operator++()
+    {
+        mask &= mask - 1;
+        return *this;
+    }
+
+    // slot index in group
+    KUN_INLINE u32 lowest() const { return (u32)bitTailZero(mask) >> Shift; }
+};
+
+#if KUN_SIMD_SSE2
+// sse2 group, match 16 control bytes per probe
+struct SwissGroup
+{
+    using BitMaskType = SwissBitMask<u32, 0>;
+    static constexpr u32 width = 16;
+
+    KUN_INLINE explicit SwissGroup(const i8* ctrl)
+        : m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+    {
+    }
+
+    // match full slots that h2 equals to hash
+    KUN_INLINE BitMaskType match(i8 h2) const
+    {
+        return BitMaskType((u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)));
+    }
+    KUN_INLINE BitMaskType matchEmpty() const
+    {
+        return BitMaskType((u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(SwissCtrl::empty), m_ctrl)));
+    }
+    // empty and deleted slot have the sign bit
+    KUN_INLINE BitMaskType matchEmptyOrDeleted() const { return BitMaskType((u32)_mm_movemask_epi8(m_ctrl)); }
+
+private:
+    __m128i m_ctrl;
+};
+#else
+// portable group, match 8 control bytes per probe by bit tricks
+// match() may report false positive, but caller always compare the key
+struct SwissGroup
+{
+    using BitMaskType = SwissBitMask<u64, 3>;
+    static constexpr u32 width = 8;
+
+    KUN_INLINE explicit SwissGroup(const i8* ctrl) { std::memcpy(&m_ctrl, ctrl, sizeof(u64)); }
+
+    // match full slots that h2 equals to hash
+    KUN_INLINE BitMaskType match(i8 h2) const
+    {
+        constexpr u64 lsbs = 0x0101010101010101ull;
+        u64           x = m_ctrl ^ (lsbs * (u8)h2);
+        return BitMaskType((x - lsbs) & ~x & _msbs);
+    }
+    KUN_INLINE BitMaskType matchEmpty() const { return BitMaskType((m_ctrl & ~(m_ctrl << 6)) & _msbs); }
+    // empty and deleted slot have the sign bit
+    KUN_INLINE BitMaskType matchEmptyOrDeleted() const { return BitMaskType(m_ctrl & _msbs); }
+
+private:
+    static constexpr u64 _msbs = 0x8080808080808080ull;
+    u64                  m_ctrl;
+};
+#endif
+}// namespace kun
+
+// SwissUSet iterator
+namespace kun
+{
+template<typename T, typename TS, bool Const> class SwissUSetIt
+{
+public:
+    using ValueType = std::conditional_t<Const, const T, T>;
+
+    KUN_INLINE explicit SwissUSetIt(const i8* ctrl, ValueType* slots, TS capacity, TS start = 0)
+        : m_ctrl(ctrl)
+        , m_slots(slots)
+        , m_capacity(capacity)
+        , m_index(start)
+    {
+        _skipToFull();
+    }
+
+    // impl cpp iterator
+    KUN_INLINE SwissUSetIt& operator++()
+    {
+        ++m_index;
+        _skipToFull();
+        return *this;
+    }
+    KUN_INLINE bool       operator==(const SwissUSetIt& rhs) const { return m_index == rhs.m_index && m_slots == rhs.m_slots; }
+    KUN_INLINE bool       operator!=(const SwissUSetIt& rhs) const { return !(*this == rhs); }
+    KUN_INLINE            operator bool() const { return m_index < m_capacity; }
+    KUN_INLINE bool       operator!() const { return !(bool)*this; }
+    KUN_INLINE ValueType& operator*() const { return m_slots[m_index]; }
+    KUN_INLINE ValueType* operator->() const { return &m_slots[m_index]; }
+
+    // other data
+    KUN_INLINE TS index() const { return m_index; }
+
+private:
+    KUN_INLINE void _skipToFull()
+    {
+        while (m_index < m_capacity && !SwissCtrl::isFull(m_ctrl[m_index])) { ++m_index; }
+    }
+
+private:
+    const i8*  m_ctrl;
+    ValueType* m_slots;
+    TS         m_capacity;
+    TS         m_index;
+};
+}// namespace kun
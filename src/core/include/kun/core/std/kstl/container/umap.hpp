@@ -2,9 +2,219 @@
 #include "kun/core/config.h"
 #include "kun/core/std/types.hpp"
 #include "kun/core/std/kstl/kvpair.hpp"
+#include "uset.hpp"
 #include "fwd.hpp"
 
+// UMap config
 namespace kun
 {
+template<typename K, typename V, bool MultiKey> struct UMapConfigDefault
+{
+    using KeyType = K;
+    using KeyMapperType = MapKVPairKey<K, V>;
+    using HashType = Size;
+    using HasherType = Hash<KeyType>;
+    using ComparerType = Equal<KeyType>;
+
+    static constexpr bool multi_key = MultiKey;
+    static constexpr bool use_bucket_tag = true;
+    static constexpr bool incremental_rehash = false;
+};
+}// namespace kun
+
+// UMap def
+namespace kun
+{
+template<typename K, typename V, typename Config, typename Alloc> class UMap : public USet<KVPair<K, V>, Config, Alloc>
+{
+    using Super = USet<KVPair<K, V>, Config, Alloc>;
+
+public:
+    using PairType = KVPair<K, V>;
+    using typename Super::SizeType;
+    using typename Super::HashType;
+    using typename Super::KeyType;
+    using typename Super::HasherType;
+    using typename Super::DataInfo;
+    using typename Super::CDataInfo;
+
+    // ctor & dtor
+    UMap(Alloc alloc = Alloc());
+    UMap(SizeType reserve_size, Alloc alloc = Alloc());
+    UMap(const PairType* p, SizeType n, Alloc alloc = Alloc());
+    UMap(std::initializer_list<PairType> init_list, Alloc alloc = Alloc());
+    ~UMap();
+
+    // copy & move
+    UMap(const UMap& other, Alloc alloc = Alloc());
+    UMap(UMap&& other);
+
+    // assign & move assign
+    UMap& operator=(const UMap& rhs);
+    UMap& operator=(UMap&& rhs);
+
+    // add (add or assign value)
+    using Super::add;
+    using Super::addHashed;
+    template<typename TK, typename TV> DataInfo add(TK&& key, TV&& value);
+    template<typename TK, typename TV> DataInfo addHashed(TK&& key, TV&& value, HashType hash);
+
+    // add anyway (add but never check existence)
+    using Super::addAnyway;
+    using Super::addAnywayHashed;
+    template<typename TK, typename TV> DataInfo addAnyway(TK&& key, TV&& value);
+    template<typename TK, typename TV> DataInfo addAnywayHashed(TK&& key, TV&& value, HashType hash);
+
+    // try add (first check existence, then add, never assign)
+    using Super::tryAdd;
+    using Super::tryAddHashed;
+    template<typename TK, typename TV> DataInfo tryAdd(TK&& key, TV&& value);
+    template<typename TK, typename TV> DataInfo tryAddHashed(TK&& key, TV&& value, HashType hash);
+
+    // find value
+    V*       findValue(const KeyType& key);
+    const V* findValue(const KeyType& key) const;
+    V*       findValueHashed(const KeyType& key, HashType hash);
+    const V* findValueHashed(const KeyType& key, HashType hash) const;
+};
+
+// relocatable as its allocator
+template<typename K, typename V, typename Config, typename Alloc> struct is_trivially_relocatable<UMap<K, V, Config, Alloc>> : is_trivially_relocatable<Alloc>
+{
+};
+}// namespace kun
+
+// UMap impl
+namespace kun
+{
+// ctor & dtor
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE UMap<K, V, Config, Alloc>::UMap(Alloc alloc)
+    : Super(std::move(alloc))
+{
+}
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE UMap<K, V, Config, Alloc>::UMap(SizeType reserve_size, Alloc alloc)
+    : Super(reserve_size, std::move(alloc))
+{
+}
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE UMap<K, V, Config, Alloc>::UMap(const PairType* p, SizeType n, Alloc alloc)
+    : Super(p, n, std::move(alloc))
+{
+}
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE UMap<K, V, Config, Alloc>::UMap(std::initializer_list<PairType> init_list, Alloc alloc)
+    : Super(init_list, std::move(alloc))
+{
+}
+template<typename K, typename V, typename Config, typename Alloc> KUN_INLINE UMap<K, V, Config, Alloc>::~UMap() = default;
+
+// copy & move
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE UMap<K, V, Config, Alloc>::UMap(const UMap& other, Alloc alloc)
+    : Super(other, std::move(alloc))
+{
+}
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE UMap<K, V, Config, Alloc>::UMap(UMap&& other)
+    : Super(std::move(other))
+{
+}
+
+// assign & move assign
+template<typename K, typename V, typename Config, typename Alloc> KUN_INLINE UMap<K, V, Config, Alloc>& UMap<K, V, Config, Alloc>::operator=(const UMap& rhs)
+{
+    Super::operator=(rhs);
+    return *this;
+}
+template<typename K, typename V, typename Config, typename Alloc> KUN_INLINE UMap<K, V, Config, Alloc>& UMap<K, V, Config, Alloc>::operator=(UMap&& rhs)
+{
+    Super::operator=(std::move(rhs));
+    return *this;
+}
+
+// add (add or assign value)
+template<typename K, typename V, typename Config, typename Alloc>
+template<typename TK, typename TV>
+KUN_INLINE typename UMap<K, V, Config, Alloc>::DataInfo UMap<K, V, Config, Alloc>::add(TK&& key, TV&& value)
+{
+    HashType hash = HasherType()(key);
+    return addHashed(std::forward<TK>(key), std::forward<TV>(value), hash);
+}
+template<typename K, typename V, typename Config, typename Alloc>
+template<typename TK, typename TV>
+KUN_INLINE typename UMap<K, V, Config, Alloc>::DataInfo UMap<K, V, Config, Alloc>::addHashed(TK&& key, TV&& value, HashType hash)
+{
+    if constexpr (!Config::multi_key)
+    {
+        // assign value only, key is already equal
+        if (DataInfo info = Super::findHashed(key, hash))
+        {
+            info->value = std::forward<TV>(value);
+            info.already_exist = true;
+            return info;
+        }
+    }
+    return Super::emplaceAnywayHashed(hash, std::forward<TK>(key), std::forward<TV>(value));
+}
 
-}
\ No newline at end of file
+// add anyway (add but never check existence)
+template<typename K, typename V, typename Config, typename Alloc>
+template<typename TK, typename TV>
+KUN_INLINE typename UMap<K, V, Config, Alloc>::DataInfo UMap<K, V, Config, Alloc>::addAnyway(TK&& key, TV&& value)
+{
+    HashType hash = HasherType()(key);
+    return Super::emplaceAnywayHashed(hash, std::forward<TK>(key), std::forward<TV>(value));
+}
+template<typename K, typename V, typename Config, typename Alloc>
+template<typename TK, typename TV>
+KUN_INLINE typename UMap<K, V, Config, Alloc>::DataInfo UMap<K, V, Config, Alloc>::addAnywayHashed(TK&& key, TV&& value, HashType hash)
+{
+    return Super::emplaceAnywayHashed(hash, std::forward<TK>(key), std::forward<TV>(value));
+}
+
+// try add (first check existence, then add, never assign)
+template<typename K, typename V, typename Config, typename Alloc>
+template<typename TK, typename TV>
+KUN_INLINE typename UMap<K, V, Config, Alloc>::DataInfo UMap<K, V, Config, Alloc>::tryAdd(TK&& key, TV&& value)
+{
+    HashType hash = HasherType()(key);
+    return tryAddHashed(std::forward<TK>(key), std::forward<TV>(value), hash);
+}
+template<typename K, typename V, typename Config, typename Alloc>
+template<typename TK, typename TV>
+KUN_INLINE typename UMap<K, V, Config, Alloc>::DataInfo UMap<K, V, Config, Alloc>::tryAddHashed(TK&& key, TV&& value, HashType hash)
+{
+    if (DataInfo info = Super::findHashed(key, hash))
+    {
+        info.already_exist = true;
+        return info;
+    }
+    return Super::emplaceAnywayHashed(hash, std::forward<TK>(key), std::forward<TV>(value));
+}
+
+// find value
+template<typename K, typename V, typename Config, typename Alloc> KUN_INLINE V* UMap<K, V, Config, Alloc>::findValue(const KeyType& key)
+{
+    DataInfo info = Super::find(key);
+    return info ? &info->value : nullptr;
+}
+template<typename K, typename V, typename Config, typename Alloc> KUN_INLINE const V* UMap<K, V, Config, Alloc>::findValue(const KeyType& key) const
+{
+    CDataInfo info = Super::find(key);
+    return info ? &info->value : nullptr;
+}
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE V* UMap<K, V, Config, Alloc>::findValueHashed(const KeyType& key, HashType hash)
+{
+    DataInfo info = Super::findHashed(key, hash);
+    return info ? &info->value : nullptr;
+}
+template<typename K, typename V, typename Config, typename Alloc>
+KUN_INLINE const V* UMap<K, V, Config, Alloc>::findValueHashed(const KeyType& key, HashType hash) const
+{
+    CDataInfo info = Super::findHashed(key, hash);
+    return info ? &info->value : nullptr;
+}
+}// namespace kun
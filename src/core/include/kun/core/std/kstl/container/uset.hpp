@@ -2,6 +2,9 @@
 #include "kun/core/config.h"
 #include "kun/core/std/types.hpp"
 #include "kun/core/std/kstl/algo/functor.hpp"
+#include "kun/core/std/kstl/algo/parallel.hpp"
+#include "kun/core/std/kstl/span.hpp"
+#include "kun/core/memory/memory.h"
 #include "sparse_array.hpp"
 #include "uset_iterator.hpp"
 #include "fwd.hpp"
@@ -18,6 +21,8 @@ template<typename T, bool MultiKey> struct USetConfigDefault
     using ComparerType = Equal<KeyType>;
 
     static constexpr bool multi_key = MultiKey;
+    static constexpr bool use_bucket_tag = true;      // see USet::BucketTagType
+    static constexpr bool incremental_rehash = false;// see USet::rehashStep()
 };
 }// namespace kun
 
@@ -28,6 +33,7 @@ template<typename T, typename Config, typename Alloc> class USet
 {
 public:
     using SizeType = typename Alloc::SizeType;
+    static constexpr SizeType npos = (SizeType)::kun::npos;
     using HashType = typename Config::HashType;
     using KeyType = typename Config::KeyType;
     using keyMapperType = typename Config::KeyMapperType;
@@ -40,6 +46,10 @@ public:
     using It = USetIt<T, SizeType, HashType, false>;
     using CIt = USetIt<T, SizeType, HashType, true>;
 
+    // per bucket 16 bits bloom filter of hashes in the chain, lookup test it before load bucket and chain data
+    // so most missed lookup only touch one tag, and removal will rebuild the tag of the chain
+    using BucketTagType = u16;
+
     // ctor & dtor
     USet(Alloc alloc = Alloc());
     USet(SizeType reserve_size, Alloc alloc = Alloc());
@@ -73,8 +83,9 @@ public:
     bool            empty() const;
     DataArr&        data();
     const DataArr&  data() const;
-    SizeType*       bucket();
-    const SizeType* bucket() const;
+    SizeType*            bucket();
+    const SizeType*      bucket() const;
+    const BucketTagType* bucketTag() const;
     Alloc&          allocator();
     const Alloc&    allocator() const;
 
@@ -101,8 +112,18 @@ public:
 
     // rehash
     bool needRehash() const;
-    void rehash() const;
-    bool rehashIfNeed() const;
+    void rehash();
+    bool rehashIfNeed();
+
+    // incremental rehash, enabled by Config::incremental_rehash
+    // when bucket need resize, a new bucket is allocated and the old one is kept, then every add/remove migrate at most
+    // incremental_rehash_step elements and visit at most incremental_rehash_step empty old buckets, lookups consult both
+    // bucket until migration done, so the worst cost of a mutating op is O(incremental_rehash_step) instead of O(size)
+    // if bucket need resize again before migration done, the remaining migration will be finished at once
+    // NOTE: the element storage (SparseArray) still grow by relocation, reserve() ahead if that matters
+    static constexpr SizeType incremental_rehash_step = 8;
+    bool                      isRehashing() const;
+    bool                      rehashStep(SizeType max_step = incremental_rehash_step);
 
     // per element hash op
     bool     isInBucket(SizeType index) const;
@@ -127,7 +148,7 @@ public:
     DataInfo tryAdd(T&& v);
     DataInfo tryAddHashed(const T& v, HashType hash);
     DataInfo tryAddHashed(T&& v, HashType hash);
-    template<typename AsType, typename AsHasher = Hash<AsType>, typename AsComparer = Equal<>>
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
     DataInfo tryAddAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer());
 
     // emplace
@@ -139,7 +160,15 @@ public:
     // append
     void append(const USet& set);
     void append(std::initializer_list<T> init_list);
-    void append(T* p, SizeType n);
+    void append(const T* p, SizeType n);
+
+    // bulk append, same result as add items one by one, append(p, n) and ctor use it when n >= bulk_min_size
+    // reserve exact bucket first, then hash items in parallel, radix partition them by the high bits of bucket index and
+    // find duplicates partition by partition in parallel, at last create and link new elements in input order without rehash
+    // if there is no more than parallel_chunk_size items per hardware thread, items are added one by one after reserve
+    static constexpr SizeType bulk_min_size = 1024;
+    static constexpr SizeType parallel_chunk_size = 16384;
+    void                      appendBulk(const T* p, SizeType n);
 
     // remove
     SizeType remove(const KeyType& key);
@@ -148,9 +177,9 @@ public:
     SizeType removeAllHashed(const KeyType& key, HashType hash);// [multi set extend]
 
     // remove as
-    template<typename AsType, typename AsHasher = Hash<AsType>, typename AsComparer = Equal<>>
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
     SizeType removeAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer());
-    template<typename AsType, typename AsHasher = Hash<AsType>, typename AsComparer = Equal<>>
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
     SizeType removeAllAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer());// [multi set extend]
 
     // modify
@@ -164,9 +193,9 @@ public:
     CDataInfo findHashed(const KeyType& key, HashType hash) const;
 
     // find as
-    template<typename AsType, typename AsHasher = Hash<AsType>, typename AsComparer = Equal<>>
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
     DataInfo findAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer());
-    template<typename AsType, typename AsHasher = Hash<AsType>, typename AsComparer = Equal<>>
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
     CDataInfo findAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer()) const;
 
     // contain
@@ -176,21 +205,41 @@ public:
     SizeType countHashed(const KeyType& key, HashType hash) const;// [multi set extend]
 
     // contain as
-    template<typename AsType, typename AsHasher = Hash<AsType>, typename AsComparer = Equal<>>
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
     bool containAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer()) const;
-    template<typename AsType, typename AsHasher = Hash<AsType>, typename AsComparer = Equal<>>
+    template<typename AsType, typename AsHasher = Hash<std::decay_t<AsType>>, typename AsComparer = Equal<>>
     SizeType countAs(AsType&& v, AsHasher&& hasher = AsHasher(), AsComparer&& comparer = AsComparer()) const;// [multi set extend]
 
+    // batch op, out[i] is the result of keys[i]
+    // keys are processed in chunks, hash all keys and prefetch their buckets first, then prefetch chain head
+    // several keys ahead while visiting, so the cache misses of independent keys overlap
+    void findBatch(Span<const KeyType> keys, Span<DataInfo> out);
+    void findBatch(Span<const KeyType> keys, Span<CDataInfo> out) const;
+    void findBatchHashed(Span<const KeyType> keys, Span<const HashType> hashes, Span<DataInfo> out);
+    void findBatchHashed(Span<const KeyType> keys, Span<const HashType> hashes, Span<CDataInfo> out) const;
+    void containBatch(Span<const KeyType> keys, Span<bool> out) const;
+    void containBatchHashed(Span<const KeyType> keys, Span<const HashType> hashes, Span<bool> out) const;
+    void addBatch(Span<const T> items, Span<DataInfo> out = Span<DataInfo>());
+    void addBatchHashed(Span<const T> items, Span<const HashType> hashes, Span<DataInfo> out = Span<DataInfo>());
+
     // sort
     template<typename TP = Less<T>> void sort(TP&& p = TP());
     template<typename TP = Less<T>> void sortStable(TP&& p = TP());
 
-    // set ops
+    // set ops, probe one set into the other with stored hash, results reserve the upper bound of their size once
+    // the smaller set is probed into the larger one, except multi set intersect/subtract always probe self to keep duplicates
+    // key of multi set is treated as existence, except multi set union that appends all elements of rhs (keep duplicates)
+    // probing runs in parallel when the probed set has more than parallel_chunk_size elements per hardware thread
+    // in-place intersect/subtract only allocate when run in parallel or when intersect with a smaller set (for hit marks)
+    // unionWith grows self for the added elements, or copies rhs as result when rhs is the larger one
+    void intersectWith(const USet& rhs);   // keep elements that also in rhs
+    void unionWith(const USet& rhs);       // add elements of rhs, value of rhs win as add()
+    void subtract(const USet& rhs);        // remove elements that in rhs
     USet operator&(const USet& rhs) const; // intersect
     USet operator|(const USet& rhs) const; // union
     USet operator^(const USet& rhs) const; // difference
     USet operator-(const USet& rhs) const; // sub
-    bool isSubsetOf(const USet& rhs) const;// sub set
+    bool isSubsetOf(const USet& rhs) const;// this is sub set of rhs
 
     // support foreach
     It  begin();
@@ -198,19 +247,60 @@ public:
     CIt begin() const;
     CIt end() const;
 
+    // parallel foreach, see SparseArray::parallelForEach, func must not modify the key
+    template<typename TF> void parallelForEach(TF&& func, SizeType grain = DataArr::parallel_grain);
+    template<typename TF> void parallelForEach(TF&& func, SizeType grain = DataArr::parallel_grain) const;
+
 private:
     // helpers
     SizeType  _calcBucketSize(SizeType data_size) const;
-    void      _cleanBucket() const;
-    bool      _resizeBucket() const;
+    void      _cleanBucket();
+    bool      _resizeBucket();
     SizeType  _bucketIndex(SizeType hash) const;
     SizeType& _bucketData(SizeType hash) const;
+    void      _linkToBucket(SizeType index);
+
+    // bucket tag helpers
+    static BucketTagType _tagOf(HashType hash);
+    bool                 _mayInBucket(HashType hash) const;
+    void                 _addBucketTag(HashType hash);
+    void                 _rebuildBucketTag(HashType hash);
+
+    // chain helpers, during incremental rehash, key may be found in both new bucket and old bucket
+    SizeType*                                        _chainHead(HashType hash) const;
+    SizeType*                                        _oldChainHead(HashType hash) const;
+    template<typename TPred> SizeType                _findInChain(HashType hash, TPred&& pred) const;
+    template<typename TPred> SizeType                _countInChain(HashType hash, TPred&& pred) const;
+    template<typename TPred> SizeType                _removeInChain(HashType hash, TPred&& pred);
+    bool                                             _beginIncrementalRehash();
+    void                                             _freeOldBucket();
+
+    // batch helpers
+    void                                               _prefetchBucket(HashType hash) const;
+    void                                               _prefetchChainHead(HashType hash) const;
+    template<typename TGetHash, typename TVisitor> void _visitPrefetched(SizeType n, TGetHash&& get_hash, TVisitor&& visitor);
+
+    // set op helpers, visitor(index, found_index) is called for every element of probe_set in index order, found_index is
+    // the index of the same key in target or npos, visitor can modify both sets except remove probed elements of target
+    template<typename TVisitor> static void _probeEach(const USet& probe_set, const USet& target, TVisitor&& visitor);
 
 private:
-    mutable SizeType* m_bucket;
-    mutable SizeType  m_bucket_size;
-    mutable SizeType  m_bucket_mask;
-    DataArr           m_data;
+    SizeType*      m_bucket;
+    BucketTagType* m_bucket_tag;
+    SizeType       m_bucket_size;
+    SizeType       m_bucket_mask;
+    DataArr        m_data;
+
+    // incremental rehash
+    SizeType* m_old_bucket;
+    SizeType  m_old_bucket_size;
+    SizeType  m_old_bucket_mask;
+    SizeType  m_rehash_pos;
+};
+
+// relocatable as its allocator
+template<typename T, typename Config, typename Alloc> struct is_trivially_relocatable<USet<T, Config, Alloc>> : is_trivially_relocatable<Alloc>
+{
 };
 }// namespace kun
 
@@ -238,7 +328,7 @@ KUN_INLINE typename USet<T, Config, Alloc>::SizeType USet<T, Config, Alloc>::_ca
         return 0;
     }
 }
-template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::_cleanBucket() const
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::_cleanBucket()
 {
     if (m_bucket)
     {
@@ -246,8 +336,12 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Co
         SizeType* end = m_bucket + m_bucket_size;
         for (; begin != end; ++begin) { *begin = npos; }
     }
+    if (m_bucket_tag)
+    {
+        memory::memset(m_bucket_tag, 0, m_bucket_size * sizeof(BucketTagType));
+    }
 }
-template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Config, Alloc>::_resizeBucket() const
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Config, Alloc>::_resizeBucket()
 {
     SizeType new_bucket_size = _calcBucketSize(m_data.capacity());
 
@@ -255,7 +349,11 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Co
     {
         if (new_bucket_size)
         {
-            m_bucket = m_data.resizeContainer(m_bucket, m_bucket_size, m_bucket_size, new_bucket_size);
+            m_bucket = m_data.allocator().resizeContainer(m_bucket, m_bucket_size, m_bucket_size, new_bucket_size);
+            if constexpr (Config::use_bucket_tag)
+            {
+                m_bucket_tag = m_data.allocator().resizeContainer(m_bucket_tag, m_bucket_size, m_bucket_size, new_bucket_size);
+            }
             m_bucket_size = new_bucket_size;
             m_bucket_mask = new_bucket_size - 1;
         }
@@ -265,6 +363,11 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Co
             {
                 m_data.allocator().free(m_bucket);
                 m_bucket = nullptr;
+                if (m_bucket_tag)
+                {
+                    m_data.allocator().free(m_bucket_tag);
+                    m_bucket_tag = nullptr;
+                }
                 m_bucket_size = 0;
                 m_bucket_mask = 0;
             }
@@ -286,40 +389,388 @@ KUN_INLINE typename USet<T, Config, Alloc>::SizeType& USet<T, Config, Alloc>::_b
 {
     return m_bucket[_bucketIndex(hash)];
 }
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::_linkToBucket(SizeType index)
+{
+    // full rehash will link all elements, include this one
+    bool linked;
+    if constexpr (Config::incremental_rehash)
+    {
+        rehashStep();
+        linked = needRehash() && _beginIncrementalRehash();
+    }
+    else
+    {
+        linked = rehashIfNeed();
+    }
+
+    if (!linked)
+    {
+        DataType& data = m_data[index];
+        SizeType& id_ref = _bucketData(data.hash);
+        data.next = id_ref;
+        id_ref = index;
+        _addBucketTag(data.hash);
+    }
+}
+
+// bucket tag helpers
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename USet<T, Config, Alloc>::BucketTagType USet<T, Config, Alloc>::_tagOf(HashType hash)
+{
+    // low bits of hash are used by bucket index, so pick tag bit from the high bits of mixed hash
+    return BucketTagType(1) << (((u64)hash * 0x9E3779B97F4A7C15ull) >> 60);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Config, Alloc>::_mayInBucket(HashType hash) const
+{
+    if constexpr (Config::use_bucket_tag)
+    {
+        return m_bucket_tag && (m_bucket_tag[_bucketIndex(hash)] & _tagOf(hash));
+    }
+    else
+    {
+        return m_bucket != nullptr;
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::_addBucketTag(HashType hash)
+{
+    if constexpr (Config::use_bucket_tag)
+    {
+        m_bucket_tag[_bucketIndex(hash)] |= _tagOf(hash);
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::_rebuildBucketTag(HashType hash)
+{
+    if constexpr (Config::use_bucket_tag)
+    {
+        BucketTagType tag = 0;
+        SizeType      id = _bucketData(hash);
+        while (id != npos)
+        {
+            const DataType& data = m_data[id];
+            tag |= _tagOf(data.hash);
+            id = data.next;
+        }
+        m_bucket_tag[_bucketIndex(hash)] = tag;
+    }
+}
+
+// chain helpers
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename USet<T, Config, Alloc>::SizeType* USet<T, Config, Alloc>::_chainHead(HashType hash) const
+{
+    return _mayInBucket(hash) ? &_bucketData(hash) : nullptr;
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE typename USet<T, Config, Alloc>::SizeType* USet<T, Config, Alloc>::_oldChainHead(HashType hash) const
+{
+    if constexpr (Config::incremental_rehash)
+    {
+        if (m_old_bucket)
+        {
+            // buckets before rehash pos are fully migrated
+            SizeType index = hash & m_old_bucket_mask;
+            return index >= m_rehash_pos ? m_old_bucket + index : nullptr;
+        }
+    }
+    return nullptr;
+}
+template<typename T, typename Config, typename Alloc>
+template<typename TPred>
+KUN_INLINE typename USet<T, Config, Alloc>::SizeType USet<T, Config, Alloc>::_findInChain(HashType hash, TPred&& pred) const
+{
+    for (SizeType* head : {_chainHead(hash), _oldChainHead(hash)})
+    {
+        if (head)
+        {
+            SizeType id = *head;
+            while (id != npos)
+            {
+                const DataType& data = m_data[id];
+                if (data.hash == hash && pred(keyOf(data.data)))
+                {
+                    return id;
+                }
+                id = data.next;
+            }
+        }
+    }
+    return npos;
+}
+template<typename T, typename Config, typename Alloc>
+template<typename TPred>
+KUN_INLINE typename USet<T, Config, Alloc>::SizeType USet<T, Config, Alloc>::_countInChain(HashType hash, TPred&& pred) const
+{
+    SizeType count = 0;
+    for (SizeType* head : {_chainHead(hash), _oldChainHead(hash)})
+    {
+        if (head)
+        {
+            SizeType id = *head;
+            while (id != npos)
+            {
+                const DataType& data = m_data[id];
+                if (data.hash == hash && pred(keyOf(data.data)))
+                {
+                    ++count;
+                }
+                id = data.next;
+            }
+        }
+    }
+    return count;
+}
+template<typename T, typename Config, typename Alloc>
+template<typename TPred>
+KUN_INLINE typename USet<T, Config, Alloc>::SizeType USet<T, Config, Alloc>::_removeInChain(HashType hash, TPred&& pred)
+{
+    if constexpr (Config::incremental_rehash)
+    {
+        rehashStep();
+    }
+
+    SizeType count = 0;
+    bool     remove_in_bucket = false;
+    for (SizeType* head : {_chainHead(hash), _oldChainHead(hash)})
+    {
+        if (head)
+        {
+            SizeType* link = head;
+            while (*link != npos)
+            {
+                SizeType  id = *link;
+                DataType& data = m_data[id];
+                if (data.hash == hash && pred(keyOf(data.data)))
+                {
+                    *link = data.next;
+                    m_data.removeAt(id);
+                    ++count;
+                    remove_in_bucket |= head == &_bucketData(hash);
+                }
+                else
+                {
+                    link = &data.next;
+                }
+            }
+        }
+    }
+    if (remove_in_bucket)
+    {
+        _rebuildBucketTag(hash);
+    }
+    return count;
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Config, Alloc>::_beginIncrementalRehash()
+{
+    // finish last migration
+    while (rehashStep(npos)) {}
+
+    SizeType new_bucket_size = _calcBucketSize(m_data.capacity());
+    if (m_bucket && new_bucket_size)
+    {
+        // keep old bucket, tag of old bucket is useless
+        m_old_bucket = m_bucket;
+        m_old_bucket_size = m_bucket_size;
+        m_old_bucket_mask = m_bucket_mask;
+        m_rehash_pos = 0;
+        if (m_bucket_tag)
+        {
+            m_data.allocator().free(m_bucket_tag);
+            m_bucket_tag = nullptr;
+        }
+
+        // alloc new bucket
+        m_bucket = m_data.allocator().template alloc<SizeType>(new_bucket_size);
+        if constexpr (Config::use_bucket_tag)
+        {
+            m_bucket_tag = m_data.allocator().template alloc<BucketTagType>(new_bucket_size);
+        }
+        m_bucket_size = new_bucket_size;
+        m_bucket_mask = new_bucket_size - 1;
+        _cleanBucket();
+        return false;
+    }
+    else
+    {
+        // nothing to migrate, all elements are linked by full rehash
+        rehash();
+        return true;
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::_freeOldBucket()
+{
+    if (m_old_bucket)
+    {
+        m_data.allocator().free(m_old_bucket);
+        m_old_bucket = nullptr;
+        m_old_bucket_size = 0;
+        m_old_bucket_mask = 0;
+        m_rehash_pos = 0;
+    }
+}
+
+// batch helpers
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::_prefetchBucket(HashType hash) const
+{
+    if constexpr (Config::use_bucket_tag)
+    {
+        if (m_bucket_tag)
+        {
+            memory::prefetch(m_bucket_tag + _bucketIndex(hash));
+            memory::prefetch(m_bucket + _bucketIndex(hash));
+        }
+    }
+    else
+    {
+        if (m_bucket)
+        {
+            memory::prefetch(m_bucket + _bucketIndex(hash));
+        }
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::_prefetchChainHead(HashType hash) const
+{
+    if (SizeType* head = _chainHead(hash))
+    {
+        SizeType id = *head;
+        if (id != npos)
+        {
+            memory::prefetch(m_data.data() + id);
+        }
+    }
+}
+template<typename T, typename Config, typename Alloc>
+template<typename TGetHash, typename TVisitor>
+KUN_INLINE void USet<T, Config, Alloc>::_visitPrefetched(SizeType n, TGetHash&& get_hash, TVisitor&& visitor)
+{
+    static constexpr SizeType chunk_size = 64;
+    static constexpr SizeType prefetch_distance = 8;
+
+    HashType hashes[chunk_size];
+    for (SizeType chunk_begin = 0; chunk_begin < n; chunk_begin += chunk_size)
+    {
+        SizeType chunk_n = std::min(chunk_size, n - chunk_begin);
+
+        // stage 1: hash and prefetch bucket
+        for (SizeType i = 0; i < chunk_n; ++i)
+        {
+            hashes[i] = get_hash(chunk_begin + i);
+            _prefetchBucket(hashes[i]);
+        }
+
+        // stage 2: prefetch chain head of first keys
+        for (SizeType i = 0; i < std::min(prefetch_distance, chunk_n); ++i) { _prefetchChainHead(hashes[i]); }
+
+        // stage 3: prefetch chain head ahead and visit
+        for (SizeType i = 0; i < chunk_n; ++i)
+        {
+            if (i + prefetch_distance < chunk_n)
+            {
+                _prefetchChainHead(hashes[i + prefetch_distance]);
+            }
+            visitor(chunk_begin + i, hashes[i]);
+        }
+    }
+}
+
+// set op helpers
+template<typename T, typename Config, typename Alloc>
+template<typename TVisitor>
+KUN_INLINE void USet<T, Config, Alloc>::_probeEach(const USet& probe_set, const USet& target, TVisitor&& visitor)
+{
+    // sparse size may change when visitor add elements to probe set, elements added during visit are not visited
+    SizeType sparse_size = probe_set.m_data.sparseSize();
+    auto     probe = [&](SizeType index)
+    {
+        const DataType& data = probe_set.m_data[index];
+        const KeyType&  key = probe_set.keyOf(data.data);
+        return target._findInChain(data.hash, [&](const KeyType& k) { return ComparerType()(k, key); });
+    };
+
+    SizeType chunk_count = algo::parallelChunkCount(probe_set.size(), parallel_chunk_size);
+    if (chunk_count == 1)
+    {
+        for (SizeType i = 0; i < sparse_size; ++i)
+        {
+            if (probe_set.hasData(i))
+            {
+                visitor(i, probe(i));
+            }
+        }
+    }
+    else
+    {
+        // probe in parallel, then visit in order, so visitor is free to modify sets
+        Alloc     allocator = probe_set.allocator();
+        SizeType* found = allocator.template alloc<SizeType>(sparse_size);
+        auto      probe_func = [&](SizeType, SizeType begin, SizeType end)
+        {
+            for (SizeType i = begin; i < end; ++i) { found[i] = probe_set.hasData(i) ? probe(i) : npos; }
+        };
+        algo::parallelForChunk(sparse_size, chunk_count, probe_func);
+        for (SizeType i = 0; i < sparse_size; ++i)
+        {
+            if (probe_set.hasData(i))
+            {
+                visitor(i, found[i]);
+            }
+        }
+        allocator.free(found);
+    }
+}
 
 // ctor & dtor
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE USet<T, Config, Alloc>::USet(Alloc alloc)
     : m_bucket(nullptr)
+    , m_bucket_tag(nullptr)
     , m_bucket_size(0)
     , m_bucket_mask(0)
     , m_data(std::move(alloc))
+    , m_old_bucket(nullptr)
+    , m_old_bucket_size(0)
+    , m_old_bucket_mask(0)
+    , m_rehash_pos(0)
 {
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE USet<T, Config, Alloc>::USet(SizeType reserve_size, Alloc alloc)
     : m_bucket(nullptr)
+    , m_bucket_tag(nullptr)
     , m_bucket_size(0)
     , m_bucket_mask(0)
     , m_data(std::move(alloc))
+    , m_old_bucket(nullptr)
+    , m_old_bucket_size(0)
+    , m_old_bucket_mask(0)
+    , m_rehash_pos(0)
 {
     reserve(reserve_size);
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE USet<T, Config, Alloc>::USet(const T* p, SizeType n, Alloc alloc)
     : m_bucket(nullptr)
+    , m_bucket_tag(nullptr)
     , m_bucket_size(0)
     , m_bucket_mask(0)
     , m_data(std::move(alloc))
+    , m_old_bucket(nullptr)
+    , m_old_bucket_size(0)
+    , m_old_bucket_mask(0)
+    , m_rehash_pos(0)
 {
     append(p, n);
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE USet<T, Config, Alloc>::USet(std::initializer_list<T> init_list, Alloc alloc)
     : m_bucket(nullptr)
+    , m_bucket_tag(nullptr)
     , m_bucket_size(0)
     , m_bucket_mask(0)
     , m_data(std::move(alloc))
+    , m_old_bucket(nullptr)
+    , m_old_bucket_size(0)
+    , m_old_bucket_mask(0)
+    , m_rehash_pos(0)
 {
     append(init_list);
 }
@@ -329,20 +780,35 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE USet<T, Config,
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE USet<T, Config, Alloc>::USet(const USet& other, Alloc alloc)
     : m_bucket(nullptr)
+    , m_bucket_tag(nullptr)
     , m_bucket_size(0)
     , m_bucket_mask(0)
     , m_data(std::move(alloc))
+    , m_old_bucket(nullptr)
+    , m_old_bucket_size(0)
+    , m_old_bucket_mask(0)
+    , m_rehash_pos(0)
 {
     *this = other;
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE USet<T, Config, Alloc>::USet(USet&& other)
     : m_bucket(other.m_bucket)
+    , m_bucket_tag(other.m_bucket_tag)
     , m_bucket_size(other.m_bucket_size)
     , m_bucket_mask(other.m_bucket_mask)
     , m_data(std::move(other.m_data))
+    , m_old_bucket(other.m_old_bucket)
+    , m_old_bucket_size(other.m_old_bucket_size)
+    , m_old_bucket_mask(other.m_old_bucket_mask)
+    , m_rehash_pos(other.m_rehash_pos)
 {
     other.m_bucket = nullptr;
+    other.m_bucket_tag = nullptr;
+    other.m_old_bucket = nullptr;
+    other.m_old_bucket_size = 0;
+    other.m_old_bucket_mask = 0;
+    other.m_rehash_pos = 0;
     other.m_bucket_size = 0;
     other.m_bucket_mask = 0;
 }
@@ -355,42 +821,77 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE USet<T, Config,
         // clear
         clear();
 
-        if (!rhs.empty())
+        if (rhs.isRehashing())
+        {
+            // bucket of rhs is half migrated, just rebuild it
+            m_data = rhs.m_data;
+            rehash();
+        }
+        else if (!rhs.empty())
         {
             // realloc bucket
             if (m_bucket_size != rhs.m_bucket_size)
             {
+                if (m_bucket)
+                {
+                    m_data.allocator().free(m_bucket);
+                }
+                if (m_bucket_tag)
+                {
+                    m_data.allocator().free(m_bucket_tag);
+                    m_bucket_tag = nullptr;
+                }
                 m_bucket_size = rhs.m_bucket_size;
                 m_bucket_mask = rhs.m_bucket_mask;
                 m_bucket = m_data.allocator().template alloc<SizeType>(m_bucket_size);
+                if (rhs.m_bucket_tag)
+                {
+                    m_bucket_tag = m_data.allocator().template alloc<BucketTagType>(m_bucket_size);
+                }
             }
 
             // copy bucket
             memory::memcpy(m_bucket, rhs.m_bucket, m_bucket_size * sizeof(SizeType));
+            if (m_bucket_tag)
+            {
+                memory::memcpy(m_bucket_tag, rhs.m_bucket_tag, m_bucket_size * sizeof(BucketTagType));
+            }
 
             // copy data
             m_data = rhs.m_data;
         }
     }
+    return *this;
 }
 template<typename T, typename Config, typename Alloc> KUN_INLINE USet<T, Config, Alloc>& USet<T, Config, Alloc>::operator=(USet&& rhs)
 {
     if (this != &rhs)
     {
-        // clear
-        clear();
+        // release
+        release();
 
         // move data
         m_bucket = rhs.m_bucket;
+        m_bucket_tag = rhs.m_bucket_tag;
         m_bucket_size = rhs.m_bucket_size;
         m_bucket_mask = rhs.m_bucket_mask;
         m_data = std::move(rhs.m_data);
+        m_old_bucket = rhs.m_old_bucket;
+        m_old_bucket_size = rhs.m_old_bucket_size;
+        m_old_bucket_mask = rhs.m_old_bucket_mask;
+        m_rehash_pos = rhs.m_rehash_pos;
 
         // clean up rhs
         rhs.m_bucket = nullptr;
+        rhs.m_bucket_tag = nullptr;
+        rhs.m_old_bucket = nullptr;
+        rhs.m_old_bucket_size = 0;
+        rhs.m_old_bucket_mask = 0;
+        rhs.m_rehash_pos = 0;
         rhs.m_bucket_size = 0;
         rhs.m_bucket_mask = 0;
     }
+    return *this;
 }
 
 // compare
@@ -459,6 +960,10 @@ template<typename T, typename Config, typename Alloc> const typename USet<T, Con
 {
     return m_bucket;
 }
+template<typename T, typename Config, typename Alloc> const typename USet<T, Config, Alloc>::BucketTagType* USet<T, Config, Alloc>::bucketTag() const
+{
+    return m_bucket_tag;
+}
 template<typename T, typename Config, typename Alloc> Alloc&       USet<T, Config, Alloc>::allocator() { return m_data.allocator(); }
 template<typename T, typename Config, typename Alloc> const Alloc& USet<T, Config, Alloc>::allocator() const { return m_data.allocator(); }
 
@@ -484,11 +989,13 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Co
 template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::clear()
 {
     m_data.clear();
+    _freeOldBucket();
     _cleanBucket();
 }
 template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::release(SizeType capacity)
 {
     m_data.release(capacity);
+    _freeOldBucket();
     _resizeBucket();
     _cleanBucket();
 }
@@ -557,8 +1064,11 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Co
     SizeType new_bucket_size = _calcBucketSize(m_data.capacity());
     return m_data.size() > 0 && (new_bucket_size != m_bucket_size);
 }
-template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::rehash() const
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::rehash()
 {
+    // all elements will be relinked, drop migration
+    _freeOldBucket();
+
     // try resize bucket
     _resizeBucket();
 
@@ -571,14 +1081,22 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Co
             SizeType& id_ref = _bucketData(it->hash);
             it->next = id_ref;
             id_ref = it.index();
+            _addBucketTag(it->hash);
         }
     }
 }
-template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Config, Alloc>::rehashIfNeed() const
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Config, Alloc>::rehashIfNeed()
 {
     if (needRehash())
     {
-        rehash();
+        if constexpr (Config::incremental_rehash)
+        {
+            _beginIncrementalRehash();
+        }
+        else
+        {
+            rehash();
+        }
         return true;
     }
     else
@@ -587,21 +1105,62 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Co
     }
 }
 
+// incremental rehash
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Config, Alloc>::isRehashing() const { return m_old_bucket != nullptr; }
+template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Config, Alloc>::rehashStep(SizeType max_step)
+{
+    if (m_old_bucket)
+    {
+        SizeType moved = 0;
+        SizeType visited = 0;
+        while (m_rehash_pos < m_old_bucket_size && moved < max_step && visited < max_step)
+        {
+            SizeType& old_head = m_old_bucket[m_rehash_pos];
+            if (old_head == npos)
+            {
+                ++m_rehash_pos;
+                ++visited;
+            }
+            else
+            {
+                // move chain head to new bucket, bucket may be half migrated, lookups still consult it
+                SizeType  id = old_head;
+                DataType& data = m_data[id];
+                old_head = data.next;
+
+                SizeType& id_ref = _bucketData(data.hash);
+                data.next = id_ref;
+                id_ref = id;
+                _addBucketTag(data.hash);
+                ++moved;
+            }
+        }
+
+        if (m_rehash_pos == m_old_bucket_size)
+        {
+            _freeOldBucket();
+        }
+    }
+    return m_old_bucket != nullptr;
+}
+
 // per element hash op
 template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Config, Alloc>::isInBucket(SizeType index) const
 {
-    if (hasData(index))
+    if (m_bucket && hasData(index))
     {
-        DataType& data = m_data[index];
-        SizeType  id = _bucketData(data.hash);
-
-        while (id != npos)
+        const DataType& data = m_data[index];
+        for (SizeType* head : {&_bucketData(data.hash), _oldChainHead(data.hash)})
         {
-            if (id == index)
+            SizeType id = head ? *head : npos;
+            while (id != npos)
             {
-                return true;
+                if (id == index)
+                {
+                    return true;
+                }
+                id = m_data[id].next;
             }
-            id = m_data[id].next;
         }
         return false;
     }
@@ -617,68 +1176,60 @@ KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::add
     KUN_Assert(!isInBucket(index));
 
     DataType& data = m_data[index];
-
-    DataInfo info(&data.data, index);
     if constexpr (!Config::multi_key)
     {
         // check if data has been added to set
-        if (DataInfo& found_info = findHashed(keyOf(data.data), data.hash))
+        if (DataInfo found_info = findHashed(keyOf(data.data), data.hash))
         {
             // cover the old data
-            memory::moveItems(&found_info.data, &data.data, 1);
+            *found_info.data = std::move(data.data);
 
-            // remove old data
+            // remove new node
             m_data.removeAt(index);
 
             // modify data
-            info = found_info;
-            info.already_exist = true;
-        }
-        else
-        {
-            // link to bucket
-            if (!rehashIfNeed())
-            {
-                SizeType& id_ref = _bucketData(data.hash);
-                data.next = id_ref;
-                id_ref = index;
-            }
-        }
-    }
-    else
-    {
-        // link to bucket
-        if (!rehashIfNeed())
-        {
-            SizeType& id_ref = _bucketData(data.hash);
-            data.next = id_ref;
-            id_ref = index;
+            found_info.already_exist = true;
+            return found_info;
         }
     }
-    return info;
+
+    // link to bucket
+    _linkToBucket(index);
+    return DataInfo(&data.data, index);
 }
 template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::addToBucketAnyway(SizeType index)
 {
     KUN_Assert(hasData(index));
     KUN_Assert(!isInBucket(index));
 
-    DataType& data = m_data[index];
-    SizeType& id_ref = _bucketData(data.hash);
-    data->next = id_ref;
-    id_ref = index;
+    _linkToBucket(index);
 }
 template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::removeFromBucket(SizeType index)
 {
     KUN_Assert(hasData(index));
     KUN_Assert(isInBucket(index));
 
+    if constexpr (Config::incremental_rehash)
+    {
+        rehashStep();
+    }
+
     DataType& data = m_data[index];
-    for (SizeType& id_ref = _bucketData(data.hash); id_ref != npos; id_ref = m_data[id_ref].next)
+    for (SizeType* head : {&_bucketData(data.hash), _oldChainHead(data.hash)})
     {
-        if (id_ref == index)
+        SizeType* link = head;
+        while (link && *link != npos)
         {
-            id_ref = data.next;
-            break;
+            if (*link == index)
+            {
+                *link = data.next;
+                if (head == &_bucketData(data.hash))
+                {
+                    _rebuildBucketTag(data.hash);
+                }
+                return;
+            }
+            link = &m_data[*link].next;
         }
     }
 }
@@ -692,7 +1243,7 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE typename USet<T
     info->hash = hashOf(info->data);
 
     // link or assign
-    addToBucketOrAssign(info.index);
+    return addToBucketOrAssign(info.index);
 }
 template<typename T, typename Config, typename Alloc> KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::add(T&& v)
 {
@@ -702,7 +1253,7 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE typename USet<T
     info->hash = hashOf(info->data);
 
     // link or assign
-    addToBucketOrAssign(info.index);
+    return addToBucketOrAssign(info.index);
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::addHashed(const T& v, HashType hash)
@@ -715,7 +1266,7 @@ KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::add
     info->hash = hash;
 
     // link or assign
-    addToBucketOrAssign(info.index);
+    return addToBucketOrAssign(info.index);
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::addHashed(T&& v, HashType hash)
@@ -728,7 +1279,7 @@ KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::add
     info->hash = hash;
 
     // link or assign
-    addToBucketOrAssign(info.index);
+    return addToBucketOrAssign(info.index);
 }
 
 // add anyway (add but never check existence)
@@ -742,6 +1293,7 @@ KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::add
 
     // link directly
     addToBucketAnyway(info.index);
+    return DataInfo(&info->data, info.index);
 }
 template<typename T, typename Config, typename Alloc> KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::addAnyway(T&& v)
 {
@@ -752,6 +1304,7 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE typename USet<T
 
     // link directly
     addToBucketAnyway(info.index);
+    return DataInfo(&info->data, info.index);
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::addAnywayHashed(const T& v, HashType hash)
@@ -765,11 +1318,11 @@ KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::add
 
     // link directly
     addToBucketAnyway(info.index);
+    return DataInfo(&info->data, info.index);
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::addAnywayHashed(T&& v, HashType hash)
 {
-
     KUN_Assert(hashOf(v) == hash);
 
     // create node
@@ -779,62 +1332,60 @@ KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::add
 
     // link directly
     addToBucketAnyway(info.index);
+    return DataInfo(&info->data, info.index);
 }
 
 // try add (first check existence, then add, never assign)
 template<typename T, typename Config, typename Alloc> KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::tryAdd(const T& v)
 {
-    HashType hash = hashOf(v);
-    if (!containHashed(v, hash))
-    {
-        return addHashed(v, hash);
-    }
-    return DataInfo();
+    return tryAddHashed(v, hashOf(v));
 }
 template<typename T, typename Config, typename Alloc> KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::tryAdd(T&& v)
 {
     HashType hash = hashOf(v);
-    if (!containHashed(v, hash))
-    {
-        return addHashed(std::move(v), hash);
-    }
-    return DataInfo();
+    return tryAddHashed(std::move(v), hash);
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::tryAddHashed(const T& v, HashType hash)
 {
-    if (!containHashed(v, hash))
+    if (DataInfo info = findHashed(keyOf(v), hash))
     {
-        return addHashed(std::move(v), hash);
+        info.already_exist = true;
+        return info;
     }
-    return DataInfo();
+    return addAnywayHashed(v, hash);
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::tryAddHashed(T&& v, HashType hash)
 {
-    if (!containHashed(v, hash))
+    if (DataInfo info = findHashed(keyOf(v), hash))
     {
-        return addHashed(std::move(v), hash);
+        info.already_exist = true;
+        return info;
     }
-    return DataInfo();
+    return addAnywayHashed(std::move(v), hash);
 }
 template<typename T, typename Config, typename Alloc>
 template<typename AsType, typename AsHasher, typename AsComparer>
 KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::tryAddAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer)
 {
     HashType hash = hasher(v);
-    auto     constant_hasher = [hash](auto& a) { return hash; };
-    if (!containAs(std::forward<AsType>(v), constant_hasher, std::forward<AsComparer>(comparer)))
+    auto     constant_hasher = [hash](const auto&) { return hash; };
+    if (DataInfo info = findAs(v, constant_hasher, std::forward<AsComparer>(comparer)))
     {
-        // create node
-        auto info = m_data.addUnsafe();
-        new (&info->data) T(v);
-        info->hash = hash;
-
-        // link directly
-        addToBucketAnyway(info.index);
+        info.already_exist = true;
+        return info;
     }
-    return DataInfo();
+
+    // create node
+    auto info = m_data.addUnsafe();
+    new (&info->data) T(std::forward<AsType>(v));
+    info->hash = hash;
+    KUN_Assert(hashOf(info->data) == hash);
+
+    // link directly
+    addToBucketAnyway(info.index);
+    return DataInfo(&info->data, info.index);
 }
 
 // emplace
@@ -848,7 +1399,7 @@ KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::emp
     info->hash = hashOf(info->data);
 
     // link or assign
-    addToBucketOrAssign(info.index);
+    return addToBucketOrAssign(info.index);
 }
 template<typename T, typename Config, typename Alloc>
 template<typename... Args>
@@ -861,7 +1412,7 @@ KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::emp
     KUN_Assert(hashOf(info->data) == hash);
 
     // link or assign
-    addToBucketOrAssign(info.index);
+    return addToBucketOrAssign(info.index);
 }
 template<typename T, typename Config, typename Alloc>
 template<typename... Args>
@@ -874,6 +1425,7 @@ KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::emp
 
     // link directly
     addToBucketAnyway(info.index);
+    return DataInfo(&info->data, info.index);
 }
 template<typename T, typename Config, typename Alloc>
 template<typename... Args>
@@ -887,6 +1439,7 @@ KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::emp
 
     // link directly
     addToBucketAnyway(info.index);
+    return DataInfo(&info->data, info.index);
 }
 
 // append
@@ -898,70 +1451,194 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Co
 {
     for (const auto& v : init_list) { add(v); }
 }
-template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::append(T* p, SizeType n)
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::append(const T* p, SizeType n)
 {
-    for (SizeType i = 0; i < n; ++i) { add(p[n]); }
+    if (n >= bulk_min_size)
+    {
+        appendBulk(p, n);
+    }
+    else
+    {
+        reserve(size() + n);
+        for (SizeType i = 0; i < n; ++i) { add(p[i]); }
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::appendBulk(const T* p, SizeType n)
+{
+    if (n == 0)
+    {
+        return;
+    }
+
+    // presize, holes are filled first, so size + n is enough, and bucket size is decided by capacity
+    m_data.reserve(size() + n);
+    if (isRehashing() || _calcBucketSize(m_data.capacity()) != m_bucket_size)
+    {
+        rehash();
+    }
+
+    // partition only pay off when run in parallel, bucket is ready, so add one by one never rehash
+    SizeType chunk_count = algo::parallelChunkCount(n, parallel_chunk_size);
+    if (chunk_count == 1)
+    {
+        for (SizeType i = 0; i < n; ++i) { add(p[i]); }
+        return;
+    }
+
+    Alloc&    allocator = m_data.allocator();
+    HashType* hashes = allocator.template alloc<HashType>(n);
+    SizeType* src = allocator.template alloc<SizeType>(n);// item index to construct from, npos means skip
+
+    // stage 1: hash
+    auto hash_func = [&](SizeType, SizeType begin, SizeType end)
+    {
+        for (SizeType i = begin; i < end; ++i) { hashes[i] = hashOf(p[i]); }
+    };
+    algo::parallelForChunk(n, chunk_count, hash_func);
+
+    if constexpr (Config::multi_key)
+    {
+        for (SizeType i = 0; i < n; ++i) { src[i] = i; }
+    }
+    else
+    {
+        // stage 2: radix partition by the high bits of bucket index, so every partition own a continuous bucket range
+        SizeType bucket_bits = 0;
+        SizeType part_bits = 0;
+        while ((SizeType(1) << bucket_bits) < m_bucket_size) { ++bucket_bits; }
+        while (part_bits < bucket_bits && (SizeType(1) << part_bits) < chunk_count * 8) { ++part_bits; }
+        SizeType part_count = SizeType(1) << part_bits;
+        SizeType part_shift = bucket_bits - part_bits;
+
+        SizeType* part_cursor = allocator.template alloc<SizeType>(chunk_count * part_count);// [chunk][part]
+        SizeType* part_begin = allocator.template alloc<SizeType>(part_count + 1);
+        SizeType* order = allocator.template alloc<SizeType>(n);
+        auto      count_func = [&](SizeType chunk, SizeType begin, SizeType end)
+        {
+            SizeType* cursor = part_cursor + chunk * part_count;
+            for (SizeType i = 0; i < part_count; ++i) { cursor[i] = 0; }
+            for (SizeType i = begin; i < end; ++i) { ++cursor[_bucketIndex(hashes[i]) >> part_shift]; }
+        };
+        algo::parallelForChunk(n, chunk_count, count_func);
+
+        // exclusive prefix sum in [part][chunk] order, so items keep input order in each partition
+        SizeType sum = 0;
+        for (SizeType part = 0; part < part_count; ++part)
+        {
+            part_begin[part] = sum;
+            for (SizeType chunk = 0; chunk < chunk_count; ++chunk)
+            {
+                SizeType& cursor = part_cursor[chunk * part_count + part];
+                SizeType  count = cursor;
+                cursor = sum;
+                sum += count;
+            }
+        }
+        part_begin[part_count] = sum;
+
+        auto scatter_func = [&](SizeType chunk, SizeType begin, SizeType end)
+        {
+            SizeType* cursor = part_cursor + chunk * part_count;
+            for (SizeType i = begin; i < end; ++i) { order[cursor[_bucketIndex(hashes[i]) >> part_shift]++] = i; }
+        };
+        algo::parallelForChunk(n, chunk_count, scatter_func);
+
+        // stage 3: find duplicates, items of a key always fall in the same partition, so partitions never race
+        // new keys are linked into a temporary chain, the first item keep its position and the last item give the value
+        SizeType* tmp_head = allocator.template alloc<SizeType>(m_bucket_size);
+        SizeType* tmp_next = allocator.template alloc<SizeType>(n);
+        auto      dedup_func = [&](SizeType, SizeType part_first, SizeType part_last)
+        {
+            for (SizeType i = part_first << part_shift; i < (part_last << part_shift); ++i) { tmp_head[i] = npos; }
+            for (SizeType k = part_begin[part_first]; k < part_begin[part_last]; ++k)
+            {
+                SizeType       i = order[k];
+                HashType       hash = hashes[i];
+                const KeyType& key = keyOf(p[i]);
+                auto           pred = [&](const KeyType& k) { return ComparerType()(k, key); };
+
+                // duplicated in input
+                SizeType& head = tmp_head[_bucketIndex(hash)];
+                SizeType  first = head;
+                while (first != npos && !(hashes[first] == hash && pred(keyOf(p[first])))) { first = tmp_next[first]; }
+                if (first != npos)
+                {
+                    src[first] = i;
+                    src[i] = npos;
+                    continue;
+                }
+
+                // already in set, cover the old data
+                SizeType found = _findInChain(hash, pred);
+                if (found != npos)
+                {
+                    m_data[found].data = p[i];
+                    src[i] = npos;
+                    continue;
+                }
+
+                src[i] = i;
+                tmp_next[i] = head;
+                head = i;
+            }
+        };
+        algo::parallelForChunk(part_count, std::min(chunk_count, part_count), dedup_func);
+
+        allocator.free(tmp_next);
+        allocator.free(tmp_head);
+        allocator.free(order);
+        allocator.free(part_begin);
+        allocator.free(part_cursor);
+    }
+
+    // stage 4: create and link, capacity and bucket are ready, so no rehash happens
+    for (SizeType i = 0; i < n; ++i)
+    {
+        if (src[i] != npos)
+        {
+            auto info = m_data.addUnsafe();
+            new (&info->data) T(p[src[i]]);
+            info->hash = hashes[i];
+
+            SizeType& id_ref = _bucketData(info->hash);
+            info->next = id_ref;
+            id_ref = info.index;
+            _addBucketTag(info->hash);
+        }
+    }
+
+    allocator.free(src);
+    allocator.free(hashes);
 }
 
 // remove
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::SizeType USet<T, Config, Alloc>::remove(const KeyType& key)
 {
-    if (DataInfo info = find(key))
-    {
-        memory::destructItem(info.data, 1);
-        removeFromBucket(info.index);
-    }
-    return npos;
+    return removeHashed(key, HasherType()(key));
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::SizeType USet<T, Config, Alloc>::removeHashed(const KeyType& key, HashType hash)
 {
     if (DataInfo info = findHashed(key, hash))
     {
-        memory::destructItem(info.data, 1);
         removeFromBucket(info.index);
+        m_data.removeAt(info.index);
+        return info.index;
     }
     return npos;
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::SizeType USet<T, Config, Alloc>::removeAll(const KeyType& key)
 {
-    HashType  hash = HasherType()(key);
-    SizeType& id_ref = _bucketData(hash);
-    SizeType  count = 0;
-    while (id_ref != npos)
-    {
-        DataType& data = m_data[id_ref];
-        if (ComparerType()(keyOf(data.data), key))
-        {
-            memory::destructItem(&data.data, 1);
-            removeFromBucket(id_ref);
-            ++count;
-        }
-        id_ref = data.next;
-    }
-    return count;
+    return removeAllHashed(key, HasherType()(key));
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::SizeType USet<T, Config, Alloc>::removeAllHashed(const KeyType& key, HashType hash)
 {
     KUN_Assert(HasherType()(key) == hash);
 
-    SizeType& id_ref = _bucketData(hash);
-    SizeType  count = 0;
-    while (id_ref != npos)
-    {
-        DataType& data = m_data[id_ref];
-        if (ComparerType()(keyOf(data.data), key))
-        {
-            memory::destructItem(&data.data, 1);
-            removeFromBucket(id_ref);
-            ++count;
-        }
-        id_ref = data.next;
-    }
-    return count;
+    return _removeInChain(hash, [&](const KeyType& k) { return ComparerType()(k, key); });
 }
 
 // remove as
@@ -971,8 +1648,8 @@ KUN_INLINE typename USet<T, Config, Alloc>::SizeType USet<T, Config, Alloc>::rem
 {
     if (DataInfo info = findAs(std::forward<AsType>(v), std::forward<AsHasher>(hasher), std::forward<AsComparer>(comparer)))
     {
-        memory::destructItem(info.data, 1);
         removeFromBucket(info.index);
+        m_data.removeAt(info.index);
         return info.index;
     }
     return npos;
@@ -981,21 +1658,7 @@ template<typename T, typename Config, typename Alloc>
 template<typename AsType, typename AsHasher, typename AsComparer>
 KUN_INLINE typename USet<T, Config, Alloc>::SizeType USet<T, Config, Alloc>::removeAllAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer)
 {
-    HashType  hash = hasher(v);
-    SizeType& id_ref = _bucketData(hash);
-    SizeType  count = 0;
-    while (id_ref != npos)
-    {
-        DataType& data = m_data[id_ref];
-        if (comparer(data.data, v))
-        {
-            memory::destructItem(&data.data, 1);
-            removeFromBucket(id_ref);
-            ++count;
-        }
-        id_ref = data.next;
-    }
-    return count;
+    return _removeInChain(hasher(v), [&](const KeyType& key) { return comparer(key, v); });
 }
 
 // modify
@@ -1014,21 +1677,7 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE const T& USet<T
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::find(const KeyType& key)
 {
-    HashType hash = HasherType()(key);
-    SizeType id_ref = _bucketData(hash);
-    DataInfo info;
-    while (id_ref != npos)
-    {
-        DataType& data = m_data[id_ref];
-        if (ComparerType()(keyOf(data.data), key))
-        {
-            info.data = &data.data;
-            info.index = id_ref;
-            break;
-        }
-        id_ref = data.next;
-    }
-    return info;
+    return findHashed(key, HasherType()(key));
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::CDataInfo USet<T, Config, Alloc>::find(const KeyType& key) const
@@ -1041,20 +1690,8 @@ KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::fin
 {
     KUN_Assert(HasherType()(key) == hash);
 
-    SizeType id_ref = _bucketData(hash);
-    DataInfo info;
-    while (id_ref != npos)
-    {
-        DataType& data = m_data[id_ref];
-        if (ComparerType()(keyOf(data.data), key))
-        {
-            info.data = &data.data;
-            info.index = id_ref;
-            break;
-        }
-        id_ref = data.next;
-    }
-    return info;
+    SizeType id = _findInChain(hash, [&](const KeyType& k) { return ComparerType()(k, key); });
+    return id != npos ? DataInfo(&m_data[id].data, id) : DataInfo();
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::CDataInfo USet<T, Config, Alloc>::findHashed(const KeyType& key, HashType hash) const
@@ -1068,21 +1705,8 @@ template<typename T, typename Config, typename Alloc>
 template<typename AsType, typename AsHasher, typename AsComparer>
 KUN_INLINE typename USet<T, Config, Alloc>::DataInfo USet<T, Config, Alloc>::findAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer)
 {
-    HashType hash = hasher(v);
-    SizeType id_ref = _bucketData(hash);
-    DataInfo info;
-    while (id_ref != npos)
-    {
-        DataType& data = m_data[id_ref];
-        if (comparer(keyOf(data.data), v))
-        {
-            info.data = &data.data;
-            info.index = id_ref;
-            break;
-        }
-        id_ref = data.next;
-    }
-    return info;
+    SizeType id = _findInChain(hasher(v), [&](const KeyType& key) { return comparer(key, v); });
+    return id != npos ? DataInfo(&m_data[id].data, id) : DataInfo();
 }
 template<typename T, typename Config, typename Alloc>
 template<typename AsType, typename AsHasher, typename AsComparer>
@@ -1104,37 +1728,14 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Co
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::SizeType USet<T, Config, Alloc>::count(const KeyType& key) const
 {
-    HashType  hash = HasherType()(key);
-    SizeType& id_ref = _bucketData(hash);
-    SizeType  count = 0;
-    while (id_ref != npos)
-    {
-        DataType& data = m_data[id_ref];
-        if (ComparerType()(keyOf(data.data), key))
-        {
-            ++count;
-        }
-        id_ref = data.next;
-    }
-    return count;
+    return countHashed(key, HasherType()(key));
 }
 template<typename T, typename Config, typename Alloc>
 KUN_INLINE typename USet<T, Config, Alloc>::SizeType USet<T, Config, Alloc>::countHashed(const KeyType& key, HashType hash) const
 {
     KUN_Assert(HasherType()(key) == hash);
 
-    SizeType& id_ref = _bucketData(hash);
-    SizeType  count = 0;
-    while (id_ref != npos)
-    {
-        DataType& data = m_data[id_ref];
-        if (ComparerType()(keyOf(data.data), key))
-        {
-            ++count;
-        }
-        id_ref = data.next;
-    }
-    return count;
+    return _countInChain(hash, [&](const KeyType& k) { return ComparerType()(k, key); });
 }
 
 // contain as
@@ -1148,102 +1749,319 @@ template<typename T, typename Config, typename Alloc>
 template<typename AsType, typename AsHasher, typename AsComparer>
 KUN_INLINE typename USet<T, Config, Alloc>::SizeType USet<T, Config, Alloc>::countAs(AsType&& v, AsHasher&& hasher, AsComparer&& comparer) const
 {
-    HashType  hash = hasher(v);
-    SizeType& id_ref = _bucketData(hash);
-    SizeType  count = 0;
-    while (id_ref != npos)
+    return _countInChain(hasher(v), [&](const KeyType& key) { return comparer(key, v); });
+}
+
+// batch op
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::findBatch(Span<const KeyType> keys, Span<DataInfo> out)
+{
+    KUN_Assert(out.size() >= keys.size());
+    auto get_hash = [&](SizeType i) { return HasherType()(keys.data()[i]); };
+    auto visitor = [&](SizeType i, HashType hash) { out.data()[i] = findHashed(keys.data()[i], hash); };
+    _visitPrefetched((SizeType)keys.size(), get_hash, visitor);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::findBatch(Span<const KeyType> keys, Span<CDataInfo> out) const
+{
+    KUN_Assert(out.size() >= keys.size());
+    auto get_hash = [&](SizeType i) { return HasherType()(keys.data()[i]); };
+    auto visitor = [&](SizeType i, HashType hash) { out.data()[i] = findHashed(keys.data()[i], hash); };
+    const_cast<USet*>(this)->_visitPrefetched((SizeType)keys.size(), get_hash, visitor);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE void USet<T, Config, Alloc>::findBatchHashed(Span<const KeyType> keys, Span<const HashType> hashes, Span<DataInfo> out)
+{
+    KUN_Assert(hashes.size() == keys.size());
+    KUN_Assert(out.size() >= keys.size());
+    auto get_hash = [&](SizeType i) { return hashes.data()[i]; };
+    auto visitor = [&](SizeType i, HashType hash) { out.data()[i] = findHashed(keys.data()[i], hash); };
+    _visitPrefetched((SizeType)keys.size(), get_hash, visitor);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE void USet<T, Config, Alloc>::findBatchHashed(Span<const KeyType> keys, Span<const HashType> hashes, Span<CDataInfo> out) const
+{
+    KUN_Assert(hashes.size() == keys.size());
+    KUN_Assert(out.size() >= keys.size());
+    auto get_hash = [&](SizeType i) { return hashes.data()[i]; };
+    auto visitor = [&](SizeType i, HashType hash) { out.data()[i] = findHashed(keys.data()[i], hash); };
+    const_cast<USet*>(this)->_visitPrefetched((SizeType)keys.size(), get_hash, visitor);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::containBatch(Span<const KeyType> keys, Span<bool> out) const
+{
+    KUN_Assert(out.size() >= keys.size());
+    auto get_hash = [&](SizeType i) { return HasherType()(keys.data()[i]); };
+    auto visitor = [&](SizeType i, HashType hash) { out.data()[i] = containHashed(keys.data()[i], hash); };
+    const_cast<USet*>(this)->_visitPrefetched((SizeType)keys.size(), get_hash, visitor);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE void USet<T, Config, Alloc>::containBatchHashed(Span<const KeyType> keys, Span<const HashType> hashes, Span<bool> out) const
+{
+    KUN_Assert(hashes.size() == keys.size());
+    KUN_Assert(out.size() >= keys.size());
+    auto get_hash = [&](SizeType i) { return hashes.data()[i]; };
+    auto visitor = [&](SizeType i, HashType hash) { out.data()[i] = containHashed(keys.data()[i], hash); };
+    const_cast<USet*>(this)->_visitPrefetched((SizeType)keys.size(), get_hash, visitor);
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::addBatch(Span<const T> items, Span<DataInfo> out)
+{
+    KUN_Assert(out.empty() || out.size() >= items.size());
+
+    // reserve first, so bucket will not be rebuilt during visit
+    reserve(size() + (SizeType)items.size());
+    auto get_hash = [&](SizeType i) { return hashOf(items.data()[i]); };
+    auto visitor = [&](SizeType i, HashType hash)
     {
-        DataType& data = m_data[id_ref];
-        if (comparer(keyOf(data.data), v))
+        DataInfo info = addHashed(items.data()[i], hash);
+        if (!out.empty())
         {
-            ++count;
+            out.data()[i] = info;
         }
-        id_ref = data.next;
-    }
-    return count;
+    };
+    _visitPrefetched((SizeType)items.size(), get_hash, visitor);
+}
+template<typename T, typename Config, typename Alloc>
+KUN_INLINE void USet<T, Config, Alloc>::addBatchHashed(Span<const T> items, Span<const HashType> hashes, Span<DataInfo> out)
+{
+    KUN_Assert(hashes.size() == items.size());
+    KUN_Assert(out.empty() || out.size() >= items.size());
+
+    // reserve first, so bucket will not be rebuilt during visit
+    reserve(size() + (SizeType)items.size());
+    auto get_hash = [&](SizeType i) { return hashes.data()[i]; };
+    auto visitor = [&](SizeType i, HashType hash)
+    {
+        DataInfo info = addHashed(items.data()[i], hash);
+        if (!out.empty())
+        {
+            out.data()[i] = info;
+        }
+    };
+    _visitPrefetched((SizeType)items.size(), get_hash, visitor);
 }
 
 // sort
 template<typename T, typename Config, typename Alloc> template<typename TP> KUN_INLINE void USet<T, Config, Alloc>::sort(TP&& p)
 {
-    m_data.template sort([&](const DataType& a, const DataType& b) { return p(keyOf(a), keyOf(b)); });
+    m_data.sort([&](const DataType& a, const DataType& b) { return p(a.data, b.data); });
     rehash();
 }
 template<typename T, typename Config, typename Alloc> template<typename TP> KUN_INLINE void USet<T, Config, Alloc>::sortStable(TP&& p)
 {
-    m_data.template sortStable([&](const DataType& a, const DataType& b) { return p(keyOf(a), keyOf(b)); });
+    m_data.sortStable([&](const DataType& a, const DataType& b) { return p(a.data, b.data); });
     rehash();
 }
 
 // set ops
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::intersectWith(const USet& rhs)
+{
+    if (this == &rhs)
+    {
+        return;
+    }
+
+    if (Config::multi_key || size() <= rhs.size())
+    {
+        // probe self into rhs, remove missed
+        auto visitor = [&](SizeType index, SizeType found_index)
+        {
+            if (found_index == npos)
+            {
+                removeFromBucket(index);
+                m_data.removeAt(index);
+            }
+        };
+        _probeEach(*this, rhs, visitor);
+    }
+    else
+    {
+        // probe rhs into self, mark hit, then remove the others
+        SizeType sparse_size = m_data.sparseSize();
+        u8*      hit = m_data.allocator().template alloc<u8>(sparse_size);
+        memory::memset(hit, 0, sparse_size);
+        auto visitor = [&](SizeType, SizeType found_index)
+        {
+            if (found_index != npos)
+            {
+                hit[found_index] = 1;
+            }
+        };
+        _probeEach(rhs, *this, visitor);
+        for (SizeType i = 0; i < sparse_size; ++i)
+        {
+            if (hasData(i) && !hit[i])
+            {
+                removeFromBucket(i);
+                m_data.removeAt(i);
+            }
+        }
+        m_data.allocator().free(hit);
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::unionWith(const USet& rhs)
+{
+    if (this == &rhs)
+    {
+        return;
+    }
+
+    if constexpr (Config::multi_key)
+    {
+        reserve(size() + rhs.size());
+        for (auto it = rhs.m_data.begin(); it; ++it) { addAnywayHashed(it->data, it->hash); }
+    }
+    else if (rhs.size() <= size())
+    {
+        // probe rhs into self, cover hit and add missed
+        reserve(size() + rhs.size());
+        auto visitor = [&](SizeType index, SizeType found_index)
+        {
+            const DataType& data = rhs.m_data[index];
+            if (found_index != npos)
+            {
+                m_data[found_index].data = data.data;
+            }
+            else
+            {
+                emplaceAnywayHashed(data.hash, data.data);
+            }
+        };
+        _probeEach(rhs, *this, visitor);
+    }
+    else
+    {
+        // copy the larger rhs, then probe self into it, rhs already own the winning value of hit
+        USet result(rhs, m_data.allocator());
+        result.reserve(size() + rhs.size());
+        auto visitor = [&](SizeType index, SizeType found_index)
+        {
+            if (found_index == npos)
+            {
+                DataType& data = m_data[index];
+                result.emplaceAnywayHashed(data.hash, std::move(data.data));
+            }
+        };
+        _probeEach(*this, rhs, visitor);
+        *this = std::move(result);
+    }
+}
+template<typename T, typename Config, typename Alloc> KUN_INLINE void USet<T, Config, Alloc>::subtract(const USet& rhs)
+{
+    if (this == &rhs)
+    {
+        clear();
+        return;
+    }
+
+    if (!Config::multi_key && rhs.size() < size())
+    {
+        // probe rhs into self, remove hit
+        auto visitor = [&](SizeType, SizeType found_index)
+        {
+            if (found_index != npos)
+            {
+                removeFromBucket(found_index);
+                m_data.removeAt(found_index);
+            }
+        };
+        _probeEach(rhs, *this, visitor);
+    }
+    else
+    {
+        // probe self into rhs, remove hit
+        auto visitor = [&](SizeType index, SizeType found_index)
+        {
+            if (found_index != npos)
+            {
+                removeFromBucket(index);
+                m_data.removeAt(index);
+            }
+        };
+        _probeEach(*this, rhs, visitor);
+    }
+}
 template<typename T, typename Config, typename Alloc> KUN_INLINE USet<T, Config, Alloc> USet<T, Config, Alloc>::operator&(const USet& rhs) const
 {
     bool        rhs_smaller = size() > rhs.size();
     const USet& a = rhs_smaller ? rhs : *this;
     const USet& b = rhs_smaller ? *this : rhs;
 
-    USet result;
+    USet result(m_data.allocator());
     result.reserve(a.size());
-
-    for (const auto& v : a)
+    auto visitor = [&](SizeType index, SizeType found_index)
     {
-        if (b.contain(keyOf(v)))
+        if (found_index != npos)
         {
-            result.add(v);
+            const DataType& data = a.m_data[index];
+            result.emplaceAnywayHashed(data.hash, data.data);
         }
-    }
-
+    };
+    _probeEach(a, b, visitor);
     return result;
 }
 template<typename T, typename Config, typename Alloc> KUN_INLINE USet<T, Config, Alloc> USet<T, Config, Alloc>::operator|(const USet& rhs) const
 {
-    USet result(*this);
-    for (const auto& v : rhs) { result.add(v); }
+    USet result(*this, m_data.allocator());
+    result.unionWith(rhs);
     return result;
 }
 template<typename T, typename Config, typename Alloc> KUN_INLINE USet<T, Config, Alloc> USet<T, Config, Alloc>::operator^(const USet& rhs) const
 {
-    USet result(size());
+    USet result(m_data.allocator());
+    result.reserve(size() + rhs.size());
 
-    for (const auto& v : *this)
+    // both side must be probed, every element may be a part of result
+    auto lhs_visitor = [&](SizeType index, SizeType found_index)
     {
-        if (!rhs.contain(keyOf(v)))
+        if (found_index == npos)
         {
-            result.add(v);
+            const DataType& data = m_data[index];
+            result.emplaceAnywayHashed(data.hash, data.data);
         }
-    }
-
-    for (const auto& v : rhs)
+    };
+    _probeEach(*this, rhs, lhs_visitor);
+    auto rhs_visitor = [&](SizeType index, SizeType found_index)
     {
-        if (!contain(v))
+        if (found_index == npos)
         {
-            result.add(v);
+            const DataType& data = rhs.m_data[index];
+            result.emplaceAnywayHashed(data.hash, data.data);
         }
-    }
+    };
+    _probeEach(rhs, *this, rhs_visitor);
 
     return result;
 }
 template<typename T, typename Config, typename Alloc> KUN_INLINE USet<T, Config, Alloc> USet<T, Config, Alloc>::operator-(const USet& rhs) const
 {
-    USet result(size());
-
-    for (const auto& v : *this)
+    if (!Config::multi_key && rhs.size() < size() / 2)
+    {
+        // few to remove, copy and remove is cheaper than probe every element
+        USet result(*this, m_data.allocator());
+        result.subtract(rhs);
+        return result;
+    }
+    else
     {
-        if (!rhs.contain(keyOf(v)))
+        USet result(m_data.allocator());
+        result.reserve(size());
+        auto visitor = [&](SizeType index, SizeType found_index)
         {
-            result.add(v);
-        }
+            if (found_index == npos)
+            {
+                const DataType& data = m_data[index];
+                result.emplaceAnywayHashed(data.hash, data.data);
+            }
+        };
+        _probeEach(*this, rhs, visitor);
+        return result;
     }
-
-    return result;
 }
 template<typename T, typename Config, typename Alloc> KUN_INLINE bool USet<T, Config, Alloc>::isSubsetOf(const USet& rhs) const
 {
-    if (rhs.size() <= size())
+    if (size() <= rhs.size())
     {
-        for (const auto& v : rhs)
+        for (auto it = m_data.begin(); it; ++it)
         {
-            if (!contain(keyOf(v)))
+            if (!rhs.containHashed(keyOf(it->data), it->hash))
             {
                 return false;
             }
@@ -1273,4 +2091,18 @@ template<typename T, typename Config, typename Alloc> KUN_INLINE typename USet<T
 {
     return CIt(m_data.data(), m_data.sparseSize(), m_data.bitArray(), m_data.sparseSize());
 }
+
+// parallel foreach
+template<typename T, typename Config, typename Alloc> template<typename TF> KUN_INLINE void USet<T, Config, Alloc>::parallelForEach(TF&& func, SizeType grain)
+{
+    algo::parallelForBits(m_data.sparseSize(), grain, [&](SizeType begin, SizeType end) {
+        for (It it(m_data.data(), end, m_data.bitArray(), begin); it; ++it) { func(*it); }
+    });
+}
+template<typename T, typename Config, typename Alloc> template<typename TF> KUN_INLINE void USet<T, Config, Alloc>::parallelForEach(TF&& func, SizeType grain) const
+{
+    algo::parallelForBits(m_data.sparseSize(), grain, [&](SizeType begin, SizeType end) {
+        for (CIt it(m_data.data(), end, m_data.bitArray(), begin); it; ++it) { func(*it); }
+    });
+}
 }// namespace kun
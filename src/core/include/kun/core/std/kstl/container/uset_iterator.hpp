@@ -7,11 +7,12 @@
 namespace kun
 {
 // data def
+// next is placed before hash, so small T and u32 index share one 8 bytes slot
 template<typename T, typename TS, typename HashType> struct USetData
 {
     T          data;
-    HashType   hash;
     mutable TS next;
+    HashType   hash;
 };
 // data info
 template<typename T, typename TS> struct USetDataInfo
@@ -32,7 +33,7 @@ template<typename T, typename TS> struct USetDataInfo
         , already_exist(already_exist)
     {
     }
-    KUN_INLINE    operator bool() { return data != nullptr; }
+    KUN_INLINE    operator bool() const { return data != nullptr; }
     KUN_INLINE T& operator*() const { return *data; }
     KUN_INLINE T* operator->() const { return data; }
 };
@@ -43,6 +44,7 @@ namespace kun
 {
 template<typename T, typename TS, typename TH, bool Const> class USetIt
 {
+public:
     using DataType = USetData<T, TS, TH>;
     using SparseDataType = std::conditional_t<Const, const SparseArrayData<DataType, TS>, SparseArrayData<DataType, TS>>;
     using ValueType = std::conditional_t<Const, const T, T>;
@@ -9,7 +9,7 @@ template<typename Key, typename Value> struct KVPair
 {
     // ctor & dtor
     KVPair();
-    template<typename TK> KVPair(TK&& k);
+    template<typename TK, typename = std::enable_if_t<!std::is_same_v<std::decay_t<TK>, KVPair>>> KVPair(TK&& k);
     template<typename TK, typename TV> KVPair(TK&& k, TV&& v);
     ~KVPair();
 
@@ -40,7 +40,7 @@ namespace kun
 // ctor & dtor
 template<typename Key, typename Value> KUN_INLINE KVPair<Key, Value>::KVPair() = default;
 template<typename Key, typename Value>
-template<typename TK>
+template<typename TK, typename>
 KUN_INLINE KVPair<Key, Value>::KVPair(TK&& k)
     : key(std::forward<TK>(k))
     , value()
@@ -79,4 +79,14 @@ template<typename Key, typename Value> KUN_INLINE bool KVPair<Key, Value>::opera
     return key == rhs.key ? value > rhs.value : key > rhs.key;
 }
 template<typename Key, typename Value> KUN_INLINE bool KVPair<Key, Value>::operator>=(const KVPair& rhs) const { return !(*this < rhs); }
+}// namespace kun
+
+// KVPair key mapper, used by map containers
+namespace kun
+{
+template<typename K, typename V> struct MapKVPairKey
+{
+    KUN_INLINE constexpr K&       operator()(KVPair<K, V>& v) const { return v.key; }
+    KUN_INLINE constexpr const K& operator()(const KVPair<K, V>& v) const { return v.key; }
+};
 }// namespace kun
\ No newline at end of file
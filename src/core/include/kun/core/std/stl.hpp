@@ -1,9 +1,6 @@
 #pragma once
 
 // custom std for cross-platform/cross-stdlib interface, include
-//  - array                 [eastl]
-//  - uset                  [eastl]
-//  - umap                  [eastl]
 //  - string/string_view    [eastl]
 //  - function              [eastl]
 //  - tuple/pair            [eastl]
@@ -17,6 +14,15 @@
 //  - span                  [kstl]
 //  - any                   [kstl]
 //  - bit array             [kstl]
+//  - array                 [kstl]
+//  - sparse array          [kstl]
+//  - uset                  [kstl]
+//  - umap                  [kstl]
+//  - swiss uset            [kstl]
+//  - robin uset            [kstl]
+//  - concurrent uset/umap  [kstl]
+//  - flat set/map          [kstl]
+//  - eytzinger index       [kstl]
 
 // from eastl
 #include "eastl/eastl_allocator.h"
@@ -36,5 +42,13 @@
 #include "kstl/container/bit_array.hpp"
 #include "kstl/container/array.hpp"
 #include "kstl/container/sparse_array.hpp"
+#include "kstl/container/slot_map.hpp"
 #include "kstl/container/uset.hpp"
-#include "kstl/container/umap.hpp"
\ No newline at end of file
+#include "kstl/container/umap.hpp"
+#include "kstl/container/swiss_uset.hpp"
+#include "kstl/container/robin_uset.hpp"
+#include "kstl/container/concurrent_uset.hpp"
+#include "kstl/container/concurrent_umap.hpp"
+#include "kstl/container/flat_set.hpp"
+#include "kstl/container/flat_map.hpp"
+#include "kstl/container/eytzinger_index.hpp"
\ No newline at end of file
@@ -61,4 +61,14 @@ template<typename X, typename Y = X> inline constexpr bool has_move_assign_v = i
 template<typename X, typename Y = X> inline constexpr bool has_copy_ctor_v = is_detected_v<detail::has_copy_ctor, X, Y>;
 template<typename X, typename Y = X> inline constexpr bool has_move_ctor_v = is_detected_v<detail::has_move_ctor, X, Y>;
 
+// trivially relocatable, move T to new address then destruct the old one equals to memcpy, containers can use realloc/memmove for it
+// opt-in by specializing it for types that never point to themselves, e.g. heap owning smart pointers and containers
+template<typename T> struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>>
+{
+};
+template<typename T> struct is_trivially_relocatable<const T> : is_trivially_relocatable<T>
+{
+};
+template<typename T> inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
 }// namespace kun
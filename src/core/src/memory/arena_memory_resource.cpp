@@ -0,0 +1,199 @@
+#include "kun/core/memory/arena_memory_resource.h"
+#include "kun/core/functional/assert.hpp"
+#include <algorithm>
+
+// helper
+namespace kun
+{
+static KUN_INLINE Size arenaAlignUp(Size v, Size alignment) { return (v + alignment - 1) & ~(alignment - 1); }
+static KUN_INLINE Size arenaReadSize(const u8* p)
+{
+    Size size;
+    memory::memcpy(&size, p - sizeof(Size), sizeof(Size));
+    return size;
+}
+static KUN_INLINE void arenaWriteSize(u8* p, Size size) { memory::memcpy(p - sizeof(Size), &size, sizeof(Size)); }
+}// namespace kun
+
+namespace kun
+{
+// ctor & dtor
+ArenaMemoryResource::ArenaMemoryResource(Size chunk_size, IMemoryResource* upstream)
+    : m_head(nullptr)
+    , m_current(nullptr)
+    , m_cursor(nullptr)
+    , m_end(nullptr)
+    , m_last(nullptr)
+    , m_chunk_size(chunk_size)
+    , m_chunk_count(0)
+    , m_reserved_size(0)
+    , m_upstream(upstream)
+{
+    KUN_Assert(m_chunk_size > 0);
+    KUN_Assert(m_upstream != nullptr);
+}
+ArenaMemoryResource::~ArenaMemoryResource() { release(); }
+
+// getter
+Size             ArenaMemoryResource::chunkSize() const { return m_chunk_size; }
+Size             ArenaMemoryResource::chunkCount() const { return m_chunk_count; }
+Size             ArenaMemoryResource::reservedSize() const { return m_reserved_size; }
+IMemoryResource* ArenaMemoryResource::upstream() const { return m_upstream; }
+Size             ArenaMemoryResource::usedSize() const
+{
+    if (!m_current)
+        return 0;
+
+    // chunks before current are counted as fully used
+    Size result = 0;
+    for (Chunk* chunk = m_head; chunk != m_current; chunk = chunk->next) { result += chunk->capacity; }
+    return result + (m_cursor - _chunkBegin(m_current));
+}
+
+// impl IMemoryResource
+void* ArenaMemoryResource::alloc(Size size, Size alignment)
+{
+    // size header is placed just before block
+    alignment = std::max(alignment, (Size)alignof(Size));
+    Size data = arenaAlignUp((Size)m_cursor + sizeof(Size), alignment);
+    if (!m_cursor || data + size > (Size)m_end)
+    {
+        return _allocSlow(size, alignment);
+    }
+
+    u8* p = (u8*)data;
+    arenaWriteSize(p, size);
+    m_cursor = p + size;
+    m_last = p;
+    return p;
+}
+void* ArenaMemoryResource::realloc(void* p, Size size, Size alignment)
+{
+    if (!p)
+    {
+        return alloc(size, alignment);
+    }
+
+    u8*  data = (u8*)p;
+    Size old_size = arenaReadSize(data);
+
+    // resize last block in place
+    alignment = std::max(alignment, (Size)alignof(Size));
+    if (data == m_last && ((Size)data & (alignment - 1)) == 0 && data + size <= m_end)
+    {
+        arenaWriteSize(data, size);
+        m_cursor = data + size;
+        return data;
+    }
+
+    // shrink in place, the tail is wasted until rewind
+    if (size <= old_size && ((Size)data & (alignment - 1)) == 0)
+    {
+        arenaWriteSize(data, size);
+        return data;
+    }
+
+    void* new_p = alloc(size, alignment);
+    memory::memcpy(new_p, data, std::min(old_size, size));
+    return new_p;
+}
+void ArenaMemoryResource::free(void*) {}
+bool ArenaMemoryResource::tryExpand(void* p, Size size)
+{
+    u8* data = (u8*)p;
+
+    // last block grow until chunk end
+    if (data == m_last && data + size <= m_end)
+    {
+        arenaWriteSize(data, size);
+        m_cursor = data + size;
+        return true;
+    }
+
+    // shrink in place
+    if (size <= arenaReadSize(data))
+    {
+        arenaWriteSize(data, size);
+        return true;
+    }
+
+    return false;
+}
+
+// scope
+ArenaMemoryResource::Marker ArenaMemoryResource::mark() const { return {m_current, m_cursor}; }
+void                        ArenaMemoryResource::rewind(const Marker& marker)
+{
+    if (!marker.chunk)
+    {
+        reset();
+        return;
+    }
+
+    m_current = marker.chunk;
+    m_cursor = marker.cursor;
+    m_end = _chunkBegin(m_current) + m_current->capacity;
+    m_last = nullptr;
+}
+void ArenaMemoryResource::reset()
+{
+    m_current = m_head;
+    m_cursor = m_head ? _chunkBegin(m_head) : nullptr;
+    m_end = m_head ? m_cursor + m_head->capacity : nullptr;
+    m_last = nullptr;
+}
+void ArenaMemoryResource::release()
+{
+    Chunk* chunk = m_head;
+    while (chunk)
+    {
+        Chunk* next = chunk->next;
+        m_upstream->free(chunk);
+        chunk = next;
+    }
+
+    m_head = nullptr;
+    m_current = nullptr;
+    m_cursor = nullptr;
+    m_end = nullptr;
+    m_last = nullptr;
+    m_chunk_count = 0;
+    m_reserved_size = 0;
+}
+
+// helper
+void* ArenaMemoryResource::_allocSlow(Size size, Size alignment)
+{
+    Size need = size + sizeof(Size) + alignment;
+
+    // reuse the next chunk kept by rewind, otherwise insert a new chunk after current, oversize block get its own chunk
+    Chunk* next = m_current ? m_current->next : m_head;
+    Chunk* chunk = next;
+    if (!chunk || chunk->capacity < need)
+    {
+        Size capacity = std::max(m_chunk_size, need);
+        chunk = (Chunk*)m_upstream->alloc(sizeof(Chunk) + capacity, alignof(std::max_align_t));
+        chunk->next = next;
+        chunk->capacity = capacity;
+        if (m_current)
+        {
+            m_current->next = chunk;
+        }
+        else
+        {
+            m_head = chunk;
+        }
+        ++m_chunk_count;
+        m_reserved_size += capacity;
+    }
+
+    m_current = chunk;
+    m_cursor = _chunkBegin(chunk);
+    m_end = m_cursor + chunk->capacity;
+
+    void* p = alloc(size, alignment);
+    KUN_Assert(p != nullptr);
+    return p;
+}
+u8* ArenaMemoryResource::_chunkBegin(Chunk* chunk) const { return (u8*)(chunk + 1); }
+}// namespace kun
@@ -11,6 +11,8 @@ void* malloc(Size n, Size alignment) { return mi_malloc_aligned(n, alignment); }
 void* realloc(void* p, Size n, Size alignment) { return mi_realloc_aligned(p, n, alignment); }
 void* malloc(Size n, Size alignment, Size offset) { return mi_malloc_aligned_at(n, alignment, offset); }
 void* realloc(void* p, Size n, Size alignment, Size offset) { return mi_realloc_aligned_at(p, n, alignment, offset); }
+void* expand(void* p, Size n) { return mi_expand(p, n); }
+Size  goodSize(Size n) { return mi_good_size(n); }
 }// namespace kun::memory
 
 // memory ops
@@ -7,11 +7,26 @@ class DefaultMemoryResource : public IMemoryResource
     void* alloc(Size size, Size alignment) override { return ::kun::memory::malloc(size, alignment); }
     void* realloc(void* p, Size size, Size alignment) override { return ::kun::memory::realloc(p, size, alignment); }
     void free(void* p) override { ::kun::memory::free(p); }
+    bool tryExpand(void* p, Size size) override { return ::kun::memory::expand(p, size) != nullptr; }
 };
 
-IMemoryResource* defaultMemoryResource()
+// current resource of thread, nullptr means global
+static thread_local IMemoryResource* t_current_resource = nullptr;
+
+IMemoryResource* globalMemoryResource()
 {
     static DefaultMemoryResource instance;
     return &instance;
 }
-}// namespace kun
\ No newline at end of file
+IMemoryResource* defaultMemoryResource()
+{
+    IMemoryResource* current = t_current_resource;
+    return current ? current : globalMemoryResource();
+}
+IMemoryResource* setCurrentMemoryResource(IMemoryResource* resource)
+{
+    IMemoryResource* prev = t_current_resource;
+    t_current_resource = resource;
+    return prev;
+}
+}// namespace kun
@@ -0,0 +1,329 @@
+#include "kun/core/memory/pool_memory_resource.h"
+#include "kun/core/functional/assert.hpp"
+#include <algorithm>
+#include <new>
+
+// helper
+namespace kun
+{
+static KUN_INLINE Size poolAlignUp(Size v, Size alignment) { return (v + alignment - 1) & ~(alignment - 1); }
+static KUN_INLINE Size poolLowestBit(Size v) { return v & (~v + 1); }
+}// namespace kun
+
+// pool memory resource
+namespace kun
+{
+// ctor & dtor
+PoolMemoryResource::PoolMemoryResource(Size block_size, Size slab_size, IMemoryResource* upstream)
+    : m_free_list(nullptr)
+    , m_cursor(nullptr)
+    , m_end(nullptr)
+    , m_slabs(nullptr)
+    , m_block_size(poolAlignUp(std::max(block_size, (Size)sizeof(FreeBlock)), alignof(FreeBlock)))
+    , m_block_align(std::min(poolLowestBit(m_block_size), max_block_alignment))
+    , m_first_block_offset(poolAlignUp(sizeof(Slab), m_block_align))
+    , m_slab_size(slab_size)
+    , m_slab_count(0)
+    , m_used_count(0)
+    , m_peak_used_count(0)
+    , m_upstream(upstream)
+{
+    KUN_Assert(m_upstream != nullptr);
+    KUN_Assert(m_slab_size && (m_slab_size & (m_slab_size - 1)) == 0);
+    KUN_Assert(m_first_block_offset + m_block_size <= m_slab_size);
+}
+PoolMemoryResource::~PoolMemoryResource() { release(); }
+
+// getter
+Size             PoolMemoryResource::blockSize() const { return m_block_size; }
+Size             PoolMemoryResource::blockAlignment() const { return m_block_align; }
+Size             PoolMemoryResource::blocksPerSlab() const { return (m_slab_size - m_first_block_offset) / m_block_size; }
+Size             PoolMemoryResource::slabSize() const { return m_slab_size; }
+IMemoryResource* PoolMemoryResource::upstream() const { return m_upstream; }
+PoolStats        PoolMemoryResource::stats() const
+{
+    PoolStats result;
+    result.block_size = m_block_size;
+    result.slab_count = m_slab_count;
+    result.block_count = m_slab_count * blocksPerSlab();
+    result.used_count = m_used_count;
+    result.peak_used_count = m_peak_used_count;
+    return result;
+}
+
+// owner of block
+PoolMemoryResource* PoolMemoryResource::ownerOf(const void* p, Size slab_size)
+{
+    return ((const Slab*)((Size)p & ~(slab_size - 1)))->owner;
+}
+
+// impl IMemoryResource
+void* PoolMemoryResource::alloc(Size size, Size alignment)
+{
+    KUN_Assert(size <= m_block_size && alignment <= m_block_align);
+
+    void* p;
+    if (m_free_list)
+    {
+        p = m_free_list;
+        m_free_list = m_free_list->next;
+    }
+    else
+    {
+        if (m_cursor == m_end)
+        {
+            _newSlab();
+        }
+        p = m_cursor;
+        m_cursor += m_block_size;
+    }
+
+    m_peak_used_count = std::max(m_peak_used_count, ++m_used_count);
+    return p;
+}
+void* PoolMemoryResource::realloc(void* p, Size size, Size alignment)
+{
+    if (!p)
+    {
+        return alloc(size, alignment);
+    }
+
+    // block size is fixed, so any fitting request is served in place
+    KUN_Assert(size <= m_block_size && alignment <= m_block_align);
+    return p;
+}
+bool PoolMemoryResource::tryExpand(void*, Size size) { return size <= m_block_size; }
+void PoolMemoryResource::free(void* p)
+{
+    if (p)
+    {
+        KUN_Assert(m_used_count > 0);
+        FreeBlock* block = (FreeBlock*)p;
+        block->next = m_free_list;
+        m_free_list = block;
+        --m_used_count;
+    }
+}
+
+// memory op
+void PoolMemoryResource::reserve(Size block_count)
+{
+    while (m_slab_count * blocksPerSlab() < block_count)
+    {
+        // keep current bump range, it still has blocks to serve
+        u8* cursor = m_cursor;
+        u8* end = m_end;
+        _newSlab();
+        if (cursor != end)
+        {
+            // hand out old range first, link blocks of new slab into free list
+            for (u8* block = m_cursor; block + m_block_size <= m_end; block += m_block_size)
+            {
+                ((FreeBlock*)block)->next = m_free_list;
+                m_free_list = (FreeBlock*)block;
+            }
+            m_cursor = cursor;
+            m_end = end;
+        }
+    }
+}
+void PoolMemoryResource::release()
+{
+    Slab* slab = m_slabs;
+    while (slab)
+    {
+        Slab* next = slab->next;
+        m_upstream->free(slab);
+        slab = next;
+    }
+
+    m_free_list = nullptr;
+    m_cursor = nullptr;
+    m_end = nullptr;
+    m_slabs = nullptr;
+    m_slab_count = 0;
+    m_used_count = 0;
+    m_peak_used_count = 0;
+}
+
+// helper
+void PoolMemoryResource::_newSlab()
+{
+    Slab* slab = (Slab*)m_upstream->alloc(m_slab_size, m_slab_size);
+    KUN_Assert(slab != nullptr);
+    slab->next = m_slabs;
+    slab->owner = this;
+    m_slabs = slab;
+    ++m_slab_count;
+
+    m_cursor = (u8*)slab + m_first_block_offset;
+    m_end = m_cursor + blocksPerSlab() * m_block_size;
+}
+}// namespace kun
+
+// multi pool memory resource
+namespace kun
+{
+// slab upstream
+void* MultiPoolMemoryResource::SlabUpstream::alloc(Size size, Size alignment)
+{
+    void* p = upstream->alloc(size, alignment);
+    slabs->add((Size)p);
+    return p;
+}
+void* MultiPoolMemoryResource::SlabUpstream::realloc(void*, Size, Size)
+{
+    // pools never realloc slabs
+    KUN_Assert(false);
+    return nullptr;
+}
+void MultiPoolMemoryResource::SlabUpstream::free(void* p)
+{
+    slabs->remove((Size)p);
+    upstream->free(p);
+}
+
+// ctor & dtor
+MultiPoolMemoryResource::MultiPoolMemoryResource(Size max_block_size, Size slab_size, IMemoryResource* upstream)
+    : m_pools(PmrAllocator(upstream))
+    , m_slabs(PmrAllocator(upstream))
+    , m_max_block_size(max_block_size)
+    , m_slab_size(slab_size)
+    , m_upstream_count(0)
+    , m_upstream(upstream)
+{
+    KUN_Assert(m_upstream != nullptr);
+    KUN_Assert(m_max_block_size >= 16);
+
+    m_slab_upstream.upstream = m_upstream;
+    m_slab_upstream.slabs = &m_slabs;
+
+    // power of 2 classes with a 1.5x class between, waste at most 1/3 of a block
+    for (Size size = 16; size <= m_max_block_size; size *= 2)
+    {
+        m_pools.add(_newPool(size));
+        Size mid = size + size / 2;
+        if (mid <= m_max_block_size && size >= 32)
+        {
+            m_pools.add(_newPool(mid));
+        }
+    }
+}
+MultiPoolMemoryResource::~MultiPoolMemoryResource()
+{
+    // pools are placed in upstream memory, so they don't depend on default resource
+    for (PoolMemoryResource* pool : m_pools)
+    {
+        pool->~PoolMemoryResource();
+        m_upstream->free(pool);
+    }
+}
+
+// getter
+Size                      MultiPoolMemoryResource::poolCount() const { return m_pools.size(); }
+PoolMemoryResource&       MultiPoolMemoryResource::pool(Size idx) { return *m_pools[idx]; }
+const PoolMemoryResource& MultiPoolMemoryResource::pool(Size idx) const { return *m_pools[idx]; }
+Size                      MultiPoolMemoryResource::maxBlockSize() const { return m_max_block_size; }
+Size                      MultiPoolMemoryResource::upstreamCount() const { return m_upstream_count; }
+IMemoryResource*          MultiPoolMemoryResource::upstream() const { return m_upstream; }
+
+// find pool for request
+Size MultiPoolMemoryResource::poolIndexOf(Size size, Size alignment) const
+{
+    if (size > m_max_block_size)
+        return npos;
+
+    // classes are few, linear scan beat binary search here
+    for (Size i = 0; i < m_pools.size(); ++i)
+    {
+        const PoolMemoryResource* pool = m_pools[i];
+        if (size <= pool->blockSize() && alignment <= pool->blockAlignment())
+            return i;
+    }
+    return npos;
+}
+
+// impl IMemoryResource
+void* MultiPoolMemoryResource::alloc(Size size, Size alignment)
+{
+    Size idx = poolIndexOf(size, alignment);
+    if (idx != npos)
+    {
+        return m_pools[idx]->alloc(size, alignment);
+    }
+
+    ++m_upstream_count;
+    return m_upstream->alloc(size, alignment);
+}
+void* MultiPoolMemoryResource::realloc(void* p, Size size, Size alignment)
+{
+    if (!p)
+    {
+        return alloc(size, alignment);
+    }
+
+    PoolMemoryResource* owner = _ownerOf(p);
+    Size                idx = poolIndexOf(size, alignment);
+
+    // upstream block stay upstream, its size is unknown here, so it can't be copied into pool safely
+    if (!owner)
+    {
+        return m_upstream->realloc(p, size, alignment);
+    }
+
+    // still fit current block
+    if (owner && idx != npos && m_pools[idx] == owner)
+    {
+        return p;
+    }
+
+    // move to other pool or upstream
+    void* new_p = alloc(size, alignment);
+    memory::memcpy(new_p, p, std::min(owner->blockSize(), size));
+    free(p);
+    return new_p;
+}
+bool MultiPoolMemoryResource::tryExpand(void* p, Size size)
+{
+    // block of pool can only grow within its size class
+    if (PoolMemoryResource* owner = _ownerOf(p))
+    {
+        return size <= owner->blockSize();
+    }
+    return m_upstream->tryExpand(p, size);
+}
+void MultiPoolMemoryResource::free(void* p)
+{
+    if (!p)
+        return;
+
+    if (PoolMemoryResource* owner = _ownerOf(p))
+    {
+        owner->free(p);
+    }
+    else
+    {
+        KUN_Assert(m_upstream_count > 0);
+        --m_upstream_count;
+        m_upstream->free(p);
+    }
+}
+
+// memory op
+void MultiPoolMemoryResource::release()
+{
+    for (PoolMemoryResource* pool : m_pools) { pool->release(); }
+}
+
+// helper
+PoolMemoryResource* MultiPoolMemoryResource::_newPool(Size block_size)
+{
+    void* p = m_upstream->alloc(sizeof(PoolMemoryResource), alignof(PoolMemoryResource));
+    return new (p) PoolMemoryResource(block_size, m_slab_size, &m_slab_upstream);
+}
+PoolMemoryResource* MultiPoolMemoryResource::_ownerOf(const void* p) const
+{
+    Size slab = (Size)p & ~(m_slab_size - 1);
+    return m_slabs.contain(slab) ? PoolMemoryResource::ownerOf(p, m_slab_size) : nullptr;
+}
+}// namespace kun
@@ -0,0 +1,60 @@
+#include "kun/core/memory/thread_heap_memory_resource.h"
+#include "kun/core/functional/assert.hpp"
+#include <functional>
+#include <mimalloc.h>
+#include <thread>
+
+// helper
+namespace kun
+{
+static KUN_INLINE Size currentThreadId() { return (Size)std::hash<std::thread::id>()(std::this_thread::get_id()); }
+}// namespace kun
+
+namespace kun
+{
+// ctor & dtor
+ThreadHeapMemoryResource::ThreadHeapMemoryResource()
+    : m_heap(mi_heap_new())
+    , m_owner_thread(currentThreadId())
+{
+    KUN_Assert(m_heap != nullptr);
+}
+ThreadHeapMemoryResource::~ThreadHeapMemoryResource()
+{
+    KUN_Assert(isOwnerThread());
+    mi_heap_destroy(m_heap);
+}
+
+// getter
+mi_heap_s* ThreadHeapMemoryResource::heap() const { return m_heap; }
+bool       ThreadHeapMemoryResource::isOwnerThread() const { return m_owner_thread == currentThreadId(); }
+bool       ThreadHeapMemoryResource::contain(const void* p) const { return mi_heap_contains_block(m_heap, p); }
+
+// impl IMemoryResource
+void* ThreadHeapMemoryResource::alloc(Size size, Size alignment)
+{
+    KUN_Assert(isOwnerThread());
+    return mi_heap_malloc_aligned(m_heap, size, alignment);
+}
+void* ThreadHeapMemoryResource::realloc(void* p, Size size, Size alignment)
+{
+    KUN_Assert(isOwnerThread());
+    return mi_heap_realloc_aligned(m_heap, p, size, alignment);
+}
+void ThreadHeapMemoryResource::free(void* p) { mi_free(p); }
+bool ThreadHeapMemoryResource::tryExpand(void* p, Size size) { return mi_expand(p, size) != nullptr; }
+
+// memory op
+void ThreadHeapMemoryResource::reset()
+{
+    KUN_Assert(isOwnerThread());
+    mi_heap_destroy(m_heap);
+    m_heap = mi_heap_new();
+    KUN_Assert(m_heap != nullptr);
+}
+void ThreadHeapMemoryResource::collect()
+{
+    KUN_Assert(isOwnerThread());
+    mi_heap_collect(m_heap, false);
+}
+}// namespace kun
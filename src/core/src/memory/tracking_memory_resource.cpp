@@ -0,0 +1,304 @@
+#include "kun/core/memory/tracking_memory_resource.h"
+#include "kun/core/memory/new_delete.h"
+#include "kun/core/functional/assert.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+// global data
+namespace kun
+{
+static inline constexpr Size TRACKING_MAX_TAG = TrackingMemoryResource::max_tag_count;
+
+// counters of a thread, only owner thread write it, other threads read it when aggregate
+// bytes are split into in/out so every counter is monotonic, blocks freed by another thread just move that thread's out
+struct TrackingThreadSlot
+{
+    std::atomic<u64>                 alloc_count[TRACKING_MAX_TAG];
+    std::atomic<u64>                 free_count[TRACKING_MAX_TAG];
+    std::atomic<u64>                 bytes_in[TRACKING_MAX_TAG];
+    std::atomic<u64>                 bytes_out[TRACKING_MAX_TAG];
+    std::atomic<u64>                 total_bytes[TRACKING_MAX_TAG];
+    i64                              sampled_live[TRACKING_MAX_TAG];// owner only
+    std::atomic<bool>                in_use;
+    TrackingThreadSlot*              next;
+};
+
+// tags & slots, slots are never freed and are reused by new threads, so aggregate can walk them without lock
+struct TrackingRegistry
+{
+    std::mutex                       tag_mutex;
+    Name                             tags[TRACKING_MAX_TAG];
+    std::atomic<Size>                tag_count;
+    std::atomic<u64>                 peak_bytes[TRACKING_MAX_TAG];
+    std::atomic<TrackingThreadSlot*> slots;
+};
+static TrackingRegistry& trackingRegistry()
+{
+    static TrackingRegistry instance;
+    return instance;
+}
+
+// return slot to registry when thread exit
+struct TrackingThreadSlotHolder
+{
+    ~TrackingThreadSlotHolder()
+    {
+        if (slot)
+        {
+            slot->in_use.store(false, std::memory_order_release);
+        }
+    }
+
+    TrackingThreadSlot* slot = nullptr;
+};
+static thread_local TrackingThreadSlotHolder t_tracking_slot;
+}// namespace kun
+
+// helper
+namespace kun
+{
+static Size trackingRegisterTag(Name tag)
+{
+    auto&                       registry = trackingRegistry();
+    std::lock_guard<std::mutex> lock(registry.tag_mutex);
+
+    Size count = registry.tag_count.load(std::memory_order_relaxed);
+    for (Size i = 0; i < count; ++i)
+    {
+        if (registry.tags[i] == tag)
+            return i;
+    }
+
+    KUN_Assert(count < TRACKING_MAX_TAG && "too many tracking tags");
+    registry.tags[count] = tag;
+    registry.tag_count.store(count + 1, std::memory_order_release);
+    return count;
+}
+static TrackingThreadSlot* trackingAcquireSlot()
+{
+    auto& registry = trackingRegistry();
+
+    // reuse slot of exited thread
+    for (TrackingThreadSlot* slot = registry.slots.load(std::memory_order_acquire); slot; slot = slot->next)
+    {
+        bool expected = false;
+        if (!slot->in_use.load(std::memory_order_relaxed) && slot->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            return slot;
+    }
+
+    // value initialize, every counter start from zero
+    TrackingThreadSlot* slot = New<TrackingThreadSlot>();
+    slot->in_use.store(true, std::memory_order_relaxed);
+    TrackingThreadSlot* head = registry.slots.load(std::memory_order_relaxed);
+    do
+    {
+        slot->next = head;
+    } while (!registry.slots.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+    return slot;
+}
+static KUN_INLINE TrackingThreadSlot* trackingThreadSlot()
+{
+    if (!t_tracking_slot.slot)
+    {
+        t_tracking_slot.slot = trackingAcquireSlot();
+    }
+    return t_tracking_slot.slot;
+}
+
+// owner thread only, so a plain load & store is enough
+static KUN_INLINE void trackingAdd(std::atomic<u64>& counter, u64 v) { counter.store(counter.load(std::memory_order_relaxed) + v, std::memory_order_relaxed); }
+static KUN_INLINE void trackingMax(std::atomic<u64>& counter, u64 v)
+{
+    u64 cur = counter.load(std::memory_order_relaxed);
+    while (cur < v && !counter.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+}
+
+// sum all slots
+static i64 trackingLiveBytes(Size tag_idx)
+{
+    i64 result = 0;
+    for (TrackingThreadSlot* slot = trackingRegistry().slots.load(std::memory_order_acquire); slot; slot = slot->next)
+    {
+        result += (i64)(slot->bytes_in[tag_idx].load(std::memory_order_relaxed) - slot->bytes_out[tag_idx].load(std::memory_order_relaxed));
+    }
+    return result;
+}
+static TrackingStats trackingAggregate(Size tag_idx)
+{
+    auto& registry = trackingRegistry();
+
+    TrackingStats result;
+    result.tag = registry.tags[tag_idx];
+    u64 bytes_in = 0, bytes_out = 0;
+    for (TrackingThreadSlot* slot = registry.slots.load(std::memory_order_acquire); slot; slot = slot->next)
+    {
+        result.alloc_count += (Size)slot->alloc_count[tag_idx].load(std::memory_order_relaxed);
+        result.free_count += (Size)slot->free_count[tag_idx].load(std::memory_order_relaxed);
+        result.total_bytes += (Size)slot->total_bytes[tag_idx].load(std::memory_order_relaxed);
+        bytes_in += slot->bytes_in[tag_idx].load(std::memory_order_relaxed);
+        bytes_out += slot->bytes_out[tag_idx].load(std::memory_order_relaxed);
+    }
+
+    // counters are read one by one while other threads keep running, clamp the transient negative
+    result.live_count = result.alloc_count > result.free_count ? result.alloc_count - result.free_count : 0;
+    result.live_bytes = bytes_in > bytes_out ? (Size)(bytes_in - bytes_out) : 0;
+    trackingMax(registry.peak_bytes[tag_idx], result.live_bytes);
+    result.peak_bytes = (Size)registry.peak_bytes[tag_idx].load(std::memory_order_relaxed);
+    return result;
+}
+
+// record
+static KUN_INLINE void trackingSamplePeak(TrackingThreadSlot* slot, Size tag_idx)
+{
+    i64  local_live = (i64)(slot->bytes_in[tag_idx].load(std::memory_order_relaxed) - slot->bytes_out[tag_idx].load(std::memory_order_relaxed));
+    i64& sampled = slot->sampled_live[tag_idx];
+    if (local_live >= sampled + (i64)TrackingMemoryResource::peak_sample_granularity)
+    {
+        sampled = local_live;
+        trackingMax(trackingRegistry().peak_bytes[tag_idx], (u64)std::max(trackingLiveBytes(tag_idx), (i64)0));
+    }
+    else if (local_live + (i64)TrackingMemoryResource::peak_sample_granularity <= sampled)
+    {
+        sampled = local_live;
+    }
+}
+static KUN_INLINE void trackingRecordAlloc(Size tag_idx, Size size)
+{
+    TrackingThreadSlot* slot = trackingThreadSlot();
+    trackingAdd(slot->alloc_count[tag_idx], 1);
+    trackingAdd(slot->bytes_in[tag_idx], size);
+    trackingAdd(slot->total_bytes[tag_idx], size);
+    trackingSamplePeak(slot, tag_idx);
+}
+static KUN_INLINE void trackingRecordRealloc(Size tag_idx, Size old_size, Size size)
+{
+    TrackingThreadSlot* slot = trackingThreadSlot();
+    trackingAdd(slot->bytes_in[tag_idx], size);
+    trackingAdd(slot->bytes_out[tag_idx], old_size);
+    if (size > old_size)
+    {
+        trackingAdd(slot->total_bytes[tag_idx], size - old_size);
+    }
+    trackingSamplePeak(slot, tag_idx);
+}
+static KUN_INLINE void trackingRecordFree(Size tag_idx, Size size)
+{
+    TrackingThreadSlot* slot = trackingThreadSlot();
+    trackingAdd(slot->free_count[tag_idx], 1);
+    trackingAdd(slot->bytes_out[tag_idx], size);
+}
+
+// block header, placed just before block
+struct TrackingHeader
+{
+    Size size;
+    Size offset;// from upstream block to user block
+};
+static KUN_INLINE Size trackingAlignment(Size alignment) { return std::max(alignment, (Size)alignof(TrackingHeader)); }
+static KUN_INLINE Size trackingHeaderSize(Size alignment) { return (sizeof(TrackingHeader) + alignment - 1) & ~(alignment - 1); }
+static KUN_INLINE TrackingHeader* trackingHeaderOf(void* p) { return (TrackingHeader*)p - 1; }
+}// namespace kun
+
+namespace kun
+{
+// ctor & dtor
+TrackingMemoryResource::TrackingMemoryResource(Name tag, IMemoryResource* upstream)
+    : m_tag_idx(trackingRegisterTag(tag))
+    , m_upstream(upstream)
+{
+    KUN_Assert(m_upstream != nullptr);
+}
+TrackingMemoryResource::~TrackingMemoryResource() = default;
+
+// getter
+Name             TrackingMemoryResource::tag() const { return trackingRegistry().tags[m_tag_idx]; }
+IMemoryResource* TrackingMemoryResource::upstream() const { return m_upstream; }
+TrackingStats    TrackingMemoryResource::stats() const { return trackingAggregate(m_tag_idx); }
+
+// statistics of all tags
+TrackingStats TrackingMemoryResource::stats(Name tag)
+{
+    auto& registry = trackingRegistry();
+    Size  count = registry.tag_count.load(std::memory_order_acquire);
+    for (Size i = 0; i < count; ++i)
+    {
+        if (registry.tags[i] == tag)
+            return trackingAggregate(i);
+    }
+
+    TrackingStats result;
+    result.tag = tag;
+    return result;
+}
+void TrackingMemoryResource::snapshot(Array<TrackingStats>& out)
+{
+    Size count = trackingRegistry().tag_count.load(std::memory_order_acquire);
+    out.clear();
+    out.reserve(count);
+    for (Size i = 0; i < count; ++i) { out.add(trackingAggregate(i)); }
+}
+
+// impl IMemoryResource
+void* TrackingMemoryResource::alloc(Size size, Size alignment)
+{
+    alignment = trackingAlignment(alignment);
+    Size header_size = trackingHeaderSize(alignment);
+    u8*  base = (u8*)m_upstream->alloc(size + header_size, alignment);
+    if (!base)
+        return nullptr;
+
+    u8* p = base + header_size;
+    *trackingHeaderOf(p) = {size, header_size};
+    trackingRecordAlloc(m_tag_idx, size);
+    return p;
+}
+void* TrackingMemoryResource::realloc(void* p, Size size, Size alignment)
+{
+    if (!p)
+    {
+        return alloc(size, alignment);
+    }
+
+    TrackingHeader old = *trackingHeaderOf(p);
+    alignment = trackingAlignment(alignment);
+    Size header_size = trackingHeaderSize(alignment);
+
+    // header size changed with alignment, upstream realloc would misplace data
+    if (header_size != old.offset)
+    {
+        void* new_p = alloc(size, alignment);
+        memory::memcpy(new_p, p, std::min(old.size, size));
+        free(p);
+        return new_p;
+    }
+
+    u8* base = (u8*)m_upstream->realloc((u8*)p - old.offset, size + header_size, alignment);
+    if (!base)
+        return nullptr;
+
+    u8* new_p = base + header_size;
+    *trackingHeaderOf(new_p) = {size, header_size};
+    trackingRecordRealloc(m_tag_idx, old.size, size);
+    return new_p;
+}
+bool TrackingMemoryResource::tryExpand(void* p, Size size)
+{
+    TrackingHeader* header = trackingHeaderOf(p);
+    if (!m_upstream->tryExpand((u8*)p - header->offset, size + header->offset))
+        return false;
+
+    trackingRecordRealloc(m_tag_idx, header->size, size);
+    header->size = size;
+    return true;
+}
+void TrackingMemoryResource::free(void* p)
+{
+    if (p)
+    {
+        TrackingHeader header = *trackingHeaderOf(p);
+        trackingRecordFree(m_tag_idx, header.size);
+        m_upstream->free((u8*)p - header.offset);
+    }
+}
+}// namespace kun
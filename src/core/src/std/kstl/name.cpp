@@ -27,7 +27,8 @@ static Size& curPageIdx()
 // name set
 static UMap<StringView, Size>& nameIdxMap()
 {
-    static UMap<StringView, Size> instance;
+    // live for whole process, never take current resource of the first calling thread
+    static UMap<StringView, Size> instance = UMap<StringView, Size>(PmrAllocator(globalMemoryResource()));
     return instance;
 }
 
@@ -68,10 +69,10 @@ Name::Name(StringView str)
     auto& cur_page_idx = curPageIdx();
 
     // find name
-    auto idx_find_it = idx_map.find(str);
-    if (idx_find_it != idx_map.end())
+    Size hash = Hash<StringView>()(str);
+    if (auto found_idx = idx_map.findValueHashed(str, hash))
     {
-        m_idx = idx_find_it->second;
+        m_idx = *found_idx;
     }
     else
     {
@@ -99,7 +100,7 @@ Name::Name(StringView str)
 
         // add to map
         StringView view(dst_ptr, str.length());
-        idx_map[view] = m_idx;
+        idx_map.addAnywayHashed(view, m_idx, hash);
 
         // update cur idx
         cur_page_idx = next_page_idx;
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+
+namespace
+{
+// not relocatable, count move when container relocate it
+struct ArenaMoveItem
+{
+    ArenaMoveItem(kun::u32 v = 0)
+        : value(v)
+    {
+    }
+    ArenaMoveItem(const ArenaMoveItem& other)
+        : value(other.value)
+    {
+    }
+    ArenaMoveItem(ArenaMoveItem&& other)
+        : value(other.value)
+    {
+        ++move_count;
+    }
+    ~ArenaMoveItem() {}
+
+    kun::u32 value;
+
+    static inline kun::Size move_count = 0;
+};
+}// namespace
+
+TEST(TestCore, test_arena_memory_resource)
+{
+    using namespace kun;
+
+    // alloc
+    {
+        ArenaMemoryResource arena(1024);
+        ASSERT_EQ(arena.chunkCount(), 0);
+        ASSERT_EQ(arena.usedSize(), 0);
+
+        void* a = arena.alloc(100, 8);
+        void* b = arena.alloc(100, 64);
+        ASSERT_NE(a, nullptr);
+        ASSERT_EQ((Size)a % 8, 0);
+        ASSERT_EQ((Size)b % 64, 0);
+        ASSERT_GE((u8*)b, (u8*)a + 100);
+        ASSERT_EQ(arena.chunkCount(), 1);
+
+        // oversize block get its own chunk
+        void* c = arena.alloc(4096, 16);
+        memory::memset(c, 1, 4096);
+        ASSERT_EQ(arena.chunkCount(), 2);
+        ASSERT_GE(arena.reservedSize(), 1024 + 4096);
+
+        // free is no-op
+        Size used = arena.usedSize();
+        arena.free(a);
+        ASSERT_EQ(arena.usedSize(), used);
+    }
+
+    // realloc
+    {
+        ArenaMemoryResource arena(1024);
+        u8*                 a = (u8*)arena.alloc(16, 8);
+        for (u8 i = 0; i < 16; ++i) { a[i] = i; }
+
+        // last block grow in place
+        u8* b = (u8*)arena.realloc(a, 64, 8);
+        ASSERT_EQ(a, b);
+
+        // not last block, copy
+        arena.alloc(8, 8);
+        u8* c = (u8*)arena.realloc(b, 128, 8);
+        ASSERT_NE(b, c);
+        for (u8 i = 0; i < 16; ++i) { ASSERT_EQ(c[i], i); }
+
+        // cross chunk
+        u8* d = (u8*)arena.realloc(c, 2048, 8);
+        for (u8 i = 0; i < 16; ++i) { ASSERT_EQ(d[i], i); }
+    }
+
+    // mark & rewind
+    {
+        ArenaMemoryResource arena(1024);
+        void*               a = arena.alloc(100, 8);
+        auto                marker = arena.mark();
+        Size                used = arena.usedSize();
+
+        void* b = arena.alloc(100, 8);
+        for (int i = 0; i < 10; ++i) { arena.alloc(1000, 8); }
+        Size chunk_count = arena.chunkCount();
+        ASSERT_GT(chunk_count, 1);
+
+        arena.rewind(marker);
+        ASSERT_EQ(arena.usedSize(), used);
+        ASSERT_EQ(arena.alloc(100, 8), b);
+
+        // chunks are reused after rewind
+        arena.rewind(marker);
+        for (int i = 0; i < 10; ++i) { arena.alloc(1000, 8); }
+        ASSERT_EQ(arena.chunkCount(), chunk_count);
+
+        // scope
+        used = arena.usedSize();
+        {
+            ArenaScope scope(arena);
+            arena.alloc(500, 8);
+            ASSERT_GT(arena.usedSize(), used);
+        }
+        ASSERT_EQ(arena.usedSize(), used);
+
+        // reset
+        arena.reset();
+        ASSERT_EQ(arena.usedSize(), 0);
+        ASSERT_EQ(arena.alloc(100, 8), a);
+
+        arena.release();
+        ASSERT_EQ(arena.chunkCount(), 0);
+        ASSERT_EQ(arena.reservedSize(), 0);
+    }
+
+    // containers
+    {
+        ArenaMemoryResource arena;
+        PmrAllocator        alloc(&arena);
+        {
+            ArenaScope  scope(arena);
+            Array<u32>  a(alloc);
+            USet<u32>   b(alloc);
+            SparseArray<u32> c(alloc);
+            for (u32 i = 0; i < 1000; ++i)
+            {
+                a.add(i);
+                b.add(i);
+                c.add(i);
+            }
+            ASSERT_EQ(a.size(), 1000);
+            ASSERT_EQ(b.size(), 1000);
+            ASSERT_EQ(c.size(), 1000);
+            for (u32 i = 0; i < 1000; ++i)
+            {
+                ASSERT_EQ(a[i], i);
+                ASSERT_TRUE(b.contain(i));
+                ASSERT_EQ(c[i], i);
+            }
+            ASSERT_GT(arena.usedSize(), 0);
+        }
+        ASSERT_EQ(arena.usedSize(), 0);
+    }
+
+    // expand in place
+    {
+        ArenaMemoryResource arena(1024);
+        void*               a = arena.alloc(100, 8);
+        ASSERT_TRUE(arena.tryExpand(a, 200));
+        ASSERT_EQ(arena.realloc(a, 200, 8), a);
+        void* b = arena.alloc(16, 8);
+        ASSERT_FALSE(arena.tryExpand(a, 300));// not last block
+        ASSERT_TRUE(arena.tryExpand(a, 50));  // shrink
+        ASSERT_FALSE(arena.tryExpand(b, 2048));// out of chunk
+    }
+
+    // array of non relocatable items grow without move
+    {
+        ArenaMemoryResource arena;
+        PmrAllocator        alloc(&arena);
+        ArenaMoveItem::move_count = 0;
+        Array<ArenaMoveItem> a(alloc);
+        for (u32 i = 0; i < 1000; ++i) { a.add(ArenaMoveItem(i)); }
+        ASSERT_EQ(ArenaMoveItem::move_count, 1000);// move temp into array
+        for (u32 i = 0; i < 1000; ++i) { ASSERT_EQ(a[i].value, i); }
+        ASSERT_EQ(arena.chunkCount(), 1);
+    }
+}
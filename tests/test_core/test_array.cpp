@@ -1,6 +1,48 @@
 #include <gtest/gtest.h>
 #include <kun/core/mimimal.h>
 
+namespace
+{
+// own heap memory and count move/dtor, opt-in relocatable
+struct RelocItem
+{
+    RelocItem(kun::u32 v = 0)
+        : value(kun::New<kun::u32>(v))
+    {
+    }
+    RelocItem(const RelocItem& other)
+        : value(kun::New<kun::u32>(*other.value))
+    {
+    }
+    RelocItem(RelocItem&& other)
+        : value(other.value)
+    {
+        other.value = nullptr;
+        ++move_count;
+    }
+    ~RelocItem()
+    {
+        if (value)
+        {
+            kun::Delete(value);
+        }
+    }
+    RelocItem& operator=(const RelocItem& rhs)
+    {
+        *value = *rhs.value;
+        return *this;
+    }
+    bool operator<(const RelocItem& rhs) const { return *value < *rhs.value; }
+
+    kun::u32* value;
+
+    static inline kun::Size move_count = 0;
+};
+}// namespace
+template<> struct kun::is_trivially_relocatable<RelocItem> : std::true_type
+{
+};
+
 TEST(TestCore, test_array)
 {
     using namespace kun;
@@ -537,3 +579,71 @@ TEST(TestCore, test_array)
 
     // [needn't test] support foreach
 }
+
+TEST(TestCore, test_array_relocatable)
+{
+    using namespace kun;
+
+    static_assert(is_trivially_relocatable_v<UPtr<u32>>);
+    static_assert(is_trivially_relocatable_v<SPtr<u32>>);
+    static_assert(is_trivially_relocatable_v<String>);
+    static_assert(is_trivially_relocatable_v<Name>);
+    static_assert(is_trivially_relocatable_v<Array<String>>);
+    static_assert(is_trivially_relocatable_v<USet<u32>>);
+    static_assert(!is_trivially_relocatable_v<InlineArray<u32, 4>>);
+
+    // growth, add at, remove at, sort never call move
+    {
+        RelocItem::move_count = 0;
+        Array<RelocItem> a;
+        for (u32 i = 0; i < 100; ++i) { a.add(RelocItem(99 - i)); }
+        Size add_move_count = RelocItem::move_count;
+        ASSERT_EQ(add_move_count, 100);// move temp into array
+
+        a.addAt(10, RelocItem(1000));
+        a.removeAt(0, 5);
+        a.removeAtSwap(0, 3);
+        a.sort();
+        ASSERT_EQ(RelocItem::move_count, add_move_count + 1);
+        ASSERT_EQ(a.size(), 93);
+        for (u32 i = 1; i < a.size(); ++i) { ASSERT_LT(*a[i - 1].value, *a[i].value); }
+        ASSERT_EQ(*a.last(1).value, 1000);
+    }
+
+    // array of smart pointers & strings
+    {
+        Array<UPtr<u32>> a;
+        for (u32 i = 0; i < 100; ++i) { a.add(makeUPtr<u32>(i)); }
+        a.removeAt(10, 10);
+        a.addAt(0, makeUPtr<u32>(1000));
+        ASSERT_EQ(*a[0], 1000);
+        ASSERT_EQ(*a[1], 0);
+        ASSERT_EQ(*a[11], 20);
+
+        Array<String> b;
+        for (u32 i = 0; i < 100; ++i) { b.add(String(std::to_string(99 - i).c_str())); }
+        b.sort();
+        ASSERT_EQ(b[0], String("0"));
+        ASSERT_EQ(b[99], String("99"));
+        b.removeAtSwap(0, 50);
+        ASSERT_EQ(b.size(), 50);
+    }
+
+    // nested containers
+    {
+        Array<Array<String>> a;
+        for (u32 i = 0; i < 50; ++i) { a.add(Array<String>({String("kun"), String("graph")})); }
+        a.removeAt(0, 10);
+        a.addAt(5, Array<String>({String("node")}));
+        ASSERT_EQ(a.size(), 41);
+        ASSERT_EQ(a[5][0], String("node"));
+        ASSERT_EQ(a[40][1], String("graph"));
+
+        SparseArray<String> s;
+        for (u32 i = 0; i < 100; ++i) { s.add(String("kun")); }
+        for (u32 i = 0; i < 100; i += 2) { s.removeAt(i); }
+        s.compact();
+        ASSERT_EQ(s.size(), 50);
+        for (const String& v : s) { ASSERT_EQ(v, String("kun")); }
+    }
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+
+TEST(TestCore, test_compact_index)
+{
+    using namespace kun;
+
+    using Set32 = USet<u32, USetConfigDefault<u32>, PmrAllocator32>;
+    using MultiSet32 = USet<u32, USetConfigDefault<u32, true>, PmrAllocator32>;
+    using Map32 = UMap<u32, u32, UMapConfigDefault<u32, u32>, PmrAllocator32>;
+
+    // layout
+    {
+        static_assert(std::is_same_v<Array<u32, PmrAllocator32>::SizeType, u32>);
+        static_assert(std::is_same_v<Set32::SizeType, u32>);
+        static_assert(Set32::npos == 0xFFFFFFFFu);
+        ASSERT_EQ(sizeof(SparseArray<u32, PmrAllocator32>::DataType), 8);
+        ASSERT_LT(sizeof(Set32::DataType), sizeof(USet<u32>::DataType));
+        ASSERT_LT(sizeof(Array<u32, MiAllocator32>), sizeof(Array<u32, MiAllocator>));
+    }
+
+    // array & bit array
+    {
+        Array<u32, PmrAllocator32> a;
+        for (u32 i = 0; i < 1000; ++i) { a.add(i); }
+        ASSERT_EQ(a.find(500), a.data() + 500);
+        ASSERT_EQ(a.remove(5000), decltype(a)::npos);
+        ASSERT_EQ(a.remove(500), 500);
+        a.removeAt(0, 500);
+        ASSERT_EQ(a[0], 501);
+
+        BitArray<PmrAllocator32> b;
+        b.add(false, 1000);
+        ASSERT_EQ(b.find(true), decltype(b)::npos);
+        ASSERT_FALSE(b.contain(true));
+        b[700] = true;
+        b[300] = true;
+        ASSERT_EQ(b.find(true), 300);
+        ASSERT_EQ(b.findLast(true), 700);
+        u32 count = 0;
+        for (auto it = decltype(b)::TIt(b); it; ++it)
+        {
+            ASSERT_TRUE(it.index() == 300 || it.index() == 700);
+            ++count;
+        }
+        ASSERT_EQ(count, 2);
+    }
+
+    // sparse array, free list link use npos of u32
+    {
+        SparseArray<u32, PmrAllocator32> a;
+        for (u32 i = 0; i < 1000; ++i) { a.add(i); }
+        for (u32 i = 0; i < 1000; i += 3) { a.removeAt(i); }
+        ASSERT_EQ(a.holeSize(), 334);
+        ASSERT_FALSE(a.find(3));
+        ASSERT_EQ(a.find(3).index, decltype(a)::npos);
+        for (u32 i = 0; i < 334; ++i) { a.add(i + 1000); }
+        ASSERT_EQ(a.holeSize(), 0);
+        ASSERT_EQ(a.freelistHead(), decltype(a)::npos);
+        ASSERT_EQ(a.sparseSize(), 1000);
+
+        u32 count = 0;
+        for (u32 v : a)
+        {
+            ASSERT_TRUE(v >= 1000 || v % 3 != 0);
+            ++count;
+        }
+        ASSERT_EQ(count, 1000);
+
+        a.removeAt(10);
+        a.removeAt(20);
+        ASSERT_TRUE(a.compact());
+        ASSERT_EQ(a.sparseSize(), 998);
+        ASSERT_TRUE(a.isCompact());
+    }
+
+    // sets & maps
+    {
+        Set32 a;
+        for (u32 i = 0; i < 10000; ++i) { a.add(i); }
+        for (u32 i = 0; i < 10000; i += 2) { ASSERT_NE(a.remove(i), Set32::npos); }
+        ASSERT_EQ(a.remove(0), Set32::npos);
+        ASSERT_EQ(a.size(), 5000);
+        for (u32 i = 0; i < 10000; ++i) { ASSERT_EQ(a.contain(i), i % 2 == 1); }
+        ASSERT_FALSE(a.find(0));
+        ASSERT_EQ(a.find(0).index, Set32::npos);
+        u32 count = 0;
+        for (u32 v : a)
+        {
+            ASSERT_EQ(v % 2, 1);
+            ++count;
+        }
+        ASSERT_EQ(count, 5000);
+        a.compact();
+        a.rehash();
+        for (u32 i = 1; i < 10000; i += 2) { ASSERT_TRUE(a.contain(i)); }
+
+        // bulk path
+        Array<u32> items;
+        for (u32 i = 0; i < 5000; ++i) { items.add(i % 2500); }
+        Set32 b(items.data(), (u32)items.size());
+        ASSERT_EQ(b.size(), 2500);
+        Set32 c = a & b;
+        ASSERT_EQ(c.size(), 1250);
+
+        MultiSet32 m;
+        for (u32 i = 0; i < 100; ++i) { m.addAnyway(i % 10); }
+        ASSERT_EQ(m.count(3), 10);
+        ASSERT_EQ(m.removeAll(3), 10);
+        ASSERT_EQ(m.count(3), 0);
+
+        Map32 map;
+        for (u32 i = 0; i < 1000; ++i) { map.add(i, i * 2); }
+        ASSERT_EQ(map.find(500)->value, 1000);
+        ASSERT_FALSE(map.find(5000));
+
+        SwissUSet<u32, USetConfigDefault<u32>, PmrAllocator32> swiss;
+        RobinUSet<u32, USetConfigDefault<u32>, PmrAllocator32> robin;
+        FlatSet<u32, FlatSetConfigDefault<u32>, PmrAllocator32> flat;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            swiss.add(i);
+            robin.add(i);
+            flat.add(i);
+        }
+        for (u32 i = 0; i < 1000; i += 2)
+        {
+            swiss.remove(i);
+            robin.remove(i);
+            flat.remove(i);
+        }
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            ASSERT_EQ(swiss.contain(i), i % 2 == 1);
+            ASSERT_EQ(robin.contain(i), i % 2 == 1);
+            ASSERT_EQ(flat.contain(i), i % 2 == 1);
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+
+TEST(TestCore, test_compact_sparse_array)
+{
+    using namespace kun;
+
+    // layout
+    {
+        ASSERT_EQ(sizeof(SparseArray<u32>::DataType), 16);
+        ASSERT_EQ(sizeof(CompactSparseArray<u32>::DataType), 8);
+        ASSERT_EQ(sizeof(CompactSparseArray<u32, PmrAllocator32>::DataType), 4);
+        ASSERT_EQ(sizeof(CompactSparseArray<u64, PmrAllocator32>::DataType), 8);
+    }
+
+    // add & remove
+    {
+        CompactSparseArray<u32> a;
+        for (u32 i = 0; i < 1000; ++i) { a.add(i); }
+        for (u32 i = 0; i < 1000; i += 2) { a.removeAt(i); }
+        ASSERT_EQ(a.size(), 500);
+        ASSERT_EQ(a.holeSize(), 500);
+        ASSERT_EQ(a.freelistHead(), 998);
+
+        // reuse holes lifo
+        ASSERT_EQ(a.add(1000).index, 998);
+        ASSERT_EQ(a.add(1001).index, 996);
+        ASSERT_EQ(a.holeSize(), 498);
+
+        // add at middle of freelist
+        a.addAt(500, 500);
+        a.addAt(0, 0);
+        ASSERT_EQ(a.holeSize(), 496);
+        ASSERT_EQ(a[500], 500);
+        ASSERT_EQ(a[0], 0);
+        u32 hole_count = 0;
+        for (auto index = a.freelistHead(); index != decltype(a)::npos; index = a.data()[index].next)
+        {
+            ASSERT_TRUE(a.isHole(index));
+            ++hole_count;
+        }
+        ASSERT_EQ(hole_count, a.holeSize());
+
+        // fill all holes
+        while (a.holeSize()) { a.add(2000); }
+        ASSERT_EQ(a.sparseSize(), 1000);
+        ASSERT_EQ(a.freelistHead(), decltype(a)::npos);
+    }
+
+    // compact top
+    {
+        CompactSparseArray<u32> a;
+        for (u32 i = 0; i < 100; ++i) { a.add(i); }
+        for (u32 i = 0; i < 100; i += 3) { a.removeAt(i); }
+        a.removeAt(98);
+        ASSERT_TRUE(a.compactTop());
+        ASSERT_EQ(a.sparseSize(), 98);
+        ASSERT_FALSE(a.compactTop());
+        for (auto index = a.freelistHead(); index != decltype(a)::npos; index = a.data()[index].next)
+        {
+            ASSERT_LT(index, 98);
+        }
+        while (a.holeSize()) { a.add(1000); }
+        ASSERT_EQ(a.sparseSize(), 98);
+        ASSERT_EQ(a.add(1000).index, 98);
+
+        // all hole
+        for (u32 i = 0; i < 99; ++i) { a.removeAt(i); }
+        ASSERT_TRUE(a.compactTop());
+        ASSERT_EQ(a.sparseSize(), 0);
+        ASSERT_EQ(a.holeSize(), 0);
+        ASSERT_EQ(a.freelistHead(), decltype(a)::npos);
+    }
+
+    // compact & copy & iterate
+    {
+        CompactSparseArray<String> a;
+        for (u32 i = 0; i < 100; ++i) { a.add(String("kun")); }
+        for (u32 i = 0; i < 100; i += 2) { a.removeAt(i); }
+        a.reserve(1000);
+        ASSERT_EQ(a.holeSize(), 50);
+
+        CompactSparseArray<String> b = a;
+        ASSERT_EQ(b.size(), 50);
+        ASSERT_EQ(b.holeSize(), 50);
+        ASSERT_EQ(b.add(String("b")).index, 98);
+
+        u32 count = 0;
+        for (const String& s : a)
+        {
+            ASSERT_EQ(s, String("kun"));
+            ++count;
+        }
+        ASSERT_EQ(count, 50);
+
+        ASSERT_TRUE(a.compact());
+        ASSERT_EQ(a.sparseSize(), 50);
+        ASSERT_TRUE(a.isCompact());
+        for (u32 i = 0; i < 50; ++i) { ASSERT_EQ(a[i], String("kun")); }
+        a.shrink();
+        ASSERT_EQ(a.capacity(), 50);
+    }
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+TEST(TestCore, test_concurrent_uset)
+{
+    using namespace kun;
+
+    // single thread
+    {
+        ConcurrentUSet<u32> a;
+        ASSERT_TRUE(a.empty());
+        for (u32 i = 0; i < 1000; ++i) { ASSERT_FALSE(a.add(i)); }
+        ASSERT_EQ(a.size(), 1000);
+        ASSERT_TRUE(a.add(10));
+        ASSERT_TRUE(a.tryAdd(10));
+        ASSERT_FALSE(a.tryAdd(1000));
+        ASSERT_EQ(a.size(), 1001);
+
+        for (u32 i = 0; i <= 1000; ++i) { ASSERT_TRUE(a.contain(i)); }
+        ASSERT_FALSE(a.contain(1001));
+
+        u32 found = 0;
+        ASSERT_TRUE(a.visit(500, [&](const u32& v) { found = v; }));
+        ASSERT_EQ(found, 500);
+        ASSERT_FALSE(a.visit(1001, [&](const u32& v) { found = v; }));
+
+        ASSERT_TRUE(a.remove(10));
+        ASSERT_FALSE(a.remove(10));
+        ASSERT_FALSE(a.contain(10));
+        ASSERT_EQ(a.size(), 1000);
+
+        Size count = 0;
+        a.forEach([&](const u32&) { ++count; });
+        ASSERT_EQ(count, 1000);
+
+        // identity hash must still spread over shards
+        bool shard_used[ConcurrentUSet<u32>::shardCount()] = {};
+        for (u32 i = 0; i < 1000; ++i) { shard_used[a.shardIndex(Hash<u32>()(i))] = true; }
+        for (bool used : shard_used) { ASSERT_TRUE(used); }
+
+        // bucket tag bit (see USet::_tagOf) must still vary inside a shard, or the tag never reject a miss
+        u32 shard_tags[ConcurrentUSet<u32>::shardCount()] = {};
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            Size hash = Hash<u32>()(i);
+            shard_tags[a.shardIndex(hash)] |= 1u << (((u64)hash * 0x9E3779B97F4A7C15ull) >> 60);
+        }
+        for (u32 tags : shard_tags) { ASSERT_NE(tags & (tags - 1), 0u); }
+
+        a.clear();
+        ASSERT_TRUE(a.empty());
+        a.reserve(1000);
+        ASSERT_TRUE(a.empty());
+    }
+
+    // find or add
+    {
+        ConcurrentUSet<u32> a;
+        u32                 create_count = 0;
+        u32                 visited = 0;
+        auto                creator = [&]()
+        {
+            ++create_count;
+            return 114514u;
+        };
+        auto visitor = [&](u32& v) { visited = v; };
+        ASSERT_FALSE(a.findOrAdd(114514, creator, visitor));
+        ASSERT_EQ(visited, 114514);
+        ASSERT_TRUE(a.findOrAdd(114514, creator, visitor));
+        ASSERT_EQ(create_count, 1);
+        ASSERT_EQ(a.size(), 1);
+    }
+
+    // map
+    {
+        ConcurrentUMap<u32, String> a;
+        ASSERT_FALSE(a.add(1u, String("kun")));
+        ASSERT_TRUE(a.add(1u, String("graph")));
+        ASSERT_TRUE(a.tryAdd(1u, String("node")));
+        ASSERT_FALSE(a.tryAdd(2u, String("node")));
+        ASSERT_EQ(a.size(), 2);
+
+        String value;
+        ASSERT_TRUE(a.findValue(1, value));
+        ASSERT_EQ(value, String("graph"));
+        ASSERT_FALSE(a.findValue(3, value));
+
+        auto visitor = [&](String& v) { value = v; };
+        ASSERT_FALSE(a.findOrAddValue(3, []() { return String("pin"); }, visitor));
+        ASSERT_EQ(value, String("pin"));
+        ASSERT_TRUE(a.findOrAddValue(3, []() { return String("none"); }, visitor));
+        ASSERT_EQ(value, String("pin"));
+        ASSERT_TRUE(a.contain(3));
+        ASSERT_TRUE(a.remove(3));
+        ASSERT_EQ(a.size(), 2);
+    }
+
+    // multi thread
+    {
+        constexpr u32 thread_count = 8;
+        constexpr u32 per_thread = 5000;
+
+        ConcurrentUSet<u32>      a;
+        std::vector<std::thread> threads;
+        for (u32 t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back(
+            [&a, t]()
+            {
+                // own range + shared range to make contention
+                for (u32 i = 0; i < per_thread; ++i)
+                {
+                    a.add(t * per_thread + i);
+                    a.tryAdd(thread_count * per_thread + i);
+                    a.contain(i);
+                }
+            });
+        }
+        for (auto& thread : threads) { thread.join(); }
+        ASSERT_EQ(a.size(), (thread_count + 1) * per_thread);
+        for (u32 i = 0; i < (thread_count + 1) * per_thread; ++i) { ASSERT_TRUE(a.contain(i)); }
+
+        // find or add must create once per key
+        ConcurrentUMap<u32, u32> b;
+        std::atomic<u32>         create_count = 0;
+        threads.clear();
+        for (u32 t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back(
+            [&b, &create_count]()
+            {
+                for (u32 i = 0; i < per_thread; ++i)
+                {
+                    auto creator = [&]()
+                    {
+                        ++create_count;
+                        return 0u;
+                    };
+                    // visitor runs under unique lock, every increment must land
+                    auto visitor = [](u32& v) { ++v; };
+                    b.findOrAddValue(i, creator, visitor);
+                }
+            });
+        }
+        for (auto& thread : threads) { thread.join(); }
+        ASSERT_EQ(create_count, per_thread);
+        ASSERT_EQ(b.size(), per_thread);
+        for (u32 i = 0; i < per_thread; ++i)
+        {
+            u32 value = 0;
+            ASSERT_TRUE(b.findValue(i, value));
+            ASSERT_EQ(value, thread_count);
+        }
+    }
+}
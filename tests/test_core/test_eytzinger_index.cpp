@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+
+TEST(TestCore, test_eytzinger_index)
+{
+    using namespace kun;
+
+    // branchless bound
+    {
+        Array<u32> a;
+        for (u32 i = 0; i < 1000; ++i) { a.add(i / 3 * 2); }
+        for (u32 v = 0; v < 700; ++v)
+        {
+            ASSERT_EQ(algo::lowerBoundBranchless(a.begin(), a.end(), v), algo::lowerBound(a.begin(), a.end(), v));
+            ASSERT_EQ(algo::upperBoundBranchless(a.begin(), a.end(), v), algo::upperBound(a.begin(), a.end(), v));
+        }
+        ASSERT_EQ(algo::lowerBoundBranchless(a.begin(), a.begin(), 0u), a.begin());
+        ASSERT_EQ(algo::upperBoundBranchless(a.begin(), a.begin(), 0u), a.begin());
+    }
+
+    // build
+    {
+        EytzingerIndex<u32> a;
+        ASSERT_EQ(a.size(), 0);
+        ASSERT_TRUE(a.empty());
+        ASSERT_EQ(a.lowerBound(0u), 0);
+        ASSERT_EQ(a.find(0u), npos);
+
+        u32                 data[] = {1, 2, 3, 4, 5, 6, 7};
+        EytzingerIndex<u32> b(data, 7);
+        ASSERT_EQ(b.size(), 7);
+        ASSERT_EQ(b.layout()[1], 4);
+        ASSERT_EQ(b.layout()[2], 2);
+        ASSERT_EQ(b.layout()[3], 6);
+        ASSERT_EQ(b.layout()[4], 1);
+        ASSERT_EQ(b.layout()[7], 7);
+        ASSERT_EQ(b.ranks()[0], 7);
+        ASSERT_EQ(b.ranks()[1], 3);
+    }
+
+    // search
+    for (u32 n = 0; n < 100; ++n)
+    {
+        Array<u32> a;
+        for (u32 i = 0; i < n; ++i) { a.add(i / 2 * 3 + 1); }
+
+        EytzingerIndex<u32> index;
+        index.attach(a);
+        ASSERT_EQ(index.size(), n);
+        for (u32 v = 0; v < n * 2 + 3; ++v)
+        {
+            auto lower = (Size)(algo::lowerBound(a.begin(), a.end(), v) - a.begin());
+            auto upper = (Size)(algo::upperBound(a.begin(), a.end(), v) - a.begin());
+            ASSERT_EQ(index.lowerBound(v), lower);
+            ASSERT_EQ(index.upperBound(v), upper);
+            ASSERT_EQ(index.contain(v), lower != upper);
+            if (lower != upper)
+            {
+                ASSERT_EQ(a[index.find(v)], v);
+            }
+        }
+    }
+
+    // custom predicate
+    {
+        Array<u32> a({50, 40, 30, 20, 10});
+        auto       greater = Greater<u32>();
+
+        EytzingerIndex<u32> index;
+        index.attach(a);
+        ASSERT_EQ(index.lowerBound(30u, greater), 2);
+        ASSERT_EQ(index.upperBound(30u, greater), 3);
+        ASSERT_EQ(index.find(25u, greater), npos);
+        ASSERT_EQ(index.find(20u, greater), 3);
+    }
+
+    // copy & move
+    {
+        Array<u32> a;
+        for (u32 i = 0; i < 100; ++i) { a.add(i); }
+        EytzingerIndex<u32> b;
+        b.attach(a);
+
+        EytzingerIndex<u32> c(b);
+        ASSERT_EQ(c.size(), 100);
+        ASSERT_EQ(c.find(50u), 50);
+
+        EytzingerIndex<u32> d(std::move(b));
+        ASSERT_EQ(b.size(), 0);
+        ASSERT_EQ(d.find(99u), 99);
+
+        b = d;
+        ASSERT_EQ(b.find(10u), 10);
+        d.clear();
+        ASSERT_EQ(d.size(), 0);
+        ASSERT_EQ(d.lowerBound(5u), 0);
+    }
+}
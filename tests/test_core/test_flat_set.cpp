@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+
+TEST(TestCore, test_flat_set)
+{
+    using namespace kun;
+
+    // ctor
+    {
+        FlatSet<u32> a;
+        ASSERT_EQ(a.size(), 0);
+        ASSERT_EQ(a.capacity(), 0);
+        ASSERT_FALSE(a.contain(0));
+
+        FlatSet<u32> b({5, 1, 4, 1, 4, 1});
+        ASSERT_EQ(b.size(), 3);
+        ASSERT_TRUE(b.isSorted());
+        ASSERT_EQ(b[0], 1);
+        ASSERT_EQ(b[1], 4);
+        ASSERT_EQ(b[2], 5);
+
+        u32          data[] = {1, 1, 4, 5, 1, 4};
+        FlatSet<u32> c(data, 6);
+        ASSERT_EQ(b, c);
+
+        FlatSet<u32> d(100);
+        ASSERT_EQ(d.size(), 0);
+        ASSERT_GE(d.capacity(), 100);
+    }
+
+    // copy & move
+    {
+        FlatSet<u32> a({1, 1, 4, 5, 1, 4});
+
+        FlatSet<u32> b(a);
+        ASSERT_EQ(a, b);
+
+        FlatSet<u32> c(std::move(a));
+        ASSERT_EQ(a.size(), 0);
+        ASSERT_EQ(c, b);
+
+        a = c;
+        ASSERT_EQ(a, c);
+        b = std::move(c);
+        ASSERT_EQ(c.size(), 0);
+        ASSERT_EQ(a, b);
+    }
+
+    // add & find
+    {
+        FlatSet<u32> a;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            auto info = a.add((i * 7919) % 1000);
+            ASSERT_FALSE(info.already_exist);
+            ASSERT_EQ(*info, (i * 7919) % 1000);
+        }
+        ASSERT_EQ(a.size(), 1000);
+        ASSERT_TRUE(a.isSorted());
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            auto info = a.find(i);
+            ASSERT_TRUE(info);
+            ASSERT_EQ(info.index, i);
+        }
+        ASSERT_FALSE(a.find(1000));
+
+        auto info = a.add(10);
+        ASSERT_TRUE(info.already_exist);
+        info = a.tryAdd(10);
+        ASSERT_TRUE(info.already_exist);
+        info = a.emplace(1000u);
+        ASSERT_FALSE(info.already_exist);
+        ASSERT_EQ(info.index, 1000);
+        ASSERT_EQ(a.size(), 1001);
+    }
+
+    // bound & range
+    {
+        FlatSet<u32> a({10, 20, 30, 40, 50});
+        ASSERT_EQ(a.lowerBound(0), 0);
+        ASSERT_EQ(a.lowerBound(20), 1);
+        ASSERT_EQ(a.upperBound(20), 2);
+        ASSERT_EQ(a.lowerBound(25), 2);
+        ASSERT_EQ(a.upperBound(50), 5);
+        ASSERT_EQ(a.equalRange(30).size(), 1);
+        ASSERT_EQ(a.equalRange(30).data()[0], 30);
+        ASSERT_EQ(a.equalRange(35).size(), 0);
+
+        auto range = a.range(15, 45);
+        ASSERT_EQ(range.size(), 3);
+        ASSERT_EQ(range.data()[0], 20);
+        ASSERT_EQ(range.data()[2], 40);
+        ASSERT_EQ(a.range(45, 15).size(), 0);
+    }
+
+    // remove
+    {
+        FlatSet<u32> a({1, 2, 3, 4, 5, 6});
+        ASSERT_EQ(a.remove(3), 1);
+        ASSERT_EQ(a.remove(3), 0);
+        ASSERT_FALSE(a.contain(3));
+        a.removeAt(0);
+        ASSERT_FALSE(a.contain(1));
+        ASSERT_EQ(a.removeIf([](u32 v) { return v % 2 == 0; }), 3);
+        ASSERT_EQ(a.size(), 1);
+        ASSERT_EQ(a[0], 5);
+    }
+
+    // build & append
+    {
+        FlatSet<u32> a;
+        for (u32 i = 0; i < 1000; i += 2) { a.dataUnsafe().add(999 - i); }
+        a.build();
+        ASSERT_EQ(a.size(), 500);
+        ASSERT_TRUE(a.isSorted());
+
+        Array<u32> items;
+        for (u32 i = 0; i < 1500; ++i) { items.add(1499 - i); }
+        a.append(items.data(), items.size());
+        ASSERT_EQ(a.size(), 1500);
+        ASSERT_TRUE(a.isSorted());
+        for (u32 i = 0; i < 1500; ++i) { ASSERT_EQ(a[i], i); }
+
+        FlatSet<u32> b({2000, 0, 1600});
+        a.append(b);
+        ASSERT_EQ(a.size(), 1502);
+        ASSERT_TRUE(a.isSorted());
+        ASSERT_TRUE(a.contain(1600));
+        ASSERT_TRUE(a.contain(2000));
+
+        a.append({3000, 3000, 1});
+        ASSERT_EQ(a.size(), 1503);
+        ASSERT_EQ(a.count(3000), 1);
+    }
+
+    // multi set
+    {
+        FlatSet<u32, FlatSetConfigDefault<u32, true>> a({3, 1, 3, 2, 3});
+        ASSERT_EQ(a.size(), 5);
+        ASSERT_TRUE(a.isSorted());
+        ASSERT_EQ(a.count(3), 3);
+        a.add(3);
+        a.append({1, 3});
+        ASSERT_EQ(a.count(3), 5);
+        ASSERT_EQ(a.count(1), 2);
+        ASSERT_EQ(a.equalRange(3).size(), 5);
+        ASSERT_EQ(a.removeAll(3), 5);
+        ASSERT_EQ(a.size(), 3);
+    }
+
+    // foreach
+    {
+        FlatSet<u32> a({5, 3, 1, 4, 2});
+        u32          expect = 1;
+        for (u32 v : a)
+        {
+            ASSERT_EQ(v, expect);
+            ++expect;
+        }
+        ASSERT_EQ(expect, 6);
+    }
+}
+
+TEST(TestCore, test_flat_map)
+{
+    using namespace kun;
+
+    // add & find
+    {
+        FlatMap<u32, String> a;
+        a.add(2u, String("b"));
+        a.add(1u, String("a"));
+        a.add(3u, String("c"));
+        ASSERT_EQ(a.size(), 3);
+        ASSERT_TRUE(a.isSorted());
+        ASSERT_EQ(a[0].key, 1);
+        ASSERT_EQ(*a.findValue(2), String("b"));
+        ASSERT_EQ(a.findValue(4), nullptr);
+
+        auto info = a.add(2u, String("bb"));
+        ASSERT_TRUE(info.already_exist);
+        ASSERT_EQ(*a.findValue(2), String("bb"));
+        info = a.tryAdd(2u, String("bbb"));
+        ASSERT_TRUE(info.already_exist);
+        ASSERT_EQ(*a.findValue(2), String("bb"));
+        ASSERT_EQ(a.size(), 3);
+    }
+
+    // build & append, last value win
+    {
+        FlatMap<u32, u32> a({{3, 0}, {1, 0}, {3, 1}, {2, 0}});
+        ASSERT_EQ(a.size(), 3);
+        ASSERT_EQ(*a.findValue(3), 1);
+
+        a.append({{2, 5}, {4, 4}, {2, 6}, {0, 0}});
+        ASSERT_EQ(a.size(), 5);
+        ASSERT_TRUE(a.isSorted());
+        ASSERT_EQ(*a.findValue(2), 6);
+        ASSERT_EQ(*a.findValue(4), 4);
+        ASSERT_EQ(*a.findValue(0), 0);
+    }
+
+    // multi map, equal keys keep insertion order
+    {
+        FlatMap<u32, u32, FlatMapConfigDefault<u32, u32, true>> a;
+        a.add(1u, 1u);
+        a.add(1u, 2u);
+        a.append({{1, 3}, {0, 0}});
+        ASSERT_EQ(a.count(1), 3);
+        auto range = a.equalRange(1);
+        ASSERT_EQ(range.data()[0].value, 1);
+        ASSERT_EQ(range.data()[1].value, 2);
+        ASSERT_EQ(range.data()[2].value, 3);
+    }
+}
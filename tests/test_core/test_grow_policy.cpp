@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+
+TEST(TestCore, test_grow_policy)
+{
+    using namespace kun;
+
+    // policies
+    {
+        // default keep the old behavior
+        ASSERT_EQ(GrowPolicyDefault::grow<Size>(1, 0, 4), 4);
+        ASSERT_EQ(GrowPolicyDefault::grow<Size>(5, 4, 4), 5 + 5 * 3 / 8 + 16);
+        ASSERT_EQ(GrowPolicyDefault::shrink<Size>(10, 200, 4), 10);
+        ASSERT_EQ(GrowPolicyDefault::shrink<Size>(190, 200, 4), 200);
+        ASSERT_EQ(GrowPolicyDefault::grow<u32>(std::numeric_limits<u32>::max(), 100, 4), std::numeric_limits<u32>::max());
+
+        ASSERT_EQ(GrowPolicyExact::grow<Size>(17, 16, 4), 17);
+        ASSERT_EQ(GrowPolicyExact::shrink<Size>(3, 16, 4), 3);
+
+        ASSERT_EQ(GrowPolicyOneHalf::grow<Size>(1, 0, 4), 4);
+        ASSERT_EQ(GrowPolicyOneHalf::grow<Size>(101, 100, 4), 150);
+        ASSERT_EQ(GrowPolicyOneHalf::grow<Size>(200, 100, 4), 200);
+        ASSERT_EQ(GrowPolicyDouble::grow<Size>(101, 100, 4), 200);
+
+        ASSERT_EQ(GrowPolicyPow2::grow<Size>(1, 0, 4), 4);
+        ASSERT_EQ(GrowPolicyPow2::grow<Size>(100, 64, 4), 128);
+        ASSERT_EQ(GrowPolicyPow2::grow<Size>(128, 64, 4), 128);
+        ASSERT_EQ(GrowPolicyPow2::shrink<Size>(100, 1024, 4), 128);
+        ASSERT_EQ(GrowPolicyPow2::shrink<Size>(0, 1024, 4), 0);
+        ASSERT_EQ(GrowPolicyPow2::grow<u32>(std::numeric_limits<u32>::max() - 10, 100, 4), std::numeric_limits<u32>::max() - 10);
+
+        // small block keep base capacity, page sized block fill the page
+        ASSERT_EQ((GrowPolicyPage<GrowPolicyExact>::grow<Size>(100, 0, 4)), 100);
+        ASSERT_EQ((GrowPolicyPage<GrowPolicyExact>::grow<Size>(1025, 0, 4)), 2048);
+        ASSERT_EQ((GrowPolicyPage<GrowPolicyExact>::grow<Size>(1000, 0, 24)), 4096 * 6 / 24);
+        ASSERT_EQ((GrowPolicyPage<GrowPolicyExact>::shrink<Size>(1025, 4096, 4)), 2048);
+
+        // never less than base
+        for (Size size = 1; size < 10000; size += 37)
+        {
+            Size capacity = GrowPolicyMiGoodSize<>::grow<Size>(size, 0, 12);
+            ASSERT_GE(capacity, GrowPolicyDefault::grow<Size>(size, 0, 12));
+            ASSERT_LE(capacity * 12, memory::goodSize(GrowPolicyDefault::grow<Size>(size, 0, 12) * 12));
+        }
+    }
+
+    // containers
+    {
+        Array<u32, GrowPolicyAllocator<GrowPolicyPow2>> a;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            a.add(i);
+            ASSERT_EQ(a.capacity() & (a.capacity() - 1), 0);
+        }
+        ASSERT_EQ(a.capacity(), 1024);
+        a.removeAt(100, 900);
+        a.shrink();
+        ASSERT_EQ(a.capacity(), 128);
+        for (u32 i = 0; i < 100; ++i) { ASSERT_EQ(a[i], i); }
+
+        ArenaMemoryResource                              arena;
+        GrowPolicyAllocator<GrowPolicyExact>             exact_alloc(&arena);
+        Array<u32, GrowPolicyAllocator<GrowPolicyExact>> b(exact_alloc);
+        for (u32 i = 0; i < 10; ++i)
+        {
+            b.add(i);
+            ASSERT_EQ(b.capacity(), b.size());
+        }
+
+        Array<u32, InlineAllocator<u32, 8, GrowPolicyAllocator<GrowPolicyDouble>>> c;
+        for (u32 i = 0; i < 8; ++i) { c.add(i); }
+        ASSERT_EQ(c.capacity(), 8);
+        c.add(8);
+        ASSERT_EQ(c.capacity(), 16);
+
+        SparseArray<u32, GrowPolicyAllocator<GrowPolicyDouble>> d;
+        BitArray<GrowPolicyAllocator<GrowPolicyMiGoodSize<>>>   e;
+        USet<u32, USetConfigDefault<u32>, GrowPolicyAllocator<GrowPolicyOneHalf>> f;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            d.add(i);
+            e.add(i % 3 == 0);
+            f.add(i);
+        }
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            ASSERT_EQ(d[i], i);
+            ASSERT_EQ(e[i], i % 3 == 0);
+            ASSERT_TRUE(f.contain(i));
+        }
+
+        static_assert(std::is_empty_v<GrowPolicyAllocator<GrowPolicyDouble, MiAllocator>>);
+        static_assert(is_trivially_relocatable_v<Array<u32, GrowPolicyAllocator<GrowPolicyDouble>>>);
+    }
+}
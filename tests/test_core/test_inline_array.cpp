@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+
+namespace
+{
+struct CountMemoryResource : public kun::IMemoryResource
+{
+    void* alloc(kun::Size size, kun::Size alignment) override
+    {
+        ++alloc_count;
+        return kun::defaultMemoryResource()->alloc(size, alignment);
+    }
+    void* realloc(void* p, kun::Size size, kun::Size alignment) override
+    {
+        ++alloc_count;
+        return kun::defaultMemoryResource()->realloc(p, size, alignment);
+    }
+    void free(void* p) override
+    {
+        if (p)
+        {
+            ++free_count;
+        }
+        kun::defaultMemoryResource()->free(p);
+    }
+
+    kun::Size alloc_count = 0;
+    kun::Size free_count = 0;
+};
+}// namespace
+
+TEST(TestCore, test_inline_array)
+{
+    using namespace kun;
+
+    CountMemoryResource res;
+    PmrAllocator        pmr(&res);
+
+    // inline
+    {
+        InlineArray<u32, 8> a(pmr);
+        for (u32 i = 0; i < 8; ++i) { a.add(i); }
+        ASSERT_EQ(a.size(), 8);
+        ASSERT_EQ(a.capacity(), 8);
+        ASSERT_TRUE(a.allocator().isInlineMemory(a.data()));
+        ASSERT_EQ(res.alloc_count, 0);
+
+        a.removeAt(0, 4);
+        a.shrink();
+        ASSERT_EQ(a.capacity(), 8);
+        ASSERT_TRUE(a.allocator().isInlineMemory(a.data()));
+    }
+
+    // grow to heap & shrink back
+    {
+        InlineArray<u32, 8> a(pmr);
+        for (u32 i = 0; i < 8; ++i) { a.add(i); }
+        ASSERT_EQ(res.alloc_count, 0);
+        a.add(8);
+        ASSERT_FALSE(a.allocator().isInlineMemory(a.data()));
+        ASSERT_EQ(res.alloc_count, 1);
+        for (u32 i = 9; i < 100; ++i) { a.add(i); }
+        for (u32 i = 0; i < 100; ++i) { ASSERT_EQ(a[i], i); }
+
+        a.removeAt(4, 96);
+        a.shrink();
+        ASSERT_EQ(a.capacity(), 8);
+        ASSERT_TRUE(a.allocator().isInlineMemory(a.data()));
+        ASSERT_EQ(res.free_count, 1);
+        for (u32 i = 0; i < 4; ++i) { ASSERT_EQ(a[i], i); }
+    }
+    res.alloc_count = res.free_count = 0;
+
+    // non-trivial items
+    {
+        InlineArray<String, 4> a(pmr);
+        a.add(String("kun"));
+        a.add(String("graph"));
+        ASSERT_TRUE(a.allocator().isInlineMemory(a.data()));
+        for (u32 i = 0; i < 10; ++i) { a.add(String("node")); }
+        ASSERT_FALSE(a.allocator().isInlineMemory(a.data()));
+        ASSERT_EQ(a[0], String("kun"));
+        ASSERT_EQ(a[1], String("graph"));
+        ASSERT_EQ(a[11], String("node"));
+    }
+    ASSERT_EQ(res.alloc_count, res.free_count);
+
+    // copy & move
+    {
+        InlineArray<String, 4> a(pmr);
+        a.add(String("kun"));
+        a.add(String("graph"));
+
+        InlineArray<String, 4> b(a, pmr);
+        ASSERT_EQ(a, b);
+        ASSERT_TRUE(b.allocator().isInlineMemory(b.data()));
+
+        // move inline, items are moved not stolen
+        InlineArray<String, 4> c(std::move(a));
+        ASSERT_EQ(a.size(), 0);
+        ASSERT_EQ(a.data(), nullptr);
+        ASSERT_FALSE(a.allocator().isInlineUsed());
+        ASSERT_TRUE(c.allocator().isInlineMemory(c.data()));
+        ASSERT_EQ(c, b);
+
+        // move heap, memory is stolen
+        for (u32 i = 0; i < 10; ++i) { c.add(String("node")); }
+        String* heap_data = c.data();
+        InlineArray<String, 4> d(std::move(c));
+        ASSERT_EQ(d.data(), heap_data);
+        ASSERT_EQ(d.size(), 12);
+        ASSERT_EQ(c.size(), 0);
+
+        // move assign
+        a = std::move(b);
+        ASSERT_EQ(b.size(), 0);
+        ASSERT_EQ(a.size(), 2);
+        ASSERT_TRUE(a.allocator().isInlineMemory(a.data()));
+        ASSERT_EQ(a[1], String("graph"));
+        b = std::move(d);
+        ASSERT_EQ(b.data(), heap_data);
+
+        // copy assign
+        c = a;
+        ASSERT_EQ(c, a);
+        ASSERT_TRUE(c.allocator().isInlineMemory(c.data()));
+    }
+    ASSERT_EQ(res.alloc_count, res.free_count);
+
+    // default fallback
+    {
+        InlineArray<u32, 4> a({1, 2, 3});
+        ASSERT_TRUE(a.allocator().isInlineMemory(a.data()));
+        a.append({4, 5, 6});
+        ASSERT_FALSE(a.allocator().isInlineMemory(a.data()));
+        ASSERT_EQ(a.size(), 6);
+        ASSERT_EQ(a[5], 6);
+    }
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+#include <atomic>
+
+TEST(TestCore, test_parallel_foreach)
+{
+    using namespace kun;
+
+    // word aligned split
+    {
+        for (u32 n : { 0u, 1u, 31u, 32u, 33u, 1000u, 100000u })
+        {
+            std::atomic<u32> covered = 0;
+            std::atomic<u32> chunk_count = 0;
+            algo::parallelForBits<u32>(n, 64, [&](u32 begin, u32 end) {
+                ASSERT_EQ(begin % 32, 0);
+                ASSERT_TRUE(end == n || end % 32 == 0);
+                ASSERT_LE(begin, end);
+                covered += end - begin;
+                ++chunk_count;
+            });
+            ASSERT_EQ(covered, n);
+            ASSERT_GE(chunk_count, 1);
+        }
+    }
+
+    // sparse array
+    {
+        SparseArray<u32> a;
+        for (u32 i = 0; i < 100000; ++i) { a.add(i); }
+        for (u32 i = 0; i < 100000; i += 3) { a.removeAt(i); }
+
+        std::atomic<u64> sum = 0;
+        std::atomic<u32> count = 0;
+        a.parallelForEach(
+        [&](u32& v) {
+            sum += v;
+            ++count;
+            v *= 2;
+        },
+        1000);
+        u64 expect_sum = 0;
+        for (u32 v : a) { expect_sum += v; }
+        ASSERT_EQ(count, a.size());
+        ASSERT_EQ(sum * 2, expect_sum);
+
+        const auto& ca = a;
+        count = 0;
+        algo::parallelForEach(
+        ca,
+        [&](const u32& v) {
+            ASSERT_EQ(v % 2, 0);
+            ++count;
+        },
+        (Size)1);
+        ASSERT_EQ(count, a.size());
+
+        CompactSparseArray<u32> b;
+        b.parallelForEach([](u32&) { FAIL(); });
+    }
+
+    // uset
+    {
+        USet<u32> set;
+        for (u32 i = 0; i < 50000; ++i) { set.add(i); }
+        for (u32 i = 0; i < 50000; i += 2) { set.remove(i); }
+        std::atomic<u32> count = 0;
+        set.parallelForEach(
+        [&](const u32& v) {
+            ASSERT_EQ(v % 2, 1);
+            ++count;
+        },
+        256);
+        ASSERT_EQ(count, set.size());
+    }
+
+    // bit array, every chunk owns its words, so func can write its own bit
+    {
+        BitArray<> bits;
+        bits.add(false, 100001);
+        for (u32 i = 0; i < 100001; i += 7) { bits[i] = true; }
+        std::atomic<u32> count = 0;
+        bits.parallelForEach(
+        [&](u64 index) {
+            ASSERT_EQ(index % 7, 0);
+            bits[index] = false;
+            ++count;
+        },
+        64);
+        ASSERT_EQ(count, 100001 / 7 + 1);
+        ASSERT_FALSE(bits.contain(true));
+    }
+}
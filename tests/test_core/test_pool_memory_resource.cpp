@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+
+TEST(TestCore, test_pool_memory_resource)
+{
+    using namespace kun;
+
+    // alloc & free
+    {
+        PoolMemoryResource pool(24, 4096);
+        ASSERT_EQ(pool.blockSize(), 24);
+        ASSERT_EQ(pool.blockAlignment(), 8);
+
+        Array<void*> blocks;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            void* p = pool.alloc(24, 8);
+            ASSERT_EQ((Size)p % 8, 0);
+            ASSERT_EQ(PoolMemoryResource::ownerOf(p, 4096), &pool);
+            memory::memset(p, (int)i, 24);
+            blocks.add(p);
+        }
+        PoolStats stats = pool.stats();
+        ASSERT_EQ(stats.used_count, 1000);
+        ASSERT_EQ(stats.peak_used_count, 1000);
+        ASSERT_EQ(stats.slab_count, (1000 + pool.blocksPerSlab() - 1) / pool.blocksPerSlab());
+        ASSERT_GE(stats.block_count, 1000);
+        ASSERT_GT(stats.occupancy(), 0.9f);
+
+        // freed blocks are reused first
+        Size slab_count = stats.slab_count;
+        for (u32 i = 0; i < 500; ++i) { pool.free(blocks[i]); }
+        ASSERT_EQ(pool.stats().used_count, 500);
+        for (u32 i = 0; i < 500; ++i) { blocks[i] = pool.alloc(16, 8); }
+        ASSERT_EQ(pool.stats().slab_count, slab_count);
+        ASSERT_EQ(pool.stats().peak_used_count, 1000);
+
+        // realloc & expand in block
+        ASSERT_EQ(pool.realloc(blocks[0], 20, 8), blocks[0]);
+        ASSERT_TRUE(pool.tryExpand(blocks[0], pool.blockSize()));
+        ASSERT_FALSE(pool.tryExpand(blocks[0], pool.blockSize() + 1));
+
+        pool.release();
+        ASSERT_EQ(pool.stats().slab_count, 0);
+        ASSERT_EQ(pool.stats().used_count, 0);
+    }
+
+    // reserve
+    {
+        PoolMemoryResource pool(64, 4096);
+        ASSERT_EQ(pool.blockAlignment(), 64);
+        pool.reserve(200);
+        Size slab_count = pool.stats().slab_count;
+        ASSERT_GE(pool.stats().block_count, 200);
+        for (u32 i = 0; i < 200; ++i) { ASSERT_EQ((Size)pool.alloc(64, 64) % 64, 0); }
+        ASSERT_EQ(pool.stats().slab_count, slab_count);
+    }
+
+    // with container
+    {
+        PoolMemoryResource pool(sizeof(u64) * 4);
+        PmrAllocator       pmr(&pool);
+        for (u32 i = 0; i < 100; ++i)
+        {
+            Array<u64> a(pmr);
+            a.reserve(4);
+            a.add(i);
+            ASSERT_EQ(a[0], i);
+        }
+        ASSERT_EQ(pool.stats().used_count, 0);
+        ASSERT_EQ(pool.stats().slab_count, 1);
+    }
+}
+
+TEST(TestCore, test_multi_pool_memory_resource)
+{
+    using namespace kun;
+
+    // size classes
+    {
+        MultiPoolMemoryResource res(1024);
+        ASSERT_EQ(res.pool(res.poolIndexOf(1, 1)).blockSize(), 16);
+        ASSERT_EQ(res.pool(res.poolIndexOf(17, 8)).blockSize(), 32);
+        ASSERT_EQ(res.pool(res.poolIndexOf(33, 8)).blockSize(), 48);
+        ASSERT_EQ(res.pool(res.poolIndexOf(48, 32)).blockSize(), 64);
+        ASSERT_EQ(res.pool(res.poolIndexOf(1000, 8)).blockSize(), 1024);
+        ASSERT_EQ(res.poolIndexOf(1025, 8), npos);
+        for (Size i = 1; i < res.poolCount(); ++i) { ASSERT_LT(res.pool(i - 1).blockSize(), res.pool(i).blockSize()); }
+    }
+
+    // alloc & free routing
+    {
+        MultiPoolMemoryResource res(256);
+        void*                   small = res.alloc(10, 8);
+        void*                   mid = res.alloc(100, 8);
+        void*                   large = res.alloc(4096, 16);
+        ASSERT_EQ(res.upstreamCount(), 1);
+        ASSERT_EQ(res.pool(res.poolIndexOf(10, 8)).stats().used_count, 1);
+        ASSERT_EQ(res.pool(res.poolIndexOf(100, 8)).stats().used_count, 1);
+
+        res.free(small);
+        res.free(mid);
+        res.free(large);
+        ASSERT_EQ(res.upstreamCount(), 0);
+        for (Size i = 0; i < res.poolCount(); ++i) { ASSERT_EQ(res.pool(i).stats().used_count, 0); }
+    }
+
+    // realloc across classes
+    {
+        MultiPoolMemoryResource res(256);
+        u8*                     p = (u8*)res.alloc(16, 8);
+        for (u8 i = 0; i < 16; ++i) { p[i] = i; }
+
+        // same class
+        ASSERT_EQ(res.realloc(p, 12, 8), p);
+        ASSERT_TRUE(res.tryExpand(p, 16));
+        ASSERT_FALSE(res.tryExpand(p, 17));
+
+        // grow to bigger class, then to upstream, upstream block stay upstream when shrink
+        p = (u8*)res.realloc(p, 100, 8);
+        for (u8 i = 0; i < 16; ++i) { ASSERT_EQ(p[i], i); }
+        p = (u8*)res.realloc(p, 1000, 8);
+        ASSERT_EQ(res.upstreamCount(), 1);
+        for (u8 i = 0; i < 16; ++i) { ASSERT_EQ(p[i], i); }
+        p = (u8*)res.realloc(p, 16, 8);
+        ASSERT_EQ(res.upstreamCount(), 1);
+        for (u8 i = 0; i < 16; ++i) { ASSERT_EQ(p[i], i); }
+        res.free(p);
+        ASSERT_EQ(res.upstreamCount(), 0);
+
+        // over aligned small block goes upstream, realloc it to a pool sized request never read past the block
+        p = (u8*)res.alloc(32, 128);
+        ASSERT_EQ(res.upstreamCount(), 1);
+        for (u8 i = 0; i < 32; ++i) { p[i] = i; }
+        p = (u8*)res.realloc(p, 48, 8);
+        ASSERT_EQ(res.upstreamCount(), 1);
+        for (u8 i = 0; i < 32; ++i) { ASSERT_EQ(p[i], i); }
+        res.free(p);
+        ASSERT_EQ(res.upstreamCount(), 0);
+    }
+
+    // with container
+    {
+        MultiPoolMemoryResource res;
+        PmrAllocator            pmr(&res);
+        {
+            USet<u32> set(pmr);
+            for (u32 i = 0; i < 1000; ++i) { set.add(i); }
+            for (u32 i = 0; i < 1000; ++i) { ASSERT_TRUE(set.contain(i)); }
+
+            Array<String> strings(pmr);
+            for (u32 i = 0; i < 50; ++i) { strings.add(String("kun graph")); }
+            ASSERT_EQ(strings[49], String("kun graph"));
+        }
+        ASSERT_EQ(res.upstreamCount(), 0);
+        for (Size i = 0; i < res.poolCount(); ++i) { ASSERT_EQ(res.pool(i).stats().used_count, 0); }
+    }
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+
+TEST(TestCore, test_robin_uset)
+{
+    using namespace kun;
+
+    // ctor
+    {
+        RobinUSet<u32> a;
+        ASSERT_EQ(a.size(), 0);
+        ASSERT_EQ(a.capacity(), 0);
+        ASSERT_FALSE(a.contain(0));
+
+        RobinUSet<u32> b({1, 1, 4, 5, 1, 4});
+        ASSERT_EQ(b.size(), 3);
+        ASSERT_TRUE(b.contain(1));
+        ASSERT_TRUE(b.contain(4));
+        ASSERT_TRUE(b.contain(5));
+        ASSERT_FALSE(b.contain(114514));
+
+        u32            data[] = {1, 1, 4, 5, 1, 4};
+        RobinUSet<u32> c(data, 6);
+        ASSERT_EQ(c.size(), 3);
+        ASSERT_EQ(b, c);
+
+        RobinUSet<u32> d(100);
+        ASSERT_EQ(d.size(), 0);
+        ASSERT_GE(d.growthLeft(), 100);
+    }
+
+    // copy & move
+    {
+        RobinUSet<u32> a({1, 1, 4, 5, 1, 4});
+
+        RobinUSet<u32> b(a);
+        ASSERT_EQ(b.size(), 3);
+        ASSERT_EQ(a, b);
+
+        RobinUSet<u32> c(std::move(a));
+        ASSERT_EQ(a.size(), 0);
+        ASSERT_EQ(a.capacity(), 0);
+        ASSERT_EQ(c, b);
+
+        a = c;
+        ASSERT_EQ(a, c);
+        b = std::move(c);
+        ASSERT_EQ(c.size(), 0);
+        ASSERT_EQ(a, b);
+    }
+
+    // add & find
+    {
+        RobinUSet<u32> a;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            auto info = a.add(i);
+            ASSERT_FALSE(info.already_exist);
+            ASSERT_EQ(*info, i);
+        }
+        ASSERT_EQ(a.size(), 1000);
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            auto info = a.find(i);
+            ASSERT_TRUE(info);
+            ASSERT_EQ(*info, i);
+            ASSERT_EQ(a[info.index], i);
+        }
+        ASSERT_FALSE(a.find(1000));
+
+        auto info = a.add(10);
+        ASSERT_TRUE(info.already_exist);
+        ASSERT_EQ(a.size(), 1000);
+
+        info = a.tryAdd(10);
+        ASSERT_TRUE(info.already_exist);
+        ASSERT_EQ(*info, 10);
+        info = a.tryAdd(1000);
+        ASSERT_FALSE(info.already_exist);
+        ASSERT_EQ(a.size(), 1001);
+
+        info = a.tryAddAs(1001u);
+        ASSERT_FALSE(info.already_exist);
+        info = a.tryAddAs(1001u);
+        ASSERT_TRUE(info.already_exist);
+        ASSERT_TRUE(a.containAs(1001u));
+        ASSERT_EQ(a.size(), 1002);
+    }
+
+    // find as
+    {
+        RobinUSet<StringView> a;
+        a.add(StringView("kun"));
+        a.add(StringView("graph"));
+
+        auto hasher = [](const String& v) { return Hash<StringView>()(StringView(v.data(), v.size())); };
+        auto comparer = [](const StringView& a, const String& b) { return a == StringView(b.data(), b.size()); };
+        ASSERT_TRUE(a.findAs(String("kun"), hasher, comparer));
+        ASSERT_FALSE(a.containAs(String("node"), hasher, comparer));
+        ASSERT_NE(a.removeAs(String("graph"), hasher, comparer), npos);
+        ASSERT_EQ(a.size(), 1);
+    }
+
+    // remove
+    {
+        RobinUSet<u32> a;
+        for (u32 i = 0; i < 100; ++i) { a.add(i); }
+        for (u32 i = 0; i < 100; i += 2) { ASSERT_NE(a.remove(i), npos); }
+        ASSERT_EQ(a.remove(0), npos);
+        ASSERT_EQ(a.size(), 50);
+        for (u32 i = 0; i < 100; ++i) { ASSERT_EQ(a.contain(i), i % 2 == 1); }
+
+        a.rehash();
+        ASSERT_EQ(a.size(), 50);
+        for (u32 i = 0; i < 100; ++i) { ASSERT_EQ(a.contain(i), i % 2 == 1); }
+
+        a.shrink();
+        ASSERT_EQ(a.capacity(), 64);
+        for (u32 i = 0; i < 100; ++i) { ASSERT_EQ(a.contain(i), i % 2 == 1); }
+
+        // add & remove loop, backward shift never leave tombstone
+        Size capacity = a.capacity();
+        for (u32 i = 1000; i < 100000; ++i)
+        {
+            a.add(i);
+            a.remove(i);
+        }
+        ASSERT_EQ(a.size(), 50);
+        ASSERT_EQ(a.capacity(), capacity);
+    }
+
+    // non-trivial data
+    {
+        RobinUSet<String> a;
+        for (u32 i = 0; i < 200; ++i) { a.add(String(std::to_string(i).c_str())); }
+        ASSERT_EQ(a.size(), 200);
+        for (u32 i = 0; i < 200; i += 3) { a.remove(String(std::to_string(i).c_str())); }
+        for (u32 i = 0; i < 200; ++i) { ASSERT_EQ(a.contain(String(std::to_string(i).c_str())), i % 3 != 0); }
+
+        RobinUSet<String> b(a);
+        ASSERT_EQ(a, b);
+        a.clear();
+        ASSERT_EQ(a.size(), 0);
+        ASSERT_FALSE(a.contain(String("1")));
+    }
+
+    // probe statistics
+    {
+        RobinUSet<u32> a;
+        ASSERT_EQ(a.loadFactor(), 0.f);
+        ASSERT_EQ(a.maxProbeLength(), 0);
+
+        for (u32 i = 0; i < 10000; ++i) { a.add(i); }
+        ASSERT_LE(a.loadFactor(), 0.9f);
+        ASSERT_GT(a.loadFactor(), 0.4f);
+
+        Size histogram[8];
+        a.probeHistogram(histogram);
+        Size total = 0;
+        for (Size count : histogram) { total += count; }
+        ASSERT_EQ(total, 10000);
+        ASSERT_GT(histogram[0], 0);
+        ASSERT_LT(a.maxProbeLength(), RobinUSet<u32>::max_dist);
+
+        // fill to max load, probe length must still be bounded
+        Size max_load = a.size() + a.growthLeft();
+        Size capacity = a.capacity();
+        for (u32 i = 10000; i < max_load; ++i) { a.add(i); }
+        ASSERT_EQ(a.capacity(), capacity);
+        ASSERT_EQ(a.growthLeft(), 0);
+        ASSERT_LT(a.maxProbeLength(), RobinUSet<u32>::max_dist);
+
+        // remove keep the rest reachable, and probe length not grow
+        Size max_probe = a.maxProbeLength();
+        for (u32 i = 0; i < max_load; i += 3) { a.remove(i); }
+        ASSERT_LE(a.maxProbeLength(), max_probe);
+        for (u32 i = 0; i < max_load; ++i) { ASSERT_EQ(a.contain(i), i % 3 != 0); }
+    }
+
+    // foreach
+    {
+        RobinUSet<u32> a;
+        Size           count = 0;
+        for ([[maybe_unused]] u32 v : a) { ++count; }
+        ASSERT_EQ(count, 0);
+
+        for (u32 i = 0; i < 100; ++i) { a.add(i); }
+        for (u32 v : a)
+        {
+            ASSERT_LT(v, 100);
+            ++count;
+        }
+        ASSERT_EQ(count, 100);
+    }
+}
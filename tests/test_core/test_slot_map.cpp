@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+
+TEST(TestCore, test_slot_map)
+{
+    using namespace kun;
+
+    // handle
+    {
+        SlotHandle handle(5, 7);
+        ASSERT_EQ(sizeof(SlotHandle), 8);
+        ASSERT_EQ(handle.index(), 5);
+        ASSERT_EQ(handle.generation(), 7);
+        ASSERT_EQ(SlotHandle::fromRaw(handle.value), handle);
+        ASSERT_FALSE(SlotHandle());
+        ASSERT_TRUE(handle);
+    }
+
+    // add & remove & reuse
+    {
+        SlotMap<u32> map;
+        ASSERT_FALSE(map.isValid(SlotHandle()));
+        ASSERT_EQ(map.find(SlotHandle()), nullptr);
+
+        Array<SlotHandle> handles;
+        for (u32 i = 0; i < 100; ++i) { handles.add(map.add(i)); }
+        ASSERT_EQ(map.size(), 100);
+        for (u32 i = 0; i < 100; ++i)
+        {
+            ASSERT_TRUE(map.isValid(handles[i]));
+            ASSERT_EQ(handles[i].index(), i);
+            ASSERT_EQ(map[handles[i]], i);
+        }
+
+        // removed handle is invalid
+        for (u32 i = 0; i < 100; i += 2) { ASSERT_TRUE(map.remove(handles[i])); }
+        ASSERT_EQ(map.size(), 50);
+        for (u32 i = 0; i < 100; ++i) { ASSERT_EQ(map.isValid(handles[i]), i % 2 == 1); }
+        ASSERT_FALSE(map.remove(handles[0]));
+
+        // reused slot never alias old handle
+        for (u32 i = 0; i < 50; ++i)
+        {
+            SlotHandle handle = map.add(1000 + i);
+            ASSERT_EQ(handle.index() % 2, 0);
+            ASSERT_FALSE(map.isValid(handles[handle.index()]));
+            ASSERT_EQ(map.find(handles[handle.index()]), nullptr);
+            ASSERT_EQ(*map.find(handle), 1000 + i);
+            ASSERT_EQ(map.handleOf(handle.index()), handle);
+        }
+        ASSERT_EQ(map.sparseSize(), 100);
+
+        // forged handle of a hole
+        map.removeAt(1);
+        ASSERT_FALSE(map.isValid(SlotHandle(1, map.generation(1))));
+        ASSERT_FALSE(map.isValid(SlotHandle(1000, 1)));
+
+        // iterate
+        u32 count = 0;
+        for (auto it = map.begin(); it; ++it)
+        {
+            ASSERT_TRUE(map.isValid(map.handleOf(it.index())));
+            ++count;
+        }
+        ASSERT_EQ(count, map.size());
+
+        // clear keep handles invalid
+        SlotHandle alive = handles[3];
+        ASSERT_TRUE(map.isValid(alive));
+        map.clear();
+        ASSERT_FALSE(map.isValid(alive));
+        SlotHandle handle = map.add(0);
+        ASSERT_EQ(handle.index(), 0);
+        ASSERT_NE(handle, handles[0]);
+        map.release();
+        ASSERT_FALSE(map.isValid(handle));
+        ASSERT_TRUE(map.empty());
+    }
+
+    // non-trivial item & copy
+    {
+        SlotMap<String> map;
+        SlotHandle      a = map.add(String("a"));
+        SlotHandle      b = map.emplace("b");
+        map.remove(a);
+
+        SlotMap<String> copy = map;
+        ASSERT_FALSE(copy.isValid(a));
+        ASSERT_EQ(copy[b], String("b"));
+
+        SlotMap<String> moved = std::move(copy);
+        ASSERT_EQ(moved[b], String("b"));
+        ASSERT_EQ(moved.size(), 1);
+    }
+}
@@ -819,4 +819,89 @@ TEST(TestCore, test_sparse_array)
         }
         ASSERT_EQ(count, 1000);
     }
+
+    // compact with remap
+    {
+        auto test_remap = [](auto&& a) {
+            using ArrayType = std::decay_t<decltype(a)>;
+            using SizeType = typename ArrayType::SizeType;
+            auto check_remap = [&](const Array<SizeType>& remap, SizeType old_size) {
+                ASSERT_EQ(remap.size(), old_size);
+                for (SizeType i = 0; i < old_size; ++i)
+                {
+                    if (i % 3 == 0)
+                    {
+                        ASSERT_EQ(remap[i], ArrayType::npos);
+                    }
+                    else
+                    {
+                        ASSERT_EQ(a[remap[i]], i);
+                    }
+                }
+            };
+
+            // compact
+            for (u32 i = 0; i < 100; ++i) { a.add(i); }
+            for (u32 i = 0; i < 100; i += 3) { a.removeAt(i); }
+            Array<SizeType> remap;
+            ASSERT_TRUE(a.compactWithRemap(remap));
+            ASSERT_EQ(a.sparseSize(), 66);
+            check_remap(remap, 100);
+            ASSERT_FALSE(a.compactWithRemap(remap));
+
+            // compact stable
+            a.clear();
+            for (u32 i = 0; i < 100; ++i) { a.add(i); }
+            for (u32 i = 0; i < 100; i += 3) { a.removeAt(i); }
+            ASSERT_TRUE(a.compactStableWithRemap(remap));
+            check_remap(remap, 100);
+            for (SizeType i = 1; i < 66; ++i) { ASSERT_LT(a[i - 1], a[i]); }
+
+            // compact step
+            a.clear();
+            for (u32 i = 0; i < 100; ++i) { a.add(i); }
+            for (u32 i = 0; i < 100; i += 3) { a.removeAt(i); }
+            Array<SizeType> index_of;// value -> index
+            index_of.resize(100, ArrayType::npos);
+            for (auto it = a.begin(); it; ++it) { index_of[*it] = it.index(); }
+            u32 step_count = 0;
+            u32 move_count = 0;
+            while (!a.compactStep(5, [&](SizeType from, SizeType to) {
+                ASSERT_EQ(index_of[a[to]], from);
+                index_of[a[to]] = to;
+                ++move_count;
+            }))
+            {
+                ++step_count;
+                ASSERT_EQ(move_count, 5);
+                move_count = 0;
+            }
+            ASSERT_GT(step_count, 1);
+            ASSERT_TRUE(a.isCompact());
+            ASSERT_EQ(a.sparseSize(), 66);
+            for (u32 i = 0; i < 100; ++i)
+            {
+                if (i % 3)
+                {
+                    ASSERT_EQ(a[index_of[i]], i);
+                }
+            }
+            ASSERT_TRUE(a.compactStep(5));
+
+            // reuse after step
+            a.add(1000);
+            ASSERT_EQ(a.sparseSize(), 67);
+        };
+        test_remap(SparseArray<u32>());
+        test_remap(CompactSparseArray<u32>());
+
+        // non-trivial item
+        SparseArray<String> s;
+        for (u32 i = 0; i < 10; ++i) { s.add(String("kun")); }
+        s.removeAt(0);
+        s.removeAt(5);
+        while (!s.compactStep(1)) {}
+        ASSERT_EQ(s.sparseSize(), 8);
+        for (const String& v : s) { ASSERT_EQ(v, String("kun")); }
+    }
 }
\ No newline at end of file
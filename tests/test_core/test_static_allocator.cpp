@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+
+namespace
+{
+struct CountStaticResource
+{
+    static void* alloc(kun::Size size, kun::Size align)
+    {
+        ++call_count;
+        ++live_count;
+        return kun::memory::malloc(size, align);
+    }
+    static void* realloc(void* p, kun::Size size, kun::Size align)
+    {
+        ++call_count;
+        if (!p)
+        {
+            ++live_count;
+        }
+        return kun::memory::realloc(p, size, align);
+    }
+    static void free(void* p)
+    {
+        if (p)
+        {
+            --live_count;
+        }
+        kun::memory::free(p);
+    }
+
+    static inline kun::Size call_count = 0;
+    static inline kun::Size live_count = 0;
+};
+}// namespace
+
+TEST(TestCore, test_static_allocator)
+{
+    using namespace kun;
+
+    // stateless allocator take no storage
+    {
+        static_assert(std::is_empty_v<MiAllocator>);
+        ASSERT_EQ(sizeof(Array<u32, MiAllocator>), sizeof(void*) + 2 * sizeof(Size));
+        ASSERT_EQ(sizeof(BitArray<MiAllocator>), sizeof(void*) + 2 * sizeof(Size));
+        ASSERT_LT(sizeof(Array<u32, MiAllocator>), sizeof(Array<u32>));
+        ASSERT_LT(sizeof(SparseArray<u32, MiAllocator>), sizeof(SparseArray<u32>));
+        ASSERT_LT((sizeof(USet<u32, USetConfigDefault<u32>, MiAllocator>)), sizeof(USet<u32>));
+        ASSERT_LT((sizeof(SwissUSet<u32, USetConfigDefault<u32>, MiAllocator>)), sizeof(SwissUSet<u32>));
+        ASSERT_LT((sizeof(RobinUSet<u32, USetConfigDefault<u32>, MiAllocator>)), sizeof(RobinUSet<u32>));
+    }
+
+    // containers
+    {
+        Array<u32, MiAllocator> a;
+        for (u32 i = 0; i < 100; ++i) { a.add(i); }
+        a.removeAt(0, 50);
+        a.shrink();
+        ASSERT_EQ(a.size(), 50);
+        ASSERT_EQ(a[0], 50);
+
+        USet<u32, USetConfigDefault<u32>, MiAllocator> set;
+        for (u32 i = 0; i < 100; ++i) { set.add(i); }
+        for (u32 i = 0; i < 100; ++i) { ASSERT_TRUE(set.contain(i)); }
+
+        Array<USet<u32, USetConfigDefault<u32>, MiAllocator>, MiAllocator> nested;
+        nested.add(set);
+        nested.add(std::move(set));
+        ASSERT_EQ(nested[0].size(), 100);
+        ASSERT_EQ(nested[1].size(), 100);
+    }
+
+    // bound resource
+    {
+        using CountAllocator = StaticAllocator<CountStaticResource>;
+        {
+            Array<String, CountAllocator> a;
+            for (u32 i = 0; i < 100; ++i) { a.add(String("kun")); }
+            SparseArray<u32, CountAllocator> s;
+            for (u32 i = 0; i < 100; ++i) { s.add(i); }
+            ASSERT_GT(CountStaticResource::call_count, 0);
+            ASSERT_GT(CountStaticResource::live_count, 0);
+        }
+        ASSERT_EQ(CountStaticResource::live_count, 0);
+    }
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+#include <thread>
+
+TEST(TestCore, test_thread_heap_memory_resource)
+{
+    using namespace kun;
+
+    // alloc & free
+    {
+        ThreadHeapMemoryResource heap;
+        ASSERT_TRUE(heap.isOwnerThread());
+
+        void* p = heap.alloc(100, 64);
+        ASSERT_EQ((Size)p % 64, 0);
+        ASSERT_TRUE(heap.contain(p));
+        p = heap.realloc(p, 1000, 64);
+        ASSERT_EQ((Size)p % 64, 0);
+        ASSERT_TRUE(heap.contain(p));
+        heap.free(p);
+    }
+
+    // bulk release
+    {
+        ThreadHeapMemoryResource heap;
+        for (u32 job = 0; job < 3; ++job)
+        {
+            {
+                // containers are dropped without release, their memory go away with reset()
+                MemoryResourceScope scope(&heap);
+                using NestedArray = Array<Array<u32>>;
+                NestedArray*        a = new (heap.alloc(sizeof(NestedArray), alignof(NestedArray))) NestedArray();
+                for (u32 i = 0; i < 100; ++i) { a->add(Array<u32>({i, i + 1, i + 2})); }
+                ASSERT_TRUE(heap.contain(a));
+                ASSERT_TRUE(heap.contain(a->data()));
+                ASSERT_TRUE(heap.contain((*a)[99].data()));
+            }
+            heap.reset();
+        }
+    }
+
+    // current resource
+    {
+        ASSERT_EQ(defaultMemoryResource(), globalMemoryResource());
+        ThreadHeapMemoryResource heap;
+        {
+            MemoryResourceScope scope(&heap);
+            ASSERT_EQ(defaultMemoryResource(), &heap);
+
+            Array<u32> a;
+            a.add(1);
+            ASSERT_EQ(a.allocator().resource(), &heap);
+            ASSERT_TRUE(heap.contain(a.data()));
+
+            // nested & restore global
+            {
+                MemoryResourceScope global_scope(nullptr);
+                ASSERT_EQ(defaultMemoryResource(), globalMemoryResource());
+            }
+            ASSERT_EQ(defaultMemoryResource(), &heap);
+
+            // other thread is not affected
+            IMemoryResource* other = nullptr;
+            std::thread      t([&other]() { other = defaultMemoryResource(); });
+            t.join();
+            ASSERT_EQ(other, globalMemoryResource());
+        }
+        ASSERT_EQ(defaultMemoryResource(), globalMemoryResource());
+    }
+
+    // per worker heap
+    {
+        algo::parallelForChunk<u32>(4, 4, [](u32, u32, u32) {
+            ThreadHeapMemoryResource heap;
+            MemoryResourceScope      scope(&heap);
+            {
+                USet<u32> set;
+                for (u32 i = 0; i < 1000; ++i) { set.add(i); }
+                EXPECT_EQ(set.size(), 1000);
+                EXPECT_EQ(defaultMemoryResource(), &heap);
+            }
+            heap.reset();
+        });
+    }
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+
+TEST(TestCore, test_tracking_memory_resource)
+{
+    using namespace kun;
+
+    // alloc & free
+    {
+        TrackingMemoryResource res(Name("test_tracking.basic"));
+        void*                  a = res.alloc(100, 8);
+        void*                  b = res.alloc(28, 64);
+        ASSERT_EQ((Size)b % 64, 0);
+
+        TrackingStats stats = res.stats();
+        ASSERT_EQ(stats.tag, Name("test_tracking.basic"));
+        ASSERT_EQ(stats.alloc_count, 2);
+        ASSERT_EQ(stats.live_count, 2);
+        ASSERT_EQ(stats.live_bytes, 128);
+        ASSERT_EQ(stats.total_bytes, 128);
+        ASSERT_EQ(stats.peak_bytes, 128);
+
+        // realloc keep data and count
+        memory::memset(a, 7, 100);
+        a = res.realloc(a, 1000, 8);
+        for (u32 i = 0; i < 100; ++i) { ASSERT_EQ(((u8*)a)[i], 7); }
+        stats = res.stats();
+        ASSERT_EQ(stats.alloc_count, 2);
+        ASSERT_EQ(stats.live_bytes, 1028);
+        ASSERT_EQ(stats.total_bytes, 1028);
+
+        // realloc with bigger alignment
+        b = res.realloc(b, 28, 256);
+        ASSERT_EQ((Size)b % 256, 0);
+        ASSERT_EQ(res.stats().live_count, 2);
+
+        res.free(a);
+        res.free(b);
+        stats = res.stats();
+        ASSERT_EQ(stats.free_count, stats.alloc_count);
+        ASSERT_EQ(stats.live_count, 0);
+        ASSERT_EQ(stats.live_bytes, 0);
+        ASSERT_EQ(stats.peak_bytes, 1028);
+    }
+
+    // shared tag & snapshot
+    {
+        TrackingMemoryResource res_a(Name("test_tracking.shared"));
+        TrackingMemoryResource res_b(Name("test_tracking.shared"));
+        TrackingMemoryResource res_c(Name("test_tracking.other"));
+        PmrAllocator           pmr_a(&res_a);
+        PmrAllocator           pmr_b(&res_b);
+        PmrAllocator           pmr_c(&res_c);
+
+        Array<u32> a(pmr_a);
+        Array<u32> b(pmr_b);
+        USet<u32>  c(pmr_c);
+        a.reserve(100);
+        b.reserve(50);
+        for (u32 i = 0; i < 100; ++i) { c.add(i); }
+
+        TrackingStats shared = TrackingMemoryResource::stats(Name("test_tracking.shared"));
+        ASSERT_EQ(shared.live_count, 2);
+        ASSERT_EQ(shared.live_bytes, 150 * sizeof(u32));
+
+        Array<TrackingStats> snapshot;
+        TrackingMemoryResource::snapshot(snapshot);
+        bool found_other = false;
+        for (const TrackingStats& stats : snapshot)
+        {
+            if (stats.tag == Name("test_tracking.other"))
+            {
+                found_other = true;
+                ASSERT_GT(stats.live_bytes, 0);
+            }
+        }
+        ASSERT_TRUE(found_other);
+
+        // unknown tag
+        ASSERT_EQ(TrackingMemoryResource::stats(Name("test_tracking.none")).alloc_count, 0);
+    }
+    ASSERT_EQ(TrackingMemoryResource::stats(Name("test_tracking.shared")).live_bytes, 0);
+    ASSERT_EQ(TrackingMemoryResource::stats(Name("test_tracking.other")).live_bytes, 0);
+
+    // cross thread, blocks freed by other thread
+    {
+        TrackingMemoryResource res(Name("test_tracking.threads"));
+        void*                  blocks[8][64];
+        algo::parallelForChunk<u32>(8, 8, [&](u32 idx, u32, u32) {
+            for (u32 i = 0; i < 64; ++i) { blocks[idx][i] = res.alloc(1024, 16); }
+        });
+        TrackingStats stats = res.stats();
+        ASSERT_EQ(stats.live_count, 8 * 64);
+        ASSERT_EQ(stats.live_bytes, 8 * 64 * 1024);
+        ASSERT_GE(stats.peak_bytes, stats.live_bytes);
+
+        algo::parallelForChunk<u32>(8, 8, [&](u32 idx, u32, u32) {
+            for (u32 i = 0; i < 64; ++i) { res.free(blocks[7 - idx][i]); }
+        });
+        stats = res.stats();
+        ASSERT_EQ(stats.live_count, 0);
+        ASSERT_EQ(stats.live_bytes, 0);
+        ASSERT_EQ(stats.peak_bytes, 8 * 64 * 1024);
+    }
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <kun/core/mimimal.h>
+
+TEST(TestCore, test_umap)
+{
+    using namespace kun;
+
+    // ctor
+    {
+        UMap<u32, u32> a;
+        ASSERT_EQ(a.size(), 0);
+
+        UMap<u32, u32> b({{1, 1}, {4, 5}, {1, 4}});
+        ASSERT_EQ(b.size(), 2);
+        ASSERT_EQ(*b.findValue(1), 4);
+        ASSERT_EQ(*b.findValue(4), 5);
+    }
+
+    // add & find
+    {
+        UMap<u32, u32> a;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            auto info = a.add(i, i * 2);
+            ASSERT_FALSE(info.already_exist);
+            ASSERT_EQ(info->key, i);
+            ASSERT_EQ(info->value, i * 2);
+        }
+        ASSERT_EQ(a.size(), 1000);
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            auto info = a.find(i);
+            ASSERT_TRUE(info);
+            ASSERT_EQ(info->value, i * 2);
+        }
+        ASSERT_EQ(a.findValue(1000), nullptr);
+
+        // add assign value
+        auto info = a.add(10, 114514);
+        ASSERT_TRUE(info.already_exist);
+        ASSERT_EQ(*a.findValue(10), 114514);
+        ASSERT_EQ(a.size(), 1000);
+
+        // try add never assign
+        info = a.tryAdd(10, 1919810);
+        ASSERT_TRUE(info.already_exist);
+        ASSERT_EQ(info->value, 114514);
+        info = a.tryAdd(1000, 1919810);
+        ASSERT_FALSE(info.already_exist);
+        ASSERT_EQ(*a.findValue(1000), 1919810);
+
+        // remove
+        ASSERT_NE(a.remove(10), npos);
+        ASSERT_FALSE(a.contain(10));
+        ASSERT_EQ(a.size(), 1000);
+    }
+
+    // find as & try add as
+    {
+        UMap<StringView, u32> a;
+        a.add(StringView("kun"), 1u);
+        a.add(StringView("graph"), 2u);
+
+        String key("kun");
+        auto   hasher = [](const String& v) { return Hash<StringView>()(StringView(v.data(), v.size())); };
+        auto   comparer = [](const StringView& a, const String& b) { return a == StringView(b.data(), b.size()); };
+        auto   info = a.findAs(key, hasher, comparer);
+        ASSERT_TRUE(info);
+        ASSERT_EQ(info->value, 1);
+        ASSERT_FALSE(a.containAs(String("node"), hasher, comparer));
+
+        info = a.tryAddAs(StringView("node"));
+        ASSERT_FALSE(info.already_exist);
+        ASSERT_EQ(info->value, 0);
+        info = a.tryAddAs(StringView("node"));
+        ASSERT_TRUE(info.already_exist);
+        ASSERT_EQ(a.size(), 3);
+    }
+
+    // hashed
+    {
+        UMap<u32, u32> a;
+        Size           hash = Hash<u32>()(114514);
+        a.addHashed(114514u, 1u, hash);
+        ASSERT_TRUE(a.containHashed(114514, hash));
+        ASSERT_EQ(*a.findValueHashed(114514, hash), 1);
+        a.addHashed(114514u, 2u, hash);
+        ASSERT_EQ(a.size(), 1);
+        ASSERT_EQ(*a.findValueHashed(114514, hash), 2);
+    }
+
+    // multi map
+    {
+        UMap<u32, u32, UMapConfigDefault<u32, u32, true>> a;
+        a.add(1u, 1u);
+        a.add(1u, 2u);
+        a.add(1u, 3u);
+        ASSERT_EQ(a.size(), 3);
+        ASSERT_EQ(a.count(1), 3);
+    }
+
+    // foreach
+    {
+        UMap<u32, u32> a;
+        for (u32 i = 0; i < 100; ++i) { a.add(i, i + 1); }
+        Size count = 0;
+        for (const auto& pair : a)
+        {
+            ASSERT_EQ(pair.key + 1, pair.value);
+            ++count;
+        }
+        ASSERT_EQ(count, 100);
+    }
+}
@@ -1,4 +1,360 @@
 #include <gtest/gtest.h>
 #include <kun/core/mimimal.h>
 
-TEST(TestCore, test_uset) { using namespace kun; }
\ No newline at end of file
+namespace
+{
+struct NoTagConfig : public kun::USetConfigDefault<kun::u32>
+{
+    static constexpr bool use_bucket_tag = false;
+};
+struct IncrementalConfig : public kun::USetConfigDefault<kun::u32>
+{
+    static constexpr bool incremental_rehash = true;
+};
+}// namespace
+
+TEST(TestCore, test_uset)
+{
+    using namespace kun;
+
+    // ctor
+    {
+        USet<u32> a;
+        ASSERT_EQ(a.size(), 0);
+        ASSERT_EQ(a.capacity(), 0);
+        ASSERT_EQ(a.bucketSize(), 0);
+
+        USet<u32> b({1, 1, 4, 5, 1, 4});
+        ASSERT_EQ(b.size(), 3);
+        ASSERT_TRUE(b.contain(1));
+        ASSERT_TRUE(b.contain(4));
+        ASSERT_TRUE(b.contain(5));
+        ASSERT_FALSE(b.contain(114514));
+
+        u32       data[] = {1, 1, 4, 5, 1, 4};
+        USet<u32> c(data, 6);
+        ASSERT_EQ(c.size(), 3);
+        ASSERT_TRUE(c.contain(1));
+        ASSERT_TRUE(c.contain(4));
+        ASSERT_TRUE(c.contain(5));
+    }
+
+    // copy & move
+    {
+        USet<u32> a({1, 1, 4, 5, 1, 4});
+
+        USet<u32> b(a);
+        ASSERT_EQ(b.size(), 3);
+        ASSERT_TRUE(b.contain(1));
+        ASSERT_TRUE(b.contain(4));
+        ASSERT_TRUE(b.contain(5));
+
+        USet<u32> c(std::move(a));
+        ASSERT_EQ(a.size(), 0);
+        ASSERT_EQ(a.bucketSize(), 0);
+        ASSERT_EQ(c.size(), 3);
+        ASSERT_TRUE(c.contain(1));
+        ASSERT_TRUE(c.contain(4));
+        ASSERT_TRUE(c.contain(5));
+
+        a = c;
+        ASSERT_EQ(a, c);
+        b = std::move(c);
+        ASSERT_EQ(c.size(), 0);
+        ASSERT_EQ(a, b);
+    }
+
+    // add & find
+    {
+        USet<u32> a;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            auto info = a.add(i);
+            ASSERT_FALSE(info.already_exist);
+            ASSERT_EQ(*info, i);
+        }
+        ASSERT_EQ(a.size(), 1000);
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            auto info = a.find(i);
+            ASSERT_TRUE(info);
+            ASSERT_EQ(*info, i);
+            ASSERT_EQ(a[info.index], i);
+        }
+        ASSERT_FALSE(a.find(1000));
+
+        auto info = a.add(10);
+        ASSERT_TRUE(info.already_exist);
+        ASSERT_EQ(a.size(), 1000);
+
+        info = a.tryAdd(10);
+        ASSERT_TRUE(info.already_exist);
+        ASSERT_EQ(*info, 10);
+        info = a.tryAdd(1000);
+        ASSERT_FALSE(info.already_exist);
+        ASSERT_EQ(a.size(), 1001);
+
+        info = a.tryAddAs(1001u);
+        ASSERT_FALSE(info.already_exist);
+        info = a.tryAddAs(1001u);
+        ASSERT_TRUE(info.already_exist);
+        ASSERT_TRUE(a.containAs(1001u));
+        ASSERT_EQ(a.size(), 1002);
+    }
+
+    // remove
+    {
+        USet<u32> a;
+        for (u32 i = 0; i < 100; ++i) { a.add(i); }
+        for (u32 i = 0; i < 100; i += 2) { ASSERT_NE(a.remove(i), npos); }
+        ASSERT_EQ(a.remove(0), npos);
+        ASSERT_EQ(a.size(), 50);
+        for (u32 i = 0; i < 100; ++i) { ASSERT_EQ(a.contain(i), i % 2 == 1); }
+
+        a.compact();
+        ASSERT_EQ(a.size(), 50);
+        ASSERT_TRUE(a.isCompact());
+        for (u32 i = 0; i < 100; ++i) { ASSERT_EQ(a.contain(i), i % 2 == 1); }
+    }
+
+    // bucket tag
+    {
+        USet<u32>              a;
+        USet<u32, NoTagConfig> b;
+        for (u32 i = 0; i < 1000; ++i)
+        {
+            a.add(i * 7);
+            b.add(i * 7);
+        }
+        ASSERT_NE(a.bucketTag(), nullptr);
+        ASSERT_EQ(b.bucketTag(), nullptr);
+        for (u32 i = 0; i < 7000; i += 2) { a.remove(i); }
+        for (u32 i = 0; i < 7000; i += 2) { b.remove(i); }
+        for (u32 i = 0; i < 7000; ++i)
+        {
+            bool expect = i % 7 == 0 && i % 2 == 1;
+            ASSERT_EQ(a.contain(i), expect);
+            ASSERT_EQ(b.contain(i), expect);
+        }
+
+        USet<u32> c(a);
+        for (u32 i = 0; i < 7000; ++i) { ASSERT_EQ(c.contain(i), a.contain(i)); }
+    }
+
+    // incremental rehash
+    {
+        USet<u32, IncrementalConfig> a;
+        bool                         has_rehashing = false;
+        for (u32 i = 0; i < 10000; ++i)
+        {
+            a.add(i);
+            has_rehashing |= a.isRehashing();
+            ASSERT_TRUE(a.contain(i));
+            ASSERT_TRUE(a.contain(i / 2));
+        }
+        ASSERT_TRUE(has_rehashing);
+        ASSERT_EQ(a.size(), 10000);
+        for (u32 i = 0; i < 10000; ++i) { ASSERT_TRUE(a.contain(i)); }
+        for (u32 i = 0; i < 10000; i += 2) { ASSERT_NE(a.remove(i), npos); }
+        for (u32 i = 0; i < 10000; ++i) { ASSERT_EQ(a.contain(i), i % 2 == 1); }
+
+        // copy while rehashing
+        USet<u32, IncrementalConfig> b;
+        for (u32 i = 0; !b.isRehashing(); ++i) { b.add(i); }
+        USet<u32, IncrementalConfig> c(b);
+        ASSERT_FALSE(c.isRehashing());
+        ASSERT_EQ(b, c);
+        while (b.rehashStep()) {}
+        ASSERT_FALSE(b.isRehashing());
+        ASSERT_EQ(b, c);
+    }
+
+    // batch
+    {
+        u32 items[300];
+        for (u32 i = 0; i < 300; ++i) { items[i] = i * 2; }
+
+        USet<u32>           a;
+        USet<u32>::DataInfo add_result[300];
+        a.addBatch(Span<const u32>(items, 300), Span<USet<u32>::DataInfo>(add_result));
+        ASSERT_EQ(a.size(), 300);
+        for (u32 i = 0; i < 300; ++i)
+        {
+            ASSERT_FALSE(add_result[i].already_exist);
+            ASSERT_EQ(*add_result[i], i * 2);
+        }
+        a.addBatch(Span<const u32>(items, 100));
+        ASSERT_EQ(a.size(), 300);
+
+        u32  keys[600];
+        Size hashes[600];
+        for (u32 i = 0; i < 600; ++i)
+        {
+            keys[i] = i;
+            hashes[i] = Hash<u32>()(i);
+        }
+
+        USet<u32>::DataInfo find_result[600];
+        a.findBatch(Span<const u32>(keys, 600), Span<USet<u32>::DataInfo>(find_result));
+        for (u32 i = 0; i < 600; ++i)
+        {
+            ASSERT_EQ((bool)find_result[i], i % 2 == 0);
+            if (find_result[i])
+            {
+                ASSERT_EQ(*find_result[i], i);
+            }
+        }
+
+        const USet<u32>&     ca = a;
+        USet<u32>::CDataInfo cfind_result[600];
+        ca.findBatchHashed(Span<const u32>(keys, 600), Span<const Size>(hashes, 600), Span<USet<u32>::CDataInfo>(cfind_result));
+        for (u32 i = 0; i < 600; ++i) { ASSERT_EQ(cfind_result[i].data, find_result[i].data); }
+
+        bool contain_result[600];
+        a.containBatch(Span<const u32>(keys, 600), Span<bool>(contain_result));
+        for (u32 i = 0; i < 600; ++i) { ASSERT_EQ(contain_result[i], i % 2 == 0); }
+        a.containBatchHashed(Span<const u32>(keys, 600), Span<const Size>(hashes, 600), Span<bool>(contain_result));
+        for (u32 i = 0; i < 600; ++i) { ASSERT_EQ(contain_result[i], i % 2 == 0); }
+    }
+
+    // bulk
+    {
+        constexpr u32 n = 100000;
+        u32*          items = new u32[n];
+        for (u32 i = 0; i < n; ++i) { items[i] = (i * 7) % (n / 2); }
+
+        USet<u32> a(items, n);
+        USet<u32> b;
+        for (u32 i = 0; i < n; ++i) { b.add(items[i]); }
+        ASSERT_EQ(a.size(), n / 2);
+        ASSERT_EQ(a, b);
+        ASSERT_FALSE(a.needRehash());
+        for (u32 i = 0; i < n / 2; ++i) { ASSERT_EQ(a.data()[i].data, b.data()[i].data); }
+
+        // append to a set with holes
+        for (u32 i = 0; i < n / 2; i += 3) { a.remove(i); }
+        a.appendBulk(items, n);
+        ASSERT_EQ(a, b);
+        for (u32 i = 0; i < n; ++i) { ASSERT_TRUE(a.contain(i % (n / 2))); }
+
+        // multi key keep every item
+        USet<u32, USetConfigDefault<u32, true>> c(items, n);
+        ASSERT_EQ(c.size(), n);
+        ASSERT_EQ(c.count(0), 2);
+
+        // value of the last duplicated item win
+        Array<KVPair<u32, u32>> pairs;
+        for (u32 i = 0; i < 5000; ++i) { pairs.add(KVPair<u32, u32>(i % 1000, i)); }
+        UMap<u32, u32> d(pairs.data(), (Size)pairs.size());
+        ASSERT_EQ(d.size(), 1000);
+        for (u32 i = 0; i < 1000; ++i) { ASSERT_EQ(*d.findValue(i), i + 4000); }
+
+        delete[] items;
+    }
+
+    // multi key
+    {
+        USet<u32, USetConfigDefault<u32, true>> a;
+        a.add(1);
+        a.add(1);
+        a.add(4);
+        a.add(1);
+        ASSERT_EQ(a.size(), 4);
+        ASSERT_EQ(a.count(1), 3);
+        ASSERT_EQ(a.count(4), 1);
+        ASSERT_EQ(a.removeAll(1), 3);
+        ASSERT_EQ(a.count(1), 0);
+        ASSERT_EQ(a.size(), 1);
+    }
+
+    // set ops
+    {
+        USet<u32> a({1, 2, 3, 4});
+        USet<u32> b({3, 4, 5, 6});
+
+        ASSERT_EQ(a & b, USet<u32>({3, 4}));
+        ASSERT_EQ(a | b, USet<u32>({1, 2, 3, 4, 5, 6}));
+        ASSERT_EQ(a ^ b, USet<u32>({1, 2, 5, 6}));
+        ASSERT_EQ(a - b, USet<u32>({1, 2}));
+        ASSERT_EQ(b - a, USet<u32>({5, 6}));
+
+        // sub set
+        ASSERT_TRUE(USet<u32>({3, 4}).isSubsetOf(a));
+        ASSERT_FALSE(a.isSubsetOf(USet<u32>({3, 4})));
+        ASSERT_FALSE(a.isSubsetOf(b));
+        ASSERT_TRUE(USet<u32>().isSubsetOf(a));
+
+        // in-place, both probe direction
+        USet<u32> small({3, 4, 5000});
+        USet<u32> large;
+        for (u32 i = 0; i < 1000; ++i) { large.add(i); }
+
+        USet<u32> c(small);
+        c.intersectWith(large);
+        ASSERT_EQ(c, USet<u32>({3, 4}));
+        c = large;
+        c.intersectWith(small);
+        ASSERT_EQ(c, USet<u32>({3, 4}));
+
+        c = small;
+        c.unionWith(large);
+        ASSERT_EQ(c.size(), 1001);
+        ASSERT_TRUE(large.isSubsetOf(c));
+        ASSERT_TRUE(small.isSubsetOf(c));
+        c = large;
+        c.unionWith(small);
+        ASSERT_EQ(c.size(), 1001);
+        c.unionWith(USet<u32>({1000}));
+        ASSERT_EQ(c.size(), 1002);
+
+        c = small;
+        c.subtract(large);
+        ASSERT_EQ(c, USet<u32>({5000}));
+        c = large;
+        c.subtract(small);
+        ASSERT_EQ(c.size(), 998);
+        ASSERT_FALSE(c.contain(3));
+        c.subtract(c);
+        ASSERT_TRUE(c.empty());
+
+        // value of rhs win in union, both probe direction
+        UMap<u32, u32> d({{1, 1}, {2, 2}});
+        UMap<u32, u32> e({{2, 20}, {3, 30}, {4, 40}});
+        UMap<u32, u32> f(d);
+        f.unionWith(e);
+        ASSERT_EQ(*f.findValue(2), 20);
+        f = e;
+        f.unionWith(d);
+        ASSERT_EQ(*f.findValue(2), 2);
+        ASSERT_EQ(f.size(), 4);
+
+        // large input, probing may run in parallel
+        USet<u32> g, h;
+        for (u32 i = 0; i < 200000; ++i) { g.add(i); }
+        for (u32 i = 100000; i < 400000; ++i) { h.add(i); }
+        ASSERT_EQ((g & h).size(), 100000);
+        ASSERT_EQ((g | h).size(), 400000);
+        ASSERT_EQ((g ^ h).size(), 300000);
+        ASSERT_EQ((g - h).size(), 100000);
+        ASSERT_EQ((h - g).size(), 200000);
+        g.intersectWith(h);
+        ASSERT_EQ(g.size(), 100000);
+        for (u32 i = 0; i < 400000; ++i) { ASSERT_EQ(g.contain(i), i >= 100000 && i < 200000); }
+    }
+
+    // foreach
+    {
+        USet<u32> a;
+        Size      count = 0;
+        for ([[maybe_unused]] u32 v : a) { ++count; }
+        ASSERT_EQ(count, 0);
+
+        for (u32 i = 0; i < 100; ++i) { a.add(i); }
+        for (u32 v : a)
+        {
+            ASSERT_LT(v, 100);
+            ++count;
+        }
+        ASSERT_EQ(count, 100);
+    }
+}